@@ -3,7 +3,7 @@ LOCAL_PATH := $(call my-dir)
 include $(CLEAR_VARS)
 
 LOCAL_CPP_FEATURES += exceptions
-LOCAL_CFLAGS    := -DUSE_SFML_MOVIE_STUB
+LOCAL_CFLAGS    := -DUSE_SFML_MOVIE_STUB -DNO_FRAME_PROFILER
 
 LOCAL_MODULE    := dgengine
 
@@ -16,6 +16,8 @@ LOCAL_SRC_FILES += AnimationType.h
 LOCAL_SRC_FILES += AudioSource.h
 LOCAL_SRC_FILES += BaseAnimation.cpp
 LOCAL_SRC_FILES += BaseAnimation.h
+LOCAL_SRC_FILES += BenchRunner.cpp
+LOCAL_SRC_FILES += BenchRunner.h
 LOCAL_SRC_FILES += BindableText.cpp
 LOCAL_SRC_FILES += BindableText.h
 LOCAL_SRC_FILES += BitmapButton.cpp
@@ -43,9 +45,15 @@ LOCAL_SRC_FILES += Event.h
 LOCAL_SRC_FILES += EventManager.h
 LOCAL_SRC_FILES += FadeInOut.cpp
 LOCAL_SRC_FILES += FadeInOut.h
+LOCAL_SRC_FILES += FileBytes.cpp
+LOCAL_SRC_FILES += FileBytes.h
+LOCAL_SRC_FILES += FileIndex.cpp
+LOCAL_SRC_FILES += FileIndex.h
 LOCAL_SRC_FILES += FileUtils.cpp
 LOCAL_SRC_FILES += FileUtils.h
 LOCAL_SRC_FILES += Font.h
+LOCAL_SRC_FILES += FrameProfiler.cpp
+LOCAL_SRC_FILES += FrameProfiler.h
 LOCAL_SRC_FILES += FreeTypeFont.h
 LOCAL_SRC_FILES += Game.cpp
 LOCAL_SRC_FILES += Game.h
@@ -60,10 +68,16 @@ LOCAL_SRC_FILES += ImageUtils.cpp
 LOCAL_SRC_FILES += ImageUtils.h
 LOCAL_SRC_FILES += InputEvent.cpp
 LOCAL_SRC_FILES += InputEvent.h
+LOCAL_SRC_FILES += InputRecorder.cpp
+LOCAL_SRC_FILES += InputRecorder.h
 LOCAL_SRC_FILES += InputText.cpp
 LOCAL_SRC_FILES += InputText.h
+LOCAL_SRC_FILES += JobSystem.cpp
+LOCAL_SRC_FILES += JobSystem.h
 LOCAL_SRC_FILES += LoadingScreen.cpp
 LOCAL_SRC_FILES += LoadingScreen.h
+LOCAL_SRC_FILES += LoadProfiler.cpp
+LOCAL_SRC_FILES += LoadProfiler.h
 LOCAL_SRC_FILES += Menu.cpp
 LOCAL_SRC_FILES += Menu.h
 LOCAL_SRC_FILES += Min.cpp
@@ -76,11 +90,15 @@ LOCAL_SRC_FILES += Panel.cpp
 LOCAL_SRC_FILES += Panel.h
 LOCAL_SRC_FILES += Pcx.cpp
 LOCAL_SRC_FILES += Pcx.h
+LOCAL_SRC_FILES += PerfCounters.cpp
+LOCAL_SRC_FILES += PerfCounters.h
 LOCAL_SRC_FILES += PhysFSStream.cpp
 LOCAL_SRC_FILES += PhysFSStream.h
 LOCAL_SRC_FILES += Queryable.h
 LOCAL_SRC_FILES += Rectangle.cpp
 LOCAL_SRC_FILES += Rectangle.h
+LOCAL_SRC_FILES += RenderThread.cpp
+LOCAL_SRC_FILES += RenderThread.h
 LOCAL_SRC_FILES += ResourceManager.cpp
 LOCAL_SRC_FILES += ResourceManager.h
 LOCAL_SRC_FILES += Scrollable.cpp
@@ -167,7 +185,9 @@ LOCAL_SRC_FILES += Game/Inventory.h
 LOCAL_SRC_FILES += Game/Item.cpp
 LOCAL_SRC_FILES += Game/Item.h
 LOCAL_SRC_FILES += Game/ItemClass.cpp
+LOCAL_SRC_FILES += Game/ItemGenerator.cpp
 LOCAL_SRC_FILES += Game/ItemClass.h
+LOCAL_SRC_FILES += Game/ItemGenerator.h
 LOCAL_SRC_FILES += Game/ItemLocation.h
 LOCAL_SRC_FILES += Game/Level.cpp
 LOCAL_SRC_FILES += Game/Level.h
@@ -183,6 +203,8 @@ LOCAL_SRC_FILES += Game/LevelObject.h
 LOCAL_SRC_FILES += Game/LevelObjectClass.cpp
 LOCAL_SRC_FILES += Game/LevelObjectClass.h
 LOCAL_SRC_FILES += Game/LevelObjectClassDefaults.h
+LOCAL_SRC_FILES += Game/LevelPickGrid.cpp
+LOCAL_SRC_FILES += Game/LevelPickGrid.h
 LOCAL_SRC_FILES += Game/LevelSurface.cpp
 LOCAL_SRC_FILES += Game/LevelSurface.h
 LOCAL_SRC_FILES += Game/LightMap.h
@@ -218,6 +240,7 @@ LOCAL_SRC_FILES += Game/Save/SaveSimpleLevelObject.cpp
 LOCAL_SRC_FILES += Game/Save/SaveSimpleLevelObject.h
 LOCAL_SRC_FILES += Game/Save/SaveUtils.cpp
 LOCAL_SRC_FILES += Game/Save/SaveUtils.h
+LOCAL_SRC_FILES += Game/Save/SaveWriter.h
 LOCAL_SRC_FILES += gsl/gsl
 LOCAL_SRC_FILES += gsl/gsl_algorithm
 LOCAL_SRC_FILES += gsl/gsl_assert
@@ -238,6 +261,8 @@ LOCAL_SRC_FILES += ImageContainers/DCCImageContainer.h
 LOCAL_SRC_FILES += ImageContainers/ImageContainer.h
 LOCAL_SRC_FILES += ImageContainers/SimpleImageContainer.cpp
 LOCAL_SRC_FILES += ImageContainers/SimpleImageContainer.h
+LOCAL_SRC_FILES += Json/JsonBinary.cpp
+LOCAL_SRC_FILES += Json/JsonBinary.h
 LOCAL_SRC_FILES += Json/JsonParser.h
 LOCAL_SRC_FILES += Json/JsonUtils.cpp
 LOCAL_SRC_FILES += Json/JsonUtils.h
@@ -376,8 +401,12 @@ LOCAL_SRC_FILES += rapidjson/internal/strtod.h
 LOCAL_SRC_FILES += rapidjson/internal/swap.h
 LOCAL_SRC_FILES += rapidjson/msinttypes/inttypes.h
 LOCAL_SRC_FILES += rapidjson/msinttypes/stdint.h
+LOCAL_SRC_FILES += SFML/AlphaMask.cpp
+LOCAL_SRC_FILES += SFML/AlphaMask.h
 LOCAL_SRC_FILES += SFML/CompositeSprite.cpp
 LOCAL_SRC_FILES += SFML/CompositeSprite.h
+LOCAL_SRC_FILES += SFML/DrawCommandList.cpp
+LOCAL_SRC_FILES += SFML/DrawCommandList.h
 LOCAL_SRC_FILES += SFML/Image2.h
 LOCAL_SRC_FILES += SFML/Music2.cpp
 LOCAL_SRC_FILES += SFML/Music2.h
@@ -405,16 +434,22 @@ LOCAL_SRC_FILES += TexturePacks/TexturePack.cpp
 LOCAL_SRC_FILES += TexturePacks/TexturePack.h
 LOCAL_SRC_FILES += TexturePacks/VectorTexturePack.cpp
 LOCAL_SRC_FILES += TexturePacks/VectorTexturePack.h
+LOCAL_SRC_FILES += Utils/AllocationCounter.cpp
+LOCAL_SRC_FILES += Utils/AllocationCounter.h
 LOCAL_SRC_FILES += Utils/EasedValue.h
 LOCAL_SRC_FILES += Utils/EasingFunctions.h
 LOCAL_SRC_FILES += Utils/ElapsedTime.h
 LOCAL_SRC_FILES += Utils/FixedArray.h
 LOCAL_SRC_FILES += Utils/FixedMap.h
+LOCAL_SRC_FILES += Utils/FrameArena.cpp
+LOCAL_SRC_FILES += Utils/FrameArena.h
 LOCAL_SRC_FILES += Utils/Helper2D.h
 LOCAL_SRC_FILES += Utils/iterator_tpl.h
-LOCAL_SRC_FILES += Utils/LRUCache.h
+LOCAL_SRC_FILES += Utils/LZ4.cpp
+LOCAL_SRC_FILES += Utils/LZ4.h
 LOCAL_SRC_FILES += Utils/NumberVector.h
 LOCAL_SRC_FILES += Utils/ReverseIterable.h
+LOCAL_SRC_FILES += Utils/SlotMap.h
 LOCAL_SRC_FILES += Utils/Utils.cpp
 LOCAL_SRC_FILES += Utils/Utils.h
 
@@ -426,6 +461,7 @@ LOCAL_SHARED_LIBRARIES += sfml-network
 LOCAL_SHARED_LIBRARIES += libphysfs
 LOCAL_SHARED_LIBRARIES += libc++_shared
 LOCAL_WHOLE_STATIC_LIBRARIES := sfml-main
+LOCAL_LDLIBS := -lGLESv1_CM
 
 include $(BUILD_SHARED_LIBRARY)
 
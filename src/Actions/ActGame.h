@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Action.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 
 class ActGameAddToProperty : public Action
@@ -83,6 +84,28 @@ public:
 	}
 };
 
+class ActGameDumpFrameProfile : public Action
+{
+private:
+	std::string file;
+
+public:
+	ActGameDumpFrameProfile(const std::string& file_) : file(file_) {}
+
+	virtual bool execute(Game& game)
+	{
+		if (file.empty() == true)
+		{
+			FrameProfiler::dump();
+		}
+		else
+		{
+			FrameProfiler::dump(file);
+		}
+		return true;
+	}
+};
+
 class ActGameEnableInput : public Action
 {
 private:
@@ -5,6 +5,7 @@
 #include "Game/GameProperties.h"
 #include "Game/ItemLocation.h"
 #include "Game/Item.h"
+#include "Game/ItemGenerator.h"
 #include "Game/Level.h"
 #include "Game/Player.h"
 #include "Image.h"
@@ -178,6 +179,96 @@ public:
 	}
 };
 
+class ActItemGenerate : public Action
+{
+private:
+	std::string idLevel;
+	ItemCoordInventory itemCoord;
+	InventoryPosition invPos{ InventoryPosition::TopLeft };
+	// item class id and number of items
+	std::vector<std::pair<std::string, size_t>> itemClasses;
+	std::vector<std::pair<uint16_t, std::string>> propertyNames;
+	ItemGenerator generator;
+	std::shared_ptr<Action> inventoryFullAction;
+	// variable set to the number of items placed in the inventory
+	std::string placedVariable;
+
+public:
+	ActItemGenerate(const std::string& idLevel_, const ItemCoordInventory& itemCoord_,
+		InventoryPosition invPos_) : idLevel(idLevel_), itemCoord(itemCoord_), invPos(invPos_) {}
+
+	void addItemClass(const std::string& id, size_t count)
+	{
+		itemClasses.push_back(std::make_pair(id, count));
+	}
+
+	void setProperty(const std::string_view name, LevelObjValue min, LevelObjValue max)
+	{
+		auto nameHash = str2int16(name);
+		propertyNames.push_back(std::make_pair(nameHash, std::string(name)));
+		generator.setProperty(nameHash, min, max);
+	}
+
+	void setInventoryFullAction(const std::shared_ptr<Action>& action_) noexcept
+	{
+		inventoryFullAction = action_;
+	}
+
+	void setPlacedVariable(const std::string& key) { placedVariable = key; }
+
+	virtual bool execute(Game& game)
+	{
+		auto level = game.Resources().getLevel(idLevel);
+		if (level == nullptr)
+		{
+			return true;
+		}
+		auto player = level->getPlayerOrCurrent(itemCoord.getPlayerId());
+		if (player == nullptr)
+		{
+			return true;
+		}
+		size_t invIdx = itemCoord.getInventoryIdx();
+		if (invIdx >= player->getInventorySize())
+		{
+			return true;
+		}
+		for (const auto& prop : propertyNames)
+		{
+			level->setPropertyName(prop.first, prop.second);
+		}
+
+		std::vector<std::shared_ptr<Item>> items;
+		for (const auto& itemClass : itemClasses)
+		{
+			auto class_ = level->getClass<ItemClass>(itemClass.first);
+			if (class_ != nullptr)
+			{
+				generator.generate(*class_, itemClass.second, items);
+			}
+		}
+		// a smaller item may still fit after a bigger one didn't
+		int64_t placed = 0;
+		for (auto& item : items)
+		{
+			if (player->setItemInFreeSlot(invIdx, item, invPos, false) == true)
+			{
+				placed++;
+			}
+		}
+		if (placedVariable.empty() == false)
+		{
+			game.setVariable(placedVariable, Variable(placed));
+		}
+		if ((size_t)placed < items.size() &&
+			inventoryFullAction != nullptr)
+		{
+			game.Events().addBack(inventoryFullAction);
+		}
+		return true;
+	}
+};
+
 class ActItemLoadFromLevel : public Action
 {
 private:
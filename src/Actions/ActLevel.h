@@ -352,12 +352,24 @@ private:
 	bool saveDefaults;
 	bool saveCurrentPlayer;
 	bool saveQuests;
+	bool saveBinary;
+	bool compress;
+	// the file isn't written when the action ends. anything that reads,
+	// copies or deletes it has to go in onComplete.
+	bool async;
+	std::shared_ptr<Action> onComplete;
+	std::shared_ptr<Action> onError;
 
 public:
 	ActLevelSave(const std::string& id_, const std::string& file_,
-		bool saveDefaults_, bool saveCurrentPlayer_, bool saveQuests_)
+		bool saveDefaults_, bool saveCurrentPlayer_, bool saveQuests_,
+		bool saveBinary_, bool compress_, bool async_,
+		const std::shared_ptr<Action>& onComplete_,
+		const std::shared_ptr<Action>& onError_)
 		: id(id_), file(file_), saveDefaults(saveDefaults_),
-		saveCurrentPlayer(saveCurrentPlayer_), saveQuests(saveQuests_) {}
+		saveCurrentPlayer(saveCurrentPlayer_), saveQuests(saveQuests_),
+		saveBinary(saveBinary_), compress(compress_), async(async_),
+		onComplete(onComplete_), onError(onError_) {}
 
 	virtual bool execute(Game& game) noexcept
 	{
@@ -368,9 +380,26 @@ public:
 			props.saveDefaults = saveDefaults;
 			props.saveCurrentPlayer = saveCurrentPlayer;
 			props.saveQuests = saveQuests;
+			props.saveBinary = saveBinary;
+			props.compress = compress;
 
-			level->save(GameUtils::replaceStringWithVarOrProp(file, game).c_str(),
-				props, game);
+			auto filePath = GameUtils::replaceStringWithVarOrProp(file, game);
+			auto onSaved = [&game, onComplete = onComplete, onError = onError](bool success)
+			{
+				auto action = (success == true ? onComplete : onError);
+				if (action != nullptr)
+				{
+					game.Events().addBack(action);
+				}
+			};
+			if (async == true)
+			{
+				level->saveAsync(filePath, props, game, onSaved);
+			}
+			else
+			{
+				onSaved(level->save(filePath, props, game));
+			}
 		}
 		return true;
 	}
@@ -65,6 +65,7 @@ public:
 			if (obj != nullptr)
 			{
 				obj->executeAction(game);
+				level->wakeLevelObject(*obj);
 			}
 		}
 		return true;
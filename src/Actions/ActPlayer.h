@@ -111,6 +111,7 @@ public:
 						if (player->setNumber(propVal, currVal, level) == true)
 						{
 							player->updateProperties();
+							level->wakeLevelObject(*player);
 						}
 					}
 				}
@@ -230,6 +231,7 @@ public:
 			if (player != nullptr)
 			{
 				player->setDirection(direction);
+				level->wakeLevelObject(*player);
 			}
 		}
 		return true;
@@ -262,6 +264,7 @@ public:
 				{
 					auto value2 = game.getVarOrProp(value);
 					player->setProperty(prop2, value2);
+					level->wakeLevelObject(*player);
 				}
 			}
 		}
@@ -346,6 +349,7 @@ public:
 			if (player != nullptr)
 			{
 				player->Walk(level->Map(), direction, executeAction);
+				level->wakeLevelObject(*player);
 			}
 		}
 		return true;
@@ -383,6 +387,7 @@ public:
 					mapPos = level->getMapCoordOverMouse();
 				}
 				player->Walk(level->Map(), mapPos, executeAction);
+				level->wakeLevelObject(*player);
 			}
 		}
 		return true;
@@ -35,6 +35,7 @@ void Animation::update(Game& game)
 		animation.update(game.getElapsedTime()) == true)
 	{
 		animation.updateTexture(sprite);
+		game.invalidate();
 	}
 }
 
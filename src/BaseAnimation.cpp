@@ -140,7 +140,7 @@ bool BaseAnimation::updateTexture(CompositeSprite& sprite, bool& absoluteOffset)
 	}
 	else
 	{
-		std::vector<TextureInfo> ti;
+		FrameVector<TextureInfo> ti;
 		auto compTexture = texturePackVar.getCompositeTexture().get();
 		if (compTexture->get(currentTextureIdx, ti) == true)
 		{
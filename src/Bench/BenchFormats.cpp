@@ -0,0 +1,216 @@
+#include "Benchmark.h"
+#include "FileBytes.h"
+#include "FileUtils.h"
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+#include "ImageContainers/CELImageContainer.h"
+#include "ImageContainers/CL2ImageContainer.h"
+#include "ImageContainers/DC6ImageContainer.h"
+#include "ImageContainers/DCCImageContainer.h"
+#endif
+#include <memory>
+#include "Palette.h"
+#include "Pcx.h"
+#include <string>
+
+using Benchmark::doNotOptimize;
+
+// asset files (from DIABDAT.MPQ and d2data.mpq, mounted with --data)
+static constexpr const char* CelFile = "towners/smith/smithn.cel";
+static constexpr const char* Cl2File = "monsters/fatc/fatca.cl2";
+static constexpr const char* Dc6File = "data/local/font/LATIN/font8.DC6";
+static constexpr const char* DccFile = "data/global/monsters/S7/TR/S7TRLITA1HTH.dcc";
+static constexpr const char* PalFile = "levels/towndata/town.pal";
+static constexpr const char* PcxFile = "ui_art/title.pcx";
+// gamefiles
+static constexpr const char* TrnFile = "res/trn/spell0.trn";
+
+static bool checkFile(Benchmark::State& state, const char* file)
+{
+	if (FileUtils::exists(file) == false)
+	{
+		state.skip(std::string("missing ") + file);
+		return false;
+	}
+	return true;
+}
+
+// the town palette or a gradient if it isn't available.
+static std::shared_ptr<Palette> getPalette()
+{
+	if (FileUtils::exists(PalFile) == true)
+	{
+		return std::make_shared<Palette>(PalFile, Palette::ColorFormat::RGB);
+	}
+	auto palette = std::make_shared<Palette>();
+	for (size_t i = 0; i < palette->palette.size(); i++)
+	{
+		palette->palette[i] = sf::Color((sf::Uint8)i, (sf::Uint8)(255 - i), (sf::Uint8)(i * 7));
+	}
+	return palette;
+}
+
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+// decodes all frames of the image container in each iteration.
+static void decodeFrames(Benchmark::State& state, const ImageContainer& container)
+{
+	auto palette = getPalette();
+	uint64_t pixels = 0;
+	uint64_t frames = 0;
+	while (state.keepRunning() == true)
+	{
+		ImageContainer::ImageInfo imgInfo;
+		for (uint32_t i = 0; i < container.size(); i++)
+		{
+			auto img = container.get(i, &palette->palette, imgInfo);
+			pixels += (uint64_t)img.getSize().x * img.getSize().y;
+			doNotOptimize(img);
+		}
+		frames += container.size();
+	}
+	state.setItemsProcessed(frames);
+	doNotOptimize(pixels);
+}
+#endif
+
+BENCHMARK(celDecode)
+{
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+	if (checkFile(state, CelFile) == true)
+	{
+		CELImageContainer container(CelFile);
+		decodeFrames(state, container);
+	}
+#else
+	state.skip("no Diablo format support");
+#endif
+}
+
+BENCHMARK(cl2Decode)
+{
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+	if (checkFile(state, Cl2File) == true)
+	{
+		CL2ImageContainer container(Cl2File);
+		decodeFrames(state, container);
+	}
+#else
+	state.skip("no Diablo format support");
+#endif
+}
+
+BENCHMARK(dc6Decode)
+{
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+	if (checkFile(state, Dc6File) == true)
+	{
+		DC6ImageContainer container(Dc6File, false, false);
+		decodeFrames(state, container);
+	}
+#else
+	state.skip("no Diablo format support");
+#endif
+}
+
+BENCHMARK(dccDecode)
+{
+#ifndef NO_DIABLO_FORMAT_SUPPORT
+	if (checkFile(state, DccFile) == true)
+	{
+		DCCImageContainer container(DccFile);
+		decodeFrames(state, container);
+	}
+#else
+	state.skip("no Diablo format support");
+#endif
+}
+
+// opens an image file the way the image containers do.
+// items processed is the file size.
+static void openFile(Benchmark::State& state, const char* file, bool allowMapping)
+{
+	if (checkFile(state, file) == false)
+	{
+		return;
+	}
+	if (allowMapping == true &&
+		FileBytes(file).isMapped() == false)
+	{
+		state.skip(std::string("not in a folder mount ") + file);
+		return;
+	}
+	uint64_t size = 0;
+	while (state.keepRunning() == true)
+	{
+		FileBytes bytes;
+		bytes.load(file, allowMapping);
+		size += bytes.size();
+		doNotOptimize(bytes.data());
+	}
+	state.setItemsProcessed(size);
+}
+
+BENCHMARK(celOpenRead)
+{
+	openFile(state, CelFile, false);
+}
+
+// only runs if --data is a folder (extracted mpq).
+BENCHMARK(celOpenMapped)
+{
+	openFile(state, CelFile, true);
+}
+
+// file read and decode.
+BENCHMARK(pcxLoad)
+{
+	if (checkFile(state, PcxFile) == false)
+	{
+		return;
+	}
+	uint64_t pixels = 0;
+	while (state.keepRunning() == true)
+	{
+		auto img = ImageUtils::LoadImagePCX(PcxFile);
+		pixels += (uint64_t)img.getSize().x * img.getSize().y;
+		doNotOptimize(img);
+	}
+	state.setItemsProcessed(pixels);
+}
+
+BENCHMARK(paletteLoad)
+{
+	if (checkFile(state, PalFile) == false)
+	{
+		return;
+	}
+	while (state.keepRunning() == true)
+	{
+		Palette palette(PalFile, Palette::ColorFormat::RGB);
+		doNotOptimize(palette.palette);
+	}
+}
+
+// palette with a color translation (trn) applied, as used by the spell icons.
+BENCHMARK(paletteTrn)
+{
+	if (checkFile(state, TrnFile) == false)
+	{
+		return;
+	}
+	auto palette = getPalette();
+	auto trn = FileUtils::readChar(TrnFile);
+	while (state.keepRunning() == true)
+	{
+		Palette trnPalette(*palette, trn, 0, 256);
+		doNotOptimize(trnPalette.palette);
+	}
+}
+
+BENCHMARK(paletteShift)
+{
+	auto palette = getPalette();
+	while (state.keepRunning() == true)
+	{
+		palette->shiftLeft(1, 1, 31);
+	}
+}
@@ -0,0 +1,575 @@
+#include "Benchmark.h"
+#include "Game.h"
+#include "Game/Formula.h"
+#include "Game/GameHashes.h"
+#include "Game/Inventory.h"
+#include "Game/Item.h"
+#include "Game/ItemClass.h"
+#include "Game/ItemGenerator.h"
+#include "Game/Level.h"
+#include "Game/LevelMap.h"
+#include "Game/Save/SaveLevel.h"
+#include "Game/Save/SaveWriter.h"
+#include "IfCondition.h"
+#include "JobSystem.h"
+#include "Json/JsonUtils.h"
+#include <memory>
+#include <random>
+#include <string>
+#include "TexturePacks/SimpleTexturePack.h"
+#include "Utils/FrameArena.h"
+#include "Utils/Utils.h"
+#include <vector>
+
+using Benchmark::doNotOptimize;
+
+BENCHMARK(formulaParse)
+{
+	while (state.keepRunning() == true)
+	{
+		Formula formula("((2 + 3) * 4 - :abs(-10)) :max (8 / 2) :min 100 + :sqrt(16) * 1.5");
+		doNotOptimize(formula);
+	}
+}
+
+BENCHMARK(formulaEval)
+{
+	Formula formula("((2 + 3) * 4 - :abs(-10)) :max (8 / 2) :min 100 + :sqrt(16) * 1.5");
+	while (state.keepRunning() == true)
+	{
+		doNotOptimize(formula.eval());
+	}
+}
+
+// formulas in the gamefiles are mostly evaluated from strings.
+BENCHMARK(formulaEvalString)
+{
+	while (state.keepRunning() == true)
+	{
+		doNotOptimize(Formula::evalString("(2 + 3) * 4 - :abs(-10) :max 8"));
+	}
+}
+
+// var1 >= 100 and (var2 == 5 or var3 == "warrior")
+BENCHMARK(ifConditionEval)
+{
+	Game game;
+	game.setVariable("gold", (int64_t)500);
+	game.setVariable("level", (int64_t)4);
+	game.setVariable("class", std::string("warrior"));
+
+	IfCondition condition;
+	condition.addCondition(str2int16(">="), Variable(std::string("%gold%")), Variable((int64_t)100));
+	condition.addCondition(IfCondition::ConditionOp::And);
+	condition.addCondition(IfCondition::ConditionOp::LeftBracket);
+	condition.addCondition(str2int16("=="), Variable(std::string("%level%")), Variable((int64_t)5));
+	condition.addCondition(IfCondition::ConditionOp::Or);
+	condition.addCondition(str2int16("=="), Variable(std::string("%class%")), Variable(std::string("warrior")));
+	condition.addCondition(IfCondition::ConditionOp::RightBracket);
+
+	while (state.keepRunning() == true)
+	{
+		doNotOptimize(condition.eval(game));
+	}
+}
+
+// dungeon sized map with walls every 8 cells that have a gap at alternate ends.
+static LevelMap makeMap()
+{
+	constexpr int32_t size = 112;
+	LevelMap map(size, size);
+	for (int32_t x = 8; x < size; x += 8)
+	{
+		auto gap = (x / 8) % 2 == 0 ? 2 : size - 3;
+		for (int32_t y = 0; y < size; y++)
+		{
+			if (y < gap - 1 || y > gap + 1)
+			{
+				map[x][y].setTileIndex(LevelCell::SolLayer, 1);
+			}
+		}
+	}
+	return map;
+}
+
+BENCHMARK(levelMapGetPathShort)
+{
+	auto map = makeMap();
+	while (state.keepRunning() == true)
+	{
+		FrameArena::reset();
+		doNotOptimize(map.getPath(PairFloat(1.f, 1.f), PairFloat(6.f, 50.f)));
+	}
+}
+
+BENCHMARK(levelMapGetPathLong)
+{
+	auto map = makeMap();
+	while (state.keepRunning() == true)
+	{
+		FrameArena::reset();
+		doNotOptimize(map.getPath(PairFloat(1.f, 1.f), PairFloat(110.f, 110.f)));
+	}
+}
+
+// path to a wall cell (no path).
+BENCHMARK(levelMapGetPathBlocked)
+{
+	auto map = makeMap();
+	while (state.keepRunning() == true)
+	{
+		FrameArena::reset();
+		doNotOptimize(map.getPath(PairFloat(1.f, 1.f), PairFloat(8.f, 50.f)));
+	}
+}
+
+static std::vector<PairInt32> getLightPositions()
+{
+	std::vector<PairInt32> positions;
+	for (int32_t y = 4; y < 112; y += 12)
+	{
+		for (int32_t x = 4; x < 112; x += 12)
+		{
+			positions.push_back(PairInt32(x, y));
+		}
+	}
+	return positions;
+}
+
+// moves all lights by one cell (a remove and an add each).
+BENCHMARK(levelMapUpdateLights)
+{
+	auto map = makeMap();
+	LightSource light{ 0, 255, 10, LightEasing::Linear };
+	auto positions = getLightPositions();
+	for (const auto& pos : positions)
+	{
+		map.addLight(pos, light);
+	}
+	map.updateLights();
+
+	int32_t offset = 0;
+	while (state.keepRunning() == true)
+	{
+		for (const auto& pos : positions)
+		{
+			map.removeLight(PairInt32(pos.x + offset, pos.y), light);
+			map.addLight(PairInt32(pos.x + 1 - offset, pos.y), light);
+		}
+		map.updateLights();
+		offset = 1 - offset;
+	}
+	state.setItemsProcessed(state.Iterations() * positions.size() * 2);
+}
+
+BENCHMARK(levelMapInitLights)
+{
+	auto map = makeMap();
+	LightSource light{ 0, 255, 10, LightEasing::Linear };
+	for (const auto& pos : getLightPositions())
+	{
+		map.addLight(pos, light);
+	}
+	while (state.keepRunning() == true)
+	{
+		map.initLights();
+	}
+}
+
+// items need a drop texture (blank, one frame).
+static std::shared_ptr<TexturePack> makeItemTexturePack()
+{
+	auto texture = std::make_shared<sf::Texture>();
+	texture->create(32, 32);
+	return std::make_shared<SimpleTexturePack>(texture, std::make_pair(1u, 1u),
+		sf::Vector2f(), 0, 0, false, AnimationType::PlayOnce, nullptr);
+}
+
+static ClassifierValueInterval makeInterval(const std::string& property,
+	const std::vector<std::pair<ClassifierValue::ValuePair, Variable>>& values)
+{
+	ClassifierValueInterval interval;
+	interval.property = property;
+	for (const auto& val : values)
+	{
+		interval.values.push_back({ val.first, val.second });
+	}
+	return interval;
+}
+
+// item classes, an inventory and a level shared by the item, inventory and
+// save benchmarks. the make*Fixture functions below build the variants.
+// the inventory and the level hold items, so they're destroyed before the classes.
+struct ItemFixture
+{
+	std::shared_ptr<TexturePack> texturePack{ makeItemTexturePack() };
+	std::vector<std::unique_ptr<Classifier>> classifiers;
+	std::vector<std::unique_ptr<ItemClass>> classes;
+	// the class used by item generation
+	ItemClass* weapon{ nullptr };
+	ItemGenerator generator;
+	Inventory inventory{ PairUInt8(10, 4) };
+	Game game;
+	Level level;
+
+	ItemClass* addItemClass(const std::string& id)
+	{
+		classes.push_back(std::make_unique<ItemClass>(texturePack, texturePack, 0));
+		classes.back()->Id(id);
+		return classes.back().get();
+	}
+
+	Classifier* addClassifier(ClassifierValueInterval interval)
+	{
+		classifiers.push_back(std::make_unique<Classifier>(
+			std::vector<ClassifierValueInterval>{ std::move(interval) }));
+		return classifiers.back().get();
+	}
+};
+
+// 40 slot inventory with 4 item classes. the gold class has quantities.
+static std::unique_ptr<ItemFixture> makeInventoryFixture()
+{
+	auto data = std::make_unique<ItemFixture>();
+	for (auto id : { "sword", "potion", "scroll", "gold" })
+	{
+		data->addItemClass(id);
+	}
+	data->classes.back()->setDefaultByHash(ItemProp::Capacity, 5000);
+	for (size_t i = 0; i < data->inventory.Size(); i++)
+	{
+		auto item = std::make_shared<Item>(data->classes[i % data->classes.size()].get());
+		if (item->Class()->Id() == "gold")
+		{
+			item->setIntByHash(ItemProp::Quantity, 5000 - (LevelObjValue)i);
+		}
+		data->inventory.set(i, item);
+	}
+	return data;
+}
+
+// weapon class with prefix/suffix names, prefix prices (formulas) and a description.
+static std::unique_ptr<ItemFixture> makeItemFixture()
+{
+	auto data = std::make_unique<ItemFixture>();
+	data->weapon = data->addItemClass("sword");
+	data->weapon->Name("Short Sword");
+	data->weapon->setPrefix(data->addClassifier(makeInterval("prefix", {
+		{ { 1, 1 }, Variable(std::string("Sharp")) },
+		{ { 2, 2 }, Variable(std::string("Fine")) },
+		{ { 3, 3 }, Variable(std::string("King's")) } })));
+	data->weapon->setSuffix(data->addClassifier(makeInterval("suffix", {
+		{ { 1, 1 }, Variable(std::string("of Might")) },
+		{ { 2, 2 }, Variable(std::string("of the Fox")) },
+		{ { 3, 3 }, Variable(std::string("of Haste")) } })));
+	data->weapon->setPricePrefix1(data->addClassifier(makeInterval("prefix", {
+		{ { 1, 1 }, Variable(std::string("100 + damage * 2")) },
+		{ { 2, 2 }, Variable(std::string("(damage * 10) :max 150")) },
+		{ { 3, 3 }, Variable((int64_t)5000) } })));
+	data->weapon->setDescription(0, data->addClassifier(makeInterval("", {
+		{ { 0, 0 }, Variable(std::string("Damage: 2-6")) } })), 0);
+
+	data->generator.setProperty(ItemProp::Identified, 1, 1);
+	data->generator.setProperty(str2int16("prefix"), 0, 3);
+	data->generator.setProperty(str2int16("suffix"), 0, 3);
+	data->generator.setProperty(str2int16("damage"), 1, 20);
+	return data;
+}
+
+static constexpr LevelObjValue NumItemAffixes = 64;
+
+// many prefixes/suffixes and descriptions by damage range, like the game's item classes.
+static std::unique_ptr<ItemFixture> makeItemNamesFixture()
+{
+	auto data = makeItemFixture();
+	std::vector<std::pair<ClassifierValue::ValuePair, Variable>> prefixes;
+	std::vector<std::pair<ClassifierValue::ValuePair, Variable>> suffixes;
+	std::vector<std::pair<ClassifierValue::ValuePair, Variable>> descriptions;
+	for (LevelObjValue i = 1; i <= NumItemAffixes; i++)
+	{
+		prefixes.push_back({ { i, i }, Variable("Prefix" + std::to_string(i)) });
+		suffixes.push_back({ { i, i }, Variable("of Suffix" + std::to_string(i)) });
+	}
+	for (LevelObjValue i = 0; i < 20; i++)
+	{
+		descriptions.push_back({ { i * 5, i * 5 + 4 },
+			Variable("Damage: " + std::to_string(i * 5) + "+") });
+	}
+	data->weapon->setPrefix(data->addClassifier(makeInterval("prefix", prefixes)));
+	data->weapon->setSuffix(data->addClassifier(makeInterval("suffix", suffixes)));
+	data->weapon->setDescription(0, data->addClassifier(makeInterval("damage", descriptions)), 0);
+
+	data->generator.setProperty(str2int16("prefix"), 0, NumItemAffixes);
+	data->generator.setProperty(str2int16("suffix"), 0, NumItemAffixes);
+	data->generator.setProperty(str2int16("damage"), 0, 99);
+	return data;
+}
+
+// dungeon sized level (3 layers) with 500 generated items on the floor.
+static std::unique_ptr<ItemFixture> makeLevelFixture()
+{
+	auto data = makeItemFixture();
+
+	auto map = makeMap();
+	std::mt19937 rng(1);
+	for (int32_t y = 0; y < map.MapSizei().y; y++)
+	{
+		for (int32_t x = 0; x < map.MapSizei().x; x++)
+		{
+			auto& cell = map[x][y];
+			if (cell.getTileIndex(LevelCell::SolLayer) != 0)
+			{
+				cell.setTileIndex(0, (int16_t)(25 + y % 3));
+				cell.setTileIndex(1, (int16_t)(40 + y % 3));
+			}
+			else
+			{
+				auto rnd = Utils::Random::get<int>(rng, 0, 99);
+				cell.setTileIndex(0, (int16_t)(rnd < 10 ? 100 + rnd : 13 + (x / 2 + y / 2) % 2));
+			}
+		}
+	}
+	data->level.Init(data->game, std::move(map), {}, 64, 32, -1);
+
+	for (std::string_view prop : { "prefix", "suffix", "damage" })
+	{
+		data->level.setPropertyName(str2int16(prop), prop);
+	}
+	std::vector<std::shared_ptr<Item>> items;
+	data->generator.generate(*data->weapon, 500, items);
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		PairFloat mapCoord((float)(1 + (i * 7) % 110), (float)(1 + (i * 13) % 110));
+		items[i]->MapPosition(data->level, mapCoord);
+		data->level.addLevelObject(std::move(items[i]));
+	}
+	return data;
+}
+
+BENCHMARK(inventoryFindByClass)
+{
+	auto data = makeInventoryFixture();
+	auto classIdHash16 = str2int16("gold");
+	while (state.keepRunning() == true)
+	{
+		size_t idx = 0;
+		Item* item = nullptr;
+		while (data->inventory.findByClass(classIdHash16, idx, item) == true)
+		{
+			idx++;
+		}
+		doNotOptimize(item);
+	}
+}
+
+BENCHMARK(inventoryGetQuantity)
+{
+	auto data = makeInventoryFixture();
+	auto classIdHash16 = str2int16("gold");
+	while (state.keepRunning() == true)
+	{
+		doNotOptimize(data->inventory.getQuantity(classIdHash16));
+	}
+}
+
+BENCHMARK(inventoryFindFreeQuantity)
+{
+	auto data = makeInventoryFixture();
+	auto classIdHash16 = str2int16("gold");
+	while (state.keepRunning() == true)
+	{
+		Item* item = nullptr;
+		doNotOptimize(data->inventory.findBiggestFreeQuantity(classIdHash16, item));
+		doNotOptimize(data->inventory.findSmallestFreeQuantity(classIdHash16, item));
+	}
+}
+
+BENCHMARK(inventoryHasItem)
+{
+	auto data = makeInventoryFixture();
+	auto classIdHash16 = str2int16("scroll");
+	while (state.keepRunning() == true)
+	{
+		doNotOptimize(data->inventory.hasItem(classIdHash16));
+		doNotOptimize(data->inventory.isFull());
+	}
+}
+
+static constexpr size_t NumGeneratedItems = 100000;
+
+// items created and updated one at a time (the update runs on the first query).
+BENCHMARK(itemCreate100k)
+{
+	auto data = makeItemFixture();
+	std::vector<std::shared_ptr<Item>> items;
+	while (state.keepRunning() == true)
+	{
+		items.clear();
+		for (size_t i = 0; i < NumGeneratedItems; i++)
+		{
+			auto item = std::make_shared<Item>(data->weapon);
+			item->setIntByHash(ItemProp::Identified, 1);
+			item->setIntByHash(str2int16("prefix"), Utils::Random::get<LevelObjValue>(3));
+			item->setIntByHash(str2int16("suffix"), Utils::Random::get<LevelObjValue>(3));
+			item->setIntByHash(str2int16("damage"), Utils::Random::get<LevelObjValue>(1, 20));
+			Variable name;
+			item->getProperty("name", name);
+			items.push_back(std::move(item));
+		}
+		doNotOptimize(items.data());
+	}
+	state.setItemsProcessed(state.Iterations() * NumGeneratedItems);
+}
+
+BENCHMARK(itemGenerate100k)
+{
+	auto data = makeItemFixture();
+	std::vector<std::shared_ptr<Item>> items;
+	while (state.keepRunning() == true)
+	{
+		items.clear();
+		data->generator.generate(*data->weapon, NumGeneratedItems, items);
+		doNotOptimize(items.data());
+	}
+	state.setItemsProcessed(state.Iterations() * NumGeneratedItems);
+}
+
+// name shown when hovering an item.
+BENCHMARK(itemFullName)
+{
+	auto data = makeItemNamesFixture();
+	std::vector<std::shared_ptr<Item>> items;
+	data->generator.generate(*data->weapon, 1024, items);
+	std::string name;
+	size_t i = 0;
+	while (state.keepRunning() == true)
+	{
+		data->weapon->getFullName(*items[i++ % items.size()], name);
+		doNotOptimize(name);
+	}
+}
+
+BENCHMARK(itemDescription)
+{
+	auto data = makeItemNamesFixture();
+	std::vector<std::shared_ptr<Item>> items;
+	data->generator.generate(*data->weapon, 1024, items);
+	std::string description;
+	size_t i = 0;
+	while (state.keepRunning() == true)
+	{
+		data->weapon->getDescription(0, *items[i++ % items.size()], description);
+		doNotOptimize(description);
+	}
+}
+
+// items processed is the size of the saves.
+static void saveLevel(Benchmark::State& state, bool saveBinary, bool compress)
+{
+	auto data = makeLevelFixture();
+	Save::Properties props;
+	props.saveBinary = saveBinary;
+	props.compress = compress;
+	uint64_t size = 0;
+	while (state.keepRunning() == true)
+	{
+		auto file = Save::serializeToString(props, data->game, data->level);
+		size += file.size();
+		doNotOptimize(file);
+	}
+	state.setItemsProcessed(size);
+}
+
+static void loadLevel(Benchmark::State& state, bool saveBinary, bool compress)
+{
+	auto data = makeLevelFixture();
+	Save::Properties props;
+	props.saveBinary = saveBinary;
+	props.compress = compress;
+	auto file = Save::serializeToString(props, data->game, data->level);
+	while (state.keepRunning() == true)
+	{
+		rapidjson::Document doc;
+		doNotOptimize(JsonUtils::loadJsonPacked(file, doc));
+	}
+	state.setItemsProcessed(state.Iterations() * file.size());
+}
+
+BENCHMARK(levelSaveJson)
+{
+	saveLevel(state, false, false);
+}
+
+BENCHMARK(levelSaveBinary)
+{
+	saveLevel(state, true, false);
+}
+
+BENCHMARK(levelSaveBinaryLZ4)
+{
+	saveLevel(state, true, true);
+}
+
+BENCHMARK(levelLoadJson)
+{
+	loadLevel(state, false, false);
+}
+
+BENCHMARK(levelLoadBinary)
+{
+	loadLevel(state, true, false);
+}
+
+BENCHMARK(levelLoadBinaryLZ4)
+{
+	loadLevel(state, true, true);
+}
+
+// main thread part of Save::saveAsync.
+BENCHMARK(levelSaveSnapshot)
+{
+	auto data = makeLevelFixture();
+	Save::Properties props;
+	while (state.keepRunning() == true)
+	{
+		JsonBinary::Writer snapshot;
+		Save::Writer writer(snapshot);
+		Save::serialize(&writer, props, data->game, data->level);
+		doNotOptimize(snapshot);
+	}
+}
+
+// worker part of Save::saveAsync (json saves).
+BENCHMARK(levelSaveSnapshotJson)
+{
+	auto data = makeLevelFixture();
+	Save::Properties props;
+	JsonBinary::Writer snapshot;
+	Save::Writer writer(snapshot);
+	Save::serialize(&writer, props, data->game, data->level);
+	uint64_t size = 0;
+	while (state.keepRunning() == true)
+	{
+		auto file = snapshot.getJson();
+		size += file.size();
+		doNotOptimize(file);
+	}
+	state.setItemsProcessed(size);
+}
+
+// parallel_for over a light sized workload, by number of workers.
+BENCHMARK_ARGS(jobSystemParallelFor, 0, 1, 2, 4, 8)
+{
+	JobSystem jobs;
+	jobs.WorkerCount((unsigned)state.Arg());
+	std::vector<float> values(64 * 1024, 1.f);
+	while (state.keepRunning() == true)
+	{
+		jobs.parallel_for(0, values.size(), 1024, [&values](size_t i)
+		{
+			values[i] = values[i] * 0.5f + 1.f;
+		});
+	}
+	doNotOptimize(values);
+	state.setItemsProcessed(state.Iterations() * values.size());
+}
@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "FileUtils.h"
+#include <string_view>
+
+// DGEngineBench [--gamefiles <dir>] [--data <path>] [--filter <name>]
+//               [--min-time <seconds>] [--output <file.json>]
+//
+// the gamefiles folder is mounted first and the data path (a folder or an
+// archive like DIABDAT.MPQ) after it. benchmarks whose inputs aren't
+// found in either are skipped.
+int main(int argc, char* argv[])
+{
+	Benchmark::Options options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg(argv[i]);
+		if (arg == "--help" || arg == "-h")
+		{
+			std::printf("usage: DGEngineBench [--gamefiles <dir>] [--data <path>] "
+				"[--filter <name>] [--min-time <seconds>] [--output <file.json>]\n");
+			return 0;
+		}
+		if (i + 1 >= argc)
+		{
+			std::fprintf(stderr, "missing value for %s\n", argv[i]);
+			return 1;
+		}
+		if (arg == "--gamefiles")
+		{
+			options.gamefilesPath = argv[++i];
+		}
+		else if (arg == "--data")
+		{
+			options.dataPath = argv[++i];
+		}
+		else if (arg == "--filter")
+		{
+			options.filter = argv[++i];
+		}
+		else if (arg == "--min-time")
+		{
+			options.minTime = std::max(std::atof(argv[++i]), 0.01);
+		}
+		else if (arg == "--output")
+		{
+			options.outputFile = argv[++i];
+		}
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	FileUtils::initPhysFS(argv[0]);
+	if (FileUtils::mount(options.gamefilesPath, "", true) == false)
+	{
+		std::fprintf(stderr, "can't mount gamefiles %s\n", options.gamefilesPath.c_str());
+	}
+	if (options.dataPath.empty() == false &&
+		FileUtils::mount(options.dataPath, "", true) == false)
+	{
+		std::fprintf(stderr, "can't mount data %s\n", options.dataPath.c_str());
+	}
+
+	Benchmark::run(options);
+
+	FileUtils::deinitPhysFS();
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+#include "BitmapFont.h"
+#include <filesystem>
+#include <fstream>
+#include "Json/JsonUtils.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include "TexturePacks/BitmapFontTexturePack.h"
+#include "Utils/NumberVector.h"
+#include <vector>
+
+using Benchmark::doNotOptimize;
+
+// the json files of the gamefiles folder (not archives).
+static std::vector<std::string> readJsonFiles()
+{
+	std::vector<std::string> files;
+	try
+	{
+		auto path = std::filesystem::u8path(Benchmark::getOptions().gamefilesPath);
+		if (std::filesystem::is_directory(path) == false)
+		{
+			return files;
+		}
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file() == false ||
+				entry.path().extension() != ".json")
+			{
+				continue;
+			}
+			std::ifstream file(entry.path(), std::ios::in | std::ios::binary);
+			std::stringstream ss;
+			ss << file.rdbuf();
+			files.push_back(ss.str());
+		}
+	}
+	catch (std::exception&) {}
+	return files;
+}
+
+static uint64_t getTotalSize(const std::vector<std::string>& files)
+{
+	uint64_t size = 0;
+	for (const auto& file : files)
+	{
+		size += file.size();
+	}
+	return size;
+}
+
+BENCHMARK(jsonParseGamefiles)
+{
+	auto files = readJsonFiles();
+	if (files.empty() == true)
+	{
+		state.skip("no json files in " + Benchmark::getOptions().gamefilesPath);
+		return;
+	}
+	while (state.keepRunning() == true)
+	{
+		for (const auto& file : files)
+		{
+			rapidjson::Document doc;
+			doNotOptimize(JsonUtils::loadJson(file, doc));
+		}
+	}
+	state.setItemsProcessed(state.Iterations() * getTotalSize(files));
+}
+
+// SAX reader that packs integer arrays (level data).
+BENCHMARK(jsonParsePackedGamefiles)
+{
+	auto files = readJsonFiles();
+	if (files.empty() == true)
+	{
+		state.skip("no json files in " + Benchmark::getOptions().gamefilesPath);
+		return;
+	}
+	while (state.keepRunning() == true)
+	{
+		for (const auto& file : files)
+		{
+			rapidjson::Document doc;
+			doNotOptimize(JsonUtils::loadJsonPacked(file, doc));
+		}
+	}
+	state.setItemsProcessed(state.Iterations() * getTotalSize(files));
+}
+
+// smaltext font from gamefilesd (char sizes file) with a blank texture.
+static std::unique_ptr<BitmapFont> makeFont()
+{
+	constexpr const char* charSizeFile = "res/level/smaltextSize.bin";
+	if (FileUtils::exists(charSizeFile) == false)
+	{
+		return nullptr;
+	}
+	NumberVector<uint8_t> charSizes(charSizeFile, 0, 0x7FFF);
+	auto texture = std::make_shared<sf::Texture>();
+	texture->create(208, 208);
+	auto texturePack = std::make_shared<BitmapFontTexturePack>(
+		texture, nullptr, 16, 16, true, charSizes.getContainer(), 0, 1, 0, 0);
+	return std::make_unique<BitmapFont>(texturePack, 0);
+}
+
+static void updateVertexString(Benchmark::State& state, const std::string& text, HorizontalAlign align)
+{
+	auto font = makeFont();
+	if (font == nullptr)
+	{
+		state.skip("missing res/level/smaltextSize.bin");
+		return;
+	}
+	std::vector<sf::Vertex> vertices;
+	while (state.keepRunning() == true)
+	{
+		font->updateVertexString(vertices, text, sf::Color::White, 0, 0, 320.f, align);
+		doNotOptimize(vertices.data());
+	}
+	state.setItemsProcessed(state.Iterations() * text.size());
+}
+
+// short text that changes every frame (panel gold, life).
+BENCHMARK(bitmapFontUpdateShort)
+{
+	updateVertexString(state, "Gold: 12345", HorizontalAlign::Left);
+}
+
+// item description panel.
+BENCHMARK(bitmapFontUpdateMultiline)
+{
+	updateVertexString(state,
+		"Short Sword\nDamage: 2-6\nDurability: 24/24\n"
+		"Required: 18 Str\n+10% chance to hit\nUnidentified\n"
+		"Price: 120 gold", HorizontalAlign::Center);
+}
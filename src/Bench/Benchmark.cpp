@@ -0,0 +1,216 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "Json/JsonParser.h"
+#include "Utils/AllocationCounter.h"
+
+namespace Benchmark
+{
+	struct Result
+	{
+		std::string name;
+		uint64_t iterations{ 0 };
+		double nsPerIteration{ 0.0 };
+		double itemsPerSecond{ 0.0 };
+		double allocationsPerIteration{ 0.0 };
+		std::string skipReason;
+	};
+
+	static Options options;
+
+	State::State(double minTime_, int64_t arg_) : arg(arg_)
+	{
+		minTime = std::chrono::duration_cast<Clock::duration>(
+			std::chrono::duration<double>(minTime_));
+	}
+
+	void State::start()
+	{
+		started = true;
+		startAllocations = AllocationCounter::get();
+		startTime = Clock::now();
+	}
+
+	void State::stop()
+	{
+		if (paused == false)
+		{
+			elapsed += Clock::now() - startTime;
+		}
+		allocations = AllocationCounter::get() - startAllocations;
+		finished = true;
+	}
+
+	bool State::check()
+	{
+		if (finished == true || Skipped() == true)
+		{
+			return false;
+		}
+		auto total = elapsed;
+		if (paused == false)
+		{
+			total += Clock::now() - startTime;
+		}
+		if (total >= minTime)
+		{
+			stop();
+			return false;
+		}
+		// aim for the next check near the end of the run
+		if (total.count() > 0)
+		{
+			auto estimate = (double)iterations * (double)minTime.count() / (double)total.count();
+			nextCheck = std::max(iterations + 1, std::min(iterations * 10, (uint64_t)estimate));
+		}
+		else
+		{
+			nextCheck = iterations * 10;
+		}
+		iterations++;
+		return true;
+	}
+
+	void State::pauseTiming()
+	{
+		if (paused == false)
+		{
+			elapsed += Clock::now() - startTime;
+			paused = true;
+		}
+	}
+
+	void State::resumeTiming()
+	{
+		if (paused == true)
+		{
+			startTime = Clock::now();
+			paused = false;
+		}
+	}
+
+	void State::skip(const std::string_view reason)
+	{
+		skipReason = reason;
+		if (skipReason.empty() == true)
+		{
+			skipReason = "skipped";
+		}
+	}
+
+	double State::ElapsedSeconds() const noexcept
+	{
+		return std::chrono::duration<double>(elapsed).count();
+	}
+
+	const Options& getOptions() noexcept
+	{
+		return options;
+	}
+
+	static void writeResults(const std::string_view outputFile, const std::vector<Result>& results)
+	{
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("benchmarks");
+		writer.StartArray();
+		for (const auto& result : results)
+		{
+			writer.StartObject();
+			writer.Key("name");
+			writer.String(result.name.c_str());
+			if (result.skipReason.empty() == false)
+			{
+				writer.Key("skipped");
+				writer.String(result.skipReason.c_str());
+			}
+			else
+			{
+				writer.Key("iterations");
+				writer.Uint64(result.iterations);
+				writer.Key("ns");
+				writer.Double(result.nsPerIteration);
+				writer.Key("itemsPerSecond");
+				writer.Double(result.itemsPerSecond);
+				writer.Key("allocations");
+				writer.Double(result.allocationsPerIteration);
+			}
+			writer.EndObject();
+		}
+		writer.EndArray();
+		writer.EndObject();
+
+		try
+		{
+			std::ofstream file(std::filesystem::u8path(outputFile), std::ios::out | std::ios::binary);
+			file.write(buffer.GetString(), buffer.GetSize());
+		}
+		catch (std::exception&) {}
+	}
+
+	size_t run(const Options& options_)
+	{
+		options = options_;
+
+		auto allocationCounterEnabled = AllocationCounter::Enabled();
+		AllocationCounter::Enabled(true);
+
+		std::vector<Result> results;
+		std::printf("%-40s %14s %12s %14s %10s\n",
+			"benchmark", "ns", "iterations", "items/s", "allocs");
+
+		Benchmarks::forEach(options.filter, [&results](const Benchmarks::Entry& entry)
+		{
+			State state(options.minTime, entry.arg);
+			try
+			{
+				entry.func(state);
+			}
+			catch (std::exception& ex)
+			{
+				state.skip(ex.what());
+			}
+
+			Result result;
+			result.name = entry.name;
+			result.skipReason = state.SkipReason();
+			if (result.skipReason.empty() == true && state.Iterations() > 0)
+			{
+				auto iterations = (double)state.Iterations();
+				auto seconds = state.ElapsedSeconds();
+				result.iterations = state.Iterations();
+				result.nsPerIteration = seconds * 1e9 / iterations;
+				result.allocationsPerIteration = (double)state.Allocations() / iterations;
+				if (seconds > 0.0)
+				{
+					result.itemsPerSecond = (double)state.ItemsProcessed() / seconds;
+				}
+				std::printf("%-40s %14.1f %12llu %14.0f %10.1f\n",
+					result.name.c_str(), result.nsPerIteration,
+					(unsigned long long)result.iterations,
+					result.itemsPerSecond, result.allocationsPerIteration);
+			}
+			else
+			{
+				if (result.skipReason.empty() == true)
+				{
+					result.skipReason = "no iterations";
+				}
+				std::printf("%-40s skipped: %s\n", result.name.c_str(), result.skipReason.c_str());
+			}
+			std::fflush(stdout);
+			results.push_back(std::move(result));
+		});
+
+		AllocationCounter::Enabled(allocationCounterEnabled);
+
+		if (options.outputFile.empty() == false)
+		{
+			writeResults(options.outputFile, results);
+		}
+		return results.size();
+	}
+}
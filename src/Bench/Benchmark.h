@@ -0,0 +1,125 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "Utils/Registry.h"
+
+// small harness for the DGEngineBench microbenchmarks.
+// a benchmark runs its timed code while state.keepRunning() is true:
+//
+// BENCHMARK(formulaEval)
+// {
+//   Formula formula("2 + (2 * 4)");
+//   while (state.keepRunning() == true)
+//   {
+//     doNotOptimize(formula.eval());
+//   }
+// }
+//
+// benchmarks that need files that aren't available call state.skip().
+namespace Benchmark
+{
+	struct Options
+	{
+		// folder with the engine's gamefiles (json, fonts, trn files).
+		std::string gamefilesPath{ "gamefilesd" };
+		// folder or archive with the game's assets (DIABDAT.MPQ, d2data.mpq).
+		std::string dataPath;
+		// only runs benchmarks whose name contains the filter.
+		std::string filter;
+		// writes the results as json.
+		std::string outputFile;
+		double minTime{ 0.5 };
+	};
+
+	class State
+	{
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		Clock::time_point startTime;
+		Clock::duration minTime;
+		Clock::duration elapsed{ 0 };
+		uint64_t iterations{ 0 };
+		uint64_t nextCheck{ 1 };
+		uint64_t items{ 0 };
+		uint64_t startAllocations{ 0 };
+		uint64_t allocations{ 0 };
+		bool started{ false };
+		bool finished{ false };
+		bool paused{ false };
+		std::string skipReason;
+		int64_t arg{ 0 };
+
+		void start();
+		void stop();
+
+	public:
+		State(double minTime_, int64_t arg_);
+
+		// the clock is only checked every few iterations, so this stays
+		// cheap for benchmarks that take nanoseconds.
+		bool keepRunning()
+		{
+			if (iterations < nextCheck)
+			{
+				if (started == false)
+				{
+					start();
+				}
+				iterations++;
+				return true;
+			}
+			return check();
+		}
+
+		bool check();
+
+		// excludes setup inside the loop from the time.
+		void pauseTiming();
+		void resumeTiming();
+
+		void skip(const std::string_view reason);
+
+		// items processed in all iterations (bytes, frames, nodes).
+		void setItemsProcessed(uint64_t items_) noexcept { items = items_; }
+
+		int64_t Arg() const noexcept { return arg; }
+		uint64_t Iterations() const noexcept { return iterations; }
+		uint64_t ItemsProcessed() const noexcept { return items; }
+		uint64_t Allocations() const noexcept { return allocations; }
+		double ElapsedSeconds() const noexcept;
+		bool Skipped() const noexcept { return skipReason.empty() == false; }
+		const std::string& SkipReason() const noexcept { return skipReason; }
+	};
+
+	typedef std::function<void(State&)> Function;
+	// BENCHMARK_ARGS runs the function once for each arg (see State::Arg).
+	typedef Registry<Function> Benchmarks;
+
+	const Options& getOptions() noexcept;
+
+	// returns the number of benchmarks that ran.
+	size_t run(const Options& options);
+
+	// keeps the compiler from removing the computation of value.
+	template <class T>
+	inline void doNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+}
+
+#define BENCHMARK(name) \
+	REGISTER_FUNCTION(Benchmark::Benchmarks, name, (Benchmark::State& state))
+
+#define BENCHMARK_ARGS(name, ...) \
+	REGISTER_FUNCTION(Benchmark::Benchmarks, name, (Benchmark::State& state), __VA_ARGS__)
@@ -0,0 +1,435 @@
+#include "BenchRunner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include "FrameProfiler.h"
+#include "Game.h"
+#include "GameUtils.h"
+#include "InputRecorder.h"
+#include "Json/JsonParser.h"
+#include "Parser/ParseAction.h"
+#include "Parser/Utils/ParseUtils.h"
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/String.hpp>
+#include <sstream>
+#include "Utils/AllocationCounter.h"
+#include "Utils/FrameArena.h"
+#include "Utils/Utils.h"
+#include <vector>
+
+namespace BenchRunner
+{
+	using namespace Parser;
+
+	struct FrameStats
+	{
+		int64_t update{ 0 };
+		int64_t draw{ 0 };
+		uint64_t allocations{ 0 };
+		uint64_t arenaBytes{ 0 };
+	};
+
+	struct ScriptInput
+	{
+		unsigned frame{ 0 };
+		std::vector<sf::Event> events;
+		std::shared_ptr<Action> action;
+	};
+
+	static bool loadScript(const std::string_view scriptFile, rapidjson::Document& doc)
+	{
+		try
+		{
+			std::ifstream file(std::filesystem::u8path(scriptFile), std::ios::in | std::ios::binary);
+			if (file.is_open() == false)
+			{
+				return false;
+			}
+			std::stringstream ss;
+			ss << file.rdbuf();
+			auto json = ss.str();
+			doc.Parse(json.data(), json.size());
+			return doc.HasParseError() == false && doc.IsObject() == true;
+		}
+		catch (std::exception&)
+		{
+			return false;
+		}
+	}
+
+	static sf::Mouse::Button getMouseButton(const std::string_view str)
+	{
+		switch (str2int16(Utils::toLower(str)))
+		{
+		case str2int16("right"):
+			return sf::Mouse::Right;
+		case str2int16("middle"):
+			return sf::Mouse::Middle;
+		default:
+			return sf::Mouse::Left;
+		}
+	}
+
+	static void addMouseEvents(std::vector<sf::Event>& events,
+		const rapidjson::Value& elem, bool press, bool release)
+	{
+		// presses use the current mouse position, so move first
+		auto position = getVector2iKey<sf::Vector2i>(elem, "position");
+		sf::Event evt;
+		evt.type = sf::Event::MouseMoved;
+		evt.mouseMove.x = position.x;
+		evt.mouseMove.y = position.y;
+		events.push_back(evt);
+
+		evt.mouseButton.button = getMouseButton(getStringViewKey(elem, "button"));
+		evt.mouseButton.x = position.x;
+		evt.mouseButton.y = position.y;
+		if (press == true)
+		{
+			evt.type = sf::Event::MouseButtonPressed;
+			events.push_back(evt);
+		}
+		if (release == true)
+		{
+			evt.type = sf::Event::MouseButtonReleased;
+			events.push_back(evt);
+		}
+	}
+
+	static void addKeyEvent(std::vector<sf::Event>& events,
+		const rapidjson::Value& elem, sf::Event::EventType type)
+	{
+		sf::Event evt;
+		evt.type = type;
+		evt.key.code = GameUtils::getKeyCode(getStringViewKey(elem, "key"), sf::Keyboard::Unknown);
+		evt.key.alt = getBoolKey(elem, "alt");
+		evt.key.control = getBoolKey(elem, "control");
+		evt.key.shift = getBoolKey(elem, "shift");
+		evt.key.system = getBoolKey(elem, "system");
+		events.push_back(evt);
+	}
+
+	static void addTextEvents(std::vector<sf::Event>& events, const rapidjson::Value& elem)
+	{
+		auto text = getStringViewKey(elem, "text");
+		auto str = sf::String::fromUtf8(text.begin(), text.end());
+		for (auto ch : str)
+		{
+			sf::Event evt;
+			evt.type = sf::Event::TextEntered;
+			evt.text.unicode = ch;
+			events.push_back(evt);
+		}
+	}
+
+	static std::vector<ScriptInput> parseInput(Game& game, const rapidjson::Value& elem)
+	{
+		std::vector<ScriptInput> input;
+		if (elem.IsArray() == false)
+		{
+			return input;
+		}
+		for (const auto& val : elem)
+		{
+			if (val.IsObject() == false)
+			{
+				continue;
+			}
+			ScriptInput scriptInput;
+			scriptInput.frame = getUIntKey(val, "frame");
+			switch (str2int16(getStringViewKey(val, "type")))
+			{
+			case str2int16("action"):
+				if (val.HasMember("action") == true)
+				{
+					scriptInput.action = parseAction(game, val["action"]);
+				}
+				break;
+			case str2int16("click"):
+				addMouseEvents(scriptInput.events, val, true, true);
+				break;
+			case str2int16("keyPress"):
+				addKeyEvent(scriptInput.events, val, sf::Event::KeyPressed);
+				break;
+			case str2int16("keyRelease"):
+				addKeyEvent(scriptInput.events, val, sf::Event::KeyReleased);
+				break;
+			case str2int16("mouseMove"):
+				addMouseEvents(scriptInput.events, val, false, false);
+				break;
+			case str2int16("mousePress"):
+				addMouseEvents(scriptInput.events, val, true, false);
+				break;
+			case str2int16("mouseRelease"):
+				addMouseEvents(scriptInput.events, val, false, true);
+				break;
+			case str2int16("text"):
+				addTextEvents(scriptInput.events, val);
+				break;
+			default:
+				continue;
+			}
+			input.push_back(std::move(scriptInput));
+		}
+		std::stable_sort(input.begin(), input.end(),
+			[](const ScriptInput& a, const ScriptInput& b) { return a.frame < b.frame; });
+		return input;
+	}
+
+	// values must be sorted.
+	template <class T>
+	static T percentile(const std::vector<T>& sorted, double pct)
+	{
+		if (sorted.empty() == true)
+		{
+			return {};
+		}
+		auto idx = (size_t)(pct / 100.0 * (double)(sorted.size() - 1) + 0.5);
+		return sorted[std::min(idx, sorted.size() - 1)];
+	}
+
+	template <class T>
+	static void writeStats(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+		const char* key, std::vector<T> values, double scale)
+	{
+		std::sort(values.begin(), values.end());
+		double total = 0.0;
+		for (auto val : values)
+		{
+			total += (double)val;
+		}
+		writer.Key(key);
+		writer.StartObject();
+		writer.Key("mean");
+		writer.Double(values.empty() == false ? total / (double)values.size() * scale : 0.0);
+		writer.Key("p50");
+		writer.Double((double)percentile(values, 50.0) * scale);
+		writer.Key("p90");
+		writer.Double((double)percentile(values, 90.0) * scale);
+		writer.Key("p99");
+		writer.Double((double)percentile(values, 99.0) * scale);
+		writer.Key("max");
+		writer.Double(values.empty() == false ? (double)values.back() * scale : 0.0);
+		writer.EndObject();
+	}
+
+	static bool writeReport(const std::string_view outputFile,
+		const std::vector<FrameStats>& frames, uint32_t seed, unsigned frameRate)
+	{
+		std::vector<int64_t> updateTimes;
+		std::vector<int64_t> drawTimes;
+		std::vector<int64_t> frameTimes;
+		std::vector<uint64_t> allocations;
+		std::vector<uint64_t> arenaBytes;
+		uint64_t totalAllocations = 0;
+		for (const auto& frame : frames)
+		{
+			updateTimes.push_back(frame.update);
+			drawTimes.push_back(frame.draw);
+			frameTimes.push_back(frame.update + frame.draw);
+			allocations.push_back(frame.allocations);
+			arenaBytes.push_back(frame.arenaBytes);
+			totalAllocations += frame.allocations;
+		}
+
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("seed");
+		writer.Uint(seed);
+		writer.Key("frameRate");
+		writer.Uint(frameRate);
+		writer.Key("frames");
+		writer.Uint64(frames.size());
+
+		// times in milliseconds
+		writer.Key("stats");
+		writer.StartObject();
+		writeStats(writer, "update", updateTimes, 0.001);
+		writeStats(writer, "draw", drawTimes, 0.001);
+		writeStats(writer, "frame", frameTimes, 0.001);
+		writeStats(writer, "allocations", allocations, 1.0);
+		// bytes of temporary data allocated from the frame arena
+		writeStats(writer, "arenaBytes", arenaBytes, 1.0);
+		writer.EndObject();
+		writer.Key("totalAllocations");
+		writer.Uint64(totalAllocations);
+
+		// times in microseconds
+		writer.Key("perFrame");
+		writer.StartObject();
+		writer.Key("update");
+		writer.StartArray();
+		for (auto val : updateTimes)
+		{
+			writer.Int64(val);
+		}
+		writer.EndArray();
+		writer.Key("draw");
+		writer.StartArray();
+		for (auto val : drawTimes)
+		{
+			writer.Int64(val);
+		}
+		writer.EndArray();
+		writer.Key("allocations");
+		writer.StartArray();
+		for (auto val : allocations)
+		{
+			writer.Uint64(val);
+		}
+		writer.EndArray();
+		writer.EndObject();
+		writer.EndObject();
+
+		bool written = false;
+		try
+		{
+			std::ofstream file(std::filesystem::u8path(outputFile), std::ios::out | std::ios::binary);
+			file.write(buffer.GetString(), buffer.GetSize());
+			written = file.good();
+		}
+		catch (std::exception&) {}
+		if (written == false)
+		{
+			std::fprintf(stderr, "bench: can't write %s\n", std::string(outputFile).c_str());
+		}
+
+		std::sort(frameTimes.begin(), frameTimes.end());
+		std::sort(allocations.begin(), allocations.end());
+		std::printf("bench: %llu frames, frame p50 %.3f ms, p99 %.3f ms, allocs p50 %llu, total %llu\n",
+			(unsigned long long)frames.size(),
+			(double)percentile(frameTimes, 50.0) / 1000.0,
+			(double)percentile(frameTimes, 99.0) / 1000.0,
+			(unsigned long long)percentile(allocations, 50.0),
+			(unsigned long long)totalAllocations);
+		return written;
+	}
+
+	bool run(Game& game, const std::string_view gamefilePath, const std::string_view scriptFile)
+	{
+		rapidjson::Document doc;
+		if (loadScript(scriptFile, doc) == false)
+		{
+			std::fprintf(stderr, "bench: can't load script %s\n", std::string(scriptFile).c_str());
+			return false;
+		}
+
+		// OpenAL's null device (no audio output)
+#ifdef _WIN32
+		_putenv_s("ALSOFT_DRIVERS", "null");
+#else
+		setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+
+		auto seed = (uint32_t)getUIntKey(doc, "seed", 1);
+		auto frameRate = std::max(getUIntKey(doc, "frameRate", 60), 1u);
+		auto numFrames = getUIntKey(doc, "frames", 600);
+		auto warmupFrames = getUIntKey(doc, "warmupFrames");
+		auto outputFile = getStringKey(doc, "output", "bench.json");
+		auto replayFile = getStringViewKey(doc, "replay");
+
+		// replays use their own seed and frame times
+		bool replaying = replayFile.empty() == false;
+		if (replaying == true)
+		{
+			if (InputRecorder::replay(replayFile) == false)
+			{
+				std::fprintf(stderr, "bench: can't load replay %s\n", std::string(replayFile).c_str());
+				return false;
+			}
+			if (doc.HasMember("frames") == false)
+			{
+				auto replayFrames = (unsigned)InputRecorder::getFrameCount();
+				numFrames = replayFrames > warmupFrames ? replayFrames - warmupFrames : 0;
+			}
+		}
+		else
+		{
+			Utils::Random::seed(seed);
+		}
+		game.Headless(true);
+		game.load(gamefilePath, "main.json");
+
+		// actions are parsed after loading, so they can use the game's resources
+		std::vector<ScriptInput> input;
+		if (doc.HasMember("input") == true)
+		{
+			input = parseInput(game, doc["input"]);
+		}
+
+		auto frameTime = sf::microseconds(1000000 / (sf::Int64)frameRate);
+		std::vector<FrameStats> frames;
+		frames.reserve(numFrames);
+		std::vector<sf::Event> events;
+		size_t inputIdx = 0;
+		sf::Clock clock;
+		auto renderThread = game.getRenderThread();
+
+		auto allocationCounterEnabled = AllocationCounter::Enabled();
+		AllocationCounter::Enabled(true);
+
+		for (unsigned frame = 0; frame < warmupFrames + numFrames; frame++)
+		{
+			events.clear();
+			if (replaying == true)
+			{
+				auto replayEvents = InputRecorder::nextFrame();
+				if (replayEvents == nullptr)
+				{
+					break;
+				}
+				events = *replayEvents;
+			}
+			while (inputIdx < input.size() &&
+				input[inputIdx].frame <= frame)
+			{
+				const auto& scriptInput = input[inputIdx];
+				events.insert(events.end(), scriptInput.events.begin(), scriptInput.events.end());
+				if (scriptInput.action != nullptr)
+				{
+					game.Events().addBack(scriptInput.action);
+				}
+				inputIdx++;
+			}
+
+			PROFILE_FRAME();
+			FrameArena::reset();
+
+			FrameStats stats;
+			auto allocations = AllocationCounter::get();
+			clock.restart();
+
+			game.processEvents(events);
+			game.Jobs().runMainThreadJobs();
+			if (renderThread != nullptr)
+			{
+				renderThread->wait();
+			}
+			game.updateFrame(InputRecorder::endFrame(frameTime));
+			stats.update = clock.restart().asMicroseconds();
+
+			game.drawFrame();
+			// includes the level surfaces drawn on the render thread
+			if (renderThread != nullptr)
+			{
+				renderThread->wait();
+			}
+			stats.draw = clock.restart().asMicroseconds();
+			stats.allocations = AllocationCounter::get() - allocations;
+			stats.arenaBytes = FrameArena::getUsed();
+
+			if (frame >= warmupFrames)
+			{
+				frames.push_back(stats);
+			}
+		}
+
+		AllocationCounter::Enabled(allocationCounterEnabled);
+		InputRecorder::stop();
+
+		return writeReport(outputFile, frames, seed, frameRate);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string_view>
+
+class Game;
+
+// runs a game without a window or audio for a fixed number of frames with
+// a fixed timestep and seed, replaying the input of a json script, and
+// writes the update/draw times and allocations of each frame as json
+// (allocations need a build with USE_ALLOCATION_COUNTER).
+// started with --bench <gamefiles> <script>.
+//
+// script:
+// {
+//   "seed": 1, "frameRate": 60, "frames": 600, "warmupFrames": 60,
+//   "output": "bench.json",
+//   "input": [
+//     { "frame": 10, "type": "click", "position": [320, 240] },
+//     { "frame": 20, "type": "keyPress", "key": "enter" },
+//     { "frame": 30, "type": "action", "action": { "name": "game.close" } }
+//   ]
+// }
+// input types: mouseMove, mousePress, mouseRelease, click, keyPress,
+// keyRelease, text and action. positions are in game coordinates.
+// "replay" replays a file recorded with --record-input (see InputRecorder),
+// using its seed and frame times. frames defaults to the recorded frames.
+//
+// gamefilesd/bench.json is a sample script: it starts a new game in town,
+// walks down to the first dungeon level and fights the monster there.
+namespace BenchRunner
+{
+	// returns false if the script can't be loaded or the report can't be written.
+	bool run(Game& game, const std::string_view gamefilePath, const std::string_view scriptFile);
+}
@@ -1,14 +1,58 @@
 #include "CmdLineUtils.h"
+#include <cstdio>
 #include "GameUtils.h"
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include "Game/LevelHelper.h"
 #endif
 #include "FileUtils.h"
+#include "FrameProfiler.h"
+#include "InputRecorder.h"
+#include "LoadProfiler.h"
 #include "Utils/Utils.h"
 
 namespace CmdLineUtils
 {
-	bool processCmdLine(int argc, const char* argv[])
+	int processOptions(int argc, char* argv[])
+	{
+		int newArgc = 0;
+		for (int i = 0; i < argc; i++)
+		{
+			auto option = Utils::splitStringIn2(std::string_view(argv[i]), ':');
+			switch (str2int16(option.first))
+			{
+			case str2int16("--profile-frames"):
+			{
+				FrameProfiler::enable(option.second.empty() == false ?
+					option.second : "frameprofile.json");
+				continue;
+			}
+			case str2int16("--profile-load"):
+			{
+				LoadProfiler::enable(option.second.empty() == false ?
+					option.second : "loadprofile.json");
+				continue;
+			}
+			case str2int16("--record-input"):
+			{
+				InputRecorder::record(option.second.empty() == false ?
+					option.second : "input.dgir");
+				continue;
+			}
+			case str2int16("--replay-input"):
+			{
+				InputRecorder::replay(option.second.empty() == false ?
+					option.second : "input.dgir");
+				continue;
+			}
+			default:
+				break;
+			}
+			argv[newArgc++] = argv[i];
+		}
+		return newArgc;
+	}
+
+	bool processCmdLine(int argc, const char* argv[], int& exitCode)
 	{
 		if (argc < 4)
 		{
@@ -28,6 +72,8 @@ namespace CmdLineUtils
 		}
 		if (numMountedFiles == 0)
 		{
+			std::fprintf(stderr, "can't mount %s\n", argv[2]);
+			exitCode = 1;
 			return true;
 		}
 
@@ -2,6 +2,15 @@
 
 namespace CmdLineUtils
 {
+	// processes and removes the engine options from argv. returns the new argc.
+	// --profile-frames[:traceFile] profiles the last frames (see FrameProfiler)
+	// --profile-load[:traceFile]   profiles file/element loading (see LoadProfiler)
+	// --record-input[:file]        records the input to file (see InputRecorder)
+	// --replay-input[:file]        replays a recorded input file instead of the live input
+	int processOptions(int argc, char* argv[]);
+
 	// returns true if any export command was found (reagrdless of success)
-	bool processCmdLine(int argc, const char* argv[]);
+	// exitCode is set to 1 if the command failed.
+	// (--bench <gamefiles> <script> is handled by BenchRunner)
+	bool processCmdLine(int argc, const char* argv[], int& exitCode);
 }
@@ -284,7 +284,7 @@ uint32_t CompositeTexture::getLayerCount(uint32_t groupIdx) const noexcept
 	return 0;
 }
 
-bool CompositeTexture::get(uint32_t index, std::vector<TextureInfo>& tiVec) const
+bool CompositeTexture::get(uint32_t index, FrameVector<TextureInfo>& tiVec) const
 {
 	tiVec.clear();
 
@@ -2,6 +2,7 @@
 
 #include <string_view>
 #include "TexturePacks/TexturePack.h"
+#include "Utils/FrameArena.h"
 #include <variant>
 #include <vector>
 
@@ -59,7 +60,7 @@ public:
 	uint32_t getLayerCount(uint32_t groupIdx) const noexcept;
 
 	// gets the textures in the correct drawing order
-	bool get(uint32_t index, std::vector<TextureInfo>& tiVec) const;
+	bool get(uint32_t index, FrameVector<TextureInfo>& tiVec) const;
 
 	// uses first texturePack of each group
 	std::pair<uint32_t, uint32_t> getRange(
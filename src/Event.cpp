@@ -16,6 +16,7 @@ bool Event::execute(Game& game)
 	if (elapsedTime.timeout == sf::Time::Zero ||
 		elapsedTime.update(game.getElapsedTime()) == true)
 	{
+		game.invalidate();
 		auto ret = action->execute(game);
 		if (ret == true || elapsedTime.timeout == sf::Time::Zero)
 		{
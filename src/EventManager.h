@@ -14,6 +14,8 @@ public:
 	void addBack(const std::shared_ptr<Action>& action) { events.push_back(action); }
 	void addFront(const std::shared_ptr<Action>& action) { events.push_front(action); }
 
+	size_t size() const noexcept { return events.size(); }
+
 	bool exists(const std::string_view id) const
 	{
 		if (id.empty() == false)
@@ -24,6 +24,7 @@ private:
 
 public:
 	const sf::Color& getColor() const noexcept { return color; }
+	bool isRunning() const noexcept { return running; }
 
 	void Reset(sf::Color color_, bool isFadeOut_, bool enableInput_, uint8_t fadeOffset_,
 		const sf::Time& timeout_, const std::shared_ptr<Action>& action_);
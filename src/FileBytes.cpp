@@ -0,0 +1,123 @@
+#include "FileBytes.h"
+#include "FileUtils.h"
+#include "LoadProfiler.h"
+#include "PhysFSStream.h"
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool FileBytes::map(const char* realPath) noexcept
+{
+#ifdef _WIN32
+	auto wideSize = MultiByteToWideChar(CP_UTF8, 0, realPath, -1, nullptr, 0);
+	if (wideSize <= 0)
+	{
+		return false;
+	}
+	std::vector<wchar_t> widePath(wideSize);
+	MultiByteToWideChar(CP_UTF8, 0, realPath, -1, widePath.data(), wideSize);
+
+	auto file = CreateFileW(widePath.data(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) == 0 ||
+		fileSize.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+	auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+	mappingHandle = mapping;
+	mappedData = (const uint8_t*)view;
+	mappedSize = (size_t)fileSize.QuadPart;
+	return true;
+#else
+	auto file = ::open(realPath, O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat fileStat;
+	if (::fstat(file, &fileStat) != 0 ||
+		fileStat.st_size <= 0)
+	{
+		::close(file);
+		return false;
+	}
+	auto view = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+	mappedData = (const uint8_t*)view;
+	mappedSize = (size_t)fileStat.st_size;
+	return true;
+#endif
+}
+
+void FileBytes::unmap() noexcept
+{
+	if (mappedData == nullptr)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(mappedData);
+	CloseHandle(mappingHandle);
+	mappingHandle = nullptr;
+#else
+	::munmap((void*)mappedData, mappedSize);
+#endif
+	mappedData = nullptr;
+	mappedSize = 0;
+}
+
+bool FileBytes::load(const char* fileName, bool allowMapping)
+{
+	unmap();
+	buffer.clear();
+
+	if (allowMapping == true)
+	{
+		auto realPath = FileUtils::getRealFilePath(fileName);
+		if (realPath.empty() == false &&
+			map(realPath.c_str()) == true)
+		{
+			LoadProfiler::addBytesRead(mappedSize);
+			return true;
+		}
+	}
+
+	sf::PhysFSStream file(fileName);
+	if (file.hasError() == true)
+	{
+		return false;
+	}
+	buffer.resize((size_t)file.getSize());
+	file.read(buffer.data(), file.getSize());
+	return true;
+}
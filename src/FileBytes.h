@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include "gsl/gsl"
+#include <vector>
+
+// read-only file contents.
+// files in folder mounts are memory-mapped, all others are read into memory.
+class FileBytes
+{
+private:
+	std::vector<uint8_t> buffer;
+	const uint8_t* mappedData{ nullptr };
+	size_t mappedSize{ 0 };
+#ifdef _WIN32
+	void* mappingHandle{ nullptr };
+#endif
+
+	bool map(const char* realPath) noexcept;
+	void unmap() noexcept;
+
+public:
+	FileBytes() noexcept {}
+	FileBytes(const char* fileName) { load(fileName); }
+	~FileBytes() { unmap(); }
+
+	FileBytes(const FileBytes&) = delete;
+	FileBytes& operator=(const FileBytes&) = delete;
+
+	// loads the file. memory-maps it if allowMapping is true and
+	// the file is in a folder mount (not inside an archive).
+	bool load(const char* fileName, bool allowMapping = true);
+
+	const uint8_t* data() const noexcept
+	{
+		return mappedData != nullptr ? mappedData : buffer.data();
+	}
+	size_t size() const noexcept
+	{
+		return mappedData != nullptr ? mappedSize : buffer.size();
+	}
+	bool empty() const noexcept { return size() == 0; }
+	bool isMapped() const noexcept { return mappedData != nullptr; }
+
+	const uint8_t& operator[](size_t index) const noexcept { return data()[index]; }
+
+	gsl::span<const uint8_t> span() const noexcept { return { data(), (std::ptrdiff_t)size() }; }
+};
@@ -0,0 +1,266 @@
+#include "FileIndex.h"
+#include <cctype>
+#include "Utils/Utils.h"
+
+std::string FileIndex::normalize(const std::string_view path, bool toLower) const
+{
+	std::string str;
+	str.reserve(path.size());
+	for (size_t i = 0; i < path.size(); i++)
+	{
+		auto ch = path[i];
+		if (ch == '\\')
+		{
+			ch = '/';
+		}
+		if (ch == '/')
+		{
+			// skip leading, trailing and repeated separators
+			if (str.empty() == true || str.back() == '/')
+			{
+				continue;
+			}
+		}
+		else if (ch == '.' && (str.empty() == true || str.back() == '/'))
+		{
+			// skip "./"
+			if (i + 1 == path.size() || path[i + 1] == '/' || path[i + 1] == '\\')
+			{
+				i++;
+				continue;
+			}
+		}
+		if (toLower == true)
+		{
+			ch = (char)std::tolower((unsigned char)ch);
+		}
+		str.push_back(ch);
+	}
+	if (str.empty() == false && str.back() == '/')
+	{
+		str.pop_back();
+	}
+	return str;
+}
+
+size_t FileIndex::getMountIndex(const char* realDir) const
+{
+	if (realDir != nullptr)
+	{
+		for (size_t i = 0; i < mounts.size(); i++)
+		{
+			if (mounts[i] == realDir)
+			{
+				return i;
+			}
+		}
+	}
+	return 0;
+}
+
+void FileIndex::indexDir(const std::string& dirPath, Entry& dirEntry)
+{
+	auto files = PHYSFS_enumerateFiles(dirPath.c_str());
+	if (files == nullptr)
+	{
+		return;
+	}
+	PHYSFS_Stat fileStat;
+	for (char** file = files; *file != nullptr; file++)
+	{
+		auto filePath = dirPath.empty() == true ? std::string(*file) : dirPath + '/' + *file;
+		if (PHYSFS_stat(filePath.c_str(), &fileStat) == 0)
+		{
+			continue;
+		}
+		auto& entry = entries[normalize(filePath)];
+		if (entry.path.empty() == false)
+		{
+			// case insensitive duplicate. first one wins.
+			continue;
+		}
+		if (caseInsensitive == false)
+		{
+			foldedPaths.insert(normalize(filePath, true));
+		}
+		entry.path = filePath;
+		entry.mountIndex = getMountIndex(PHYSFS_getRealDir(filePath.c_str()));
+		entry.type = fileStat.filetype;
+		dirEntry.children.push_back(&entry);
+
+		if (entry.isDirectory() == true)
+		{
+			indexDir(entry.path, entry);
+		}
+	}
+	PHYSFS_freeList(files);
+}
+
+void FileIndex::rebuild()
+{
+	entries.clear();
+	foldedPaths.clear();
+	mounts.clear();
+	complete = true;
+	dirty = false;
+
+	auto searchPath = PHYSFS_getSearchPath();
+	if (searchPath != nullptr)
+	{
+		for (char** dir = searchPath; *dir != nullptr; dir++)
+		{
+			mounts.push_back(*dir);
+			if (Utils::endsWith(Utils::toLower(*dir), ".mpq") == true)
+			{
+				complete = false;
+			}
+		}
+		PHYSFS_freeList(searchPath);
+	}
+	if (mounts.empty() == true)
+	{
+		mounts.push_back({});
+	}
+
+	// references to unordered_map elements aren't invalidated by rehashing.
+	auto& root = entries[std::string()];
+	root.type = PHYSFS_FILETYPE_DIRECTORY;
+	indexDir(std::string(), root);
+}
+
+const FileIndex::Entry* FileIndex::get(const std::string_view path) const
+{
+	auto it = entries.find(normalize(path));
+	if (it != entries.end())
+	{
+		return &it->second;
+	}
+	return nullptr;
+}
+
+bool FileIndex::needsFallback(const std::string_view path) const
+{
+	if (complete == false)
+	{
+		return true;
+	}
+	return (caseInsensitive == false &&
+		foldedPaths.find(normalize(path, true)) != foldedPaths.end());
+}
+
+void FileIndex::CaseInsensitive(bool caseInsensitive_) noexcept
+{
+	if (caseInsensitive != caseInsensitive_)
+	{
+		caseInsensitive = caseInsensitive_;
+		dirty = true;
+	}
+}
+
+void FileIndex::add(const std::string_view filePath, PHYSFS_FileType type)
+{
+	if (dirty == true)
+	{
+		return;
+	}
+	auto filePath2 = normalize(filePath, false);
+	auto path = normalize(filePath, caseInsensitive);
+	if (path.empty() == true ||
+		entries.find(path) != entries.end())
+	{
+		return;
+	}
+	auto realDir = PHYSFS_getRealDir(filePath2.c_str());
+	if (realDir == nullptr)
+	{
+		// the write dir isn't in the search path
+		return;
+	}
+	auto mountIndex = getMountIndex(realDir);
+
+	// add missing parent folders, then the file/folder
+	Entry* parent = &entries[std::string()];
+	size_t idx = 0;
+	while (true)
+	{
+		idx = path.find('/', idx);
+		auto isLast = (idx == std::string::npos);
+		auto subPath = isLast == true ? path : path.substr(0, idx);
+		auto& entry = entries[subPath];
+		if (entry.path.empty() == true)
+		{
+			entry.path = filePath2.substr(0, idx);
+			if (caseInsensitive == false)
+			{
+				foldedPaths.insert(normalize(entry.path, true));
+			}
+			entry.mountIndex = mountIndex;
+			entry.type = isLast == true ? type : PHYSFS_FILETYPE_DIRECTORY;
+			parent->children.push_back(&entry);
+		}
+		if (isLast == true)
+		{
+			break;
+		}
+		parent = &entry;
+		idx++;
+	}
+}
+
+const FileIndex::Entry* FileIndex::find(const std::string_view path)
+{
+	updateIfDirty();
+	lookups++;
+	return get(path);
+}
+
+bool FileIndex::exists(const std::string_view path)
+{
+	if (find(path) != nullptr)
+	{
+		return true;
+	}
+	if (needsFallback(path) == true)
+	{
+		return PHYSFS_exists(std::string(path).c_str()) != 0;
+	}
+	return false;
+}
+
+PHYSFS_File* FileIndex::openRead(const char* filePath)
+{
+	updateIfDirty();
+	opens++;
+	auto entry = get(filePath);
+	if (entry != nullptr)
+	{
+		return PHYSFS_openRead(entry->path.c_str());
+	}
+	if (needsFallback(filePath) == true)
+	{
+		return PHYSFS_openRead(filePath);
+	}
+	PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+	return nullptr;
+}
+
+FileIndex::Stats FileIndex::getStats()
+{
+	auto now = std::chrono::steady_clock::now();
+	std::chrono::duration<double> elapsed = now - prevStatsTime;
+	if (elapsed.count() >= 1.0)
+	{
+		lookupsPerSecond = (double)(lookups - prevLookups) / elapsed.count();
+		opensPerSecond = (double)(opens - prevOpens) / elapsed.count();
+		prevLookups = lookups;
+		prevOpens = opens;
+		prevStatsTime = now;
+	}
+	Stats stats;
+	stats.entries = entries.size();
+	stats.lookups = lookups;
+	stats.opens = opens;
+	stats.lookupsPerSecond = lookupsPerSecond;
+	stats.opensPerSecond = opensPerSecond;
+	return stats;
+}
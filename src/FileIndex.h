@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <physfs.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// hashed index of all the files and folders in the PhysFS search path.
+// the index is rebuilt on the first lookup after the search path changes.
+// lookups that miss only go to PhysFS if the index can't tell (see complete
+// and foldedPaths). main thread only: entries returned by find (and their
+// children) change when files are added or the search path changes.
+class FileIndex
+{
+public:
+	struct Entry
+	{
+		// path with the same case as the archive/folder entry.
+		std::string path;
+		// index of the archive/folder (in the search path) that owns the entry.
+		size_t mountIndex{ 0 };
+		PHYSFS_FileType type{ PHYSFS_FILETYPE_OTHER };
+		// files and folders (folders only).
+		std::vector<const Entry*> children;
+
+		std::string_view name() const noexcept
+		{
+			auto idx = path.rfind('/');
+			if (idx == std::string::npos)
+			{
+				return path;
+			}
+			return std::string_view(path).substr(idx + 1);
+		}
+
+		bool isDirectory() const noexcept { return type == PHYSFS_FILETYPE_DIRECTORY; }
+		bool isFile() const noexcept { return type == PHYSFS_FILETYPE_REGULAR; }
+	};
+
+	struct Stats
+	{
+		uint64_t entries{ 0 };
+		uint64_t lookups{ 0 };
+		uint64_t opens{ 0 };
+		double lookupsPerSecond{ 0.0 };
+		double opensPerSecond{ 0.0 };
+	};
+
+private:
+	// key is the normalized path (lower case if caseInsensitive is true).
+	std::unordered_map<std::string, Entry> entries;
+	// lower case paths of the entries (if caseInsensitive is false).
+	// lookups that miss, but differ only in case from an entry, fall back to
+	// PhysFS, which finds them in folder mounts on case insensitive filesystems.
+	std::unordered_set<std::string> foldedPaths;
+	std::vector<std::string> mounts;
+	bool caseInsensitive{ false };
+	bool dirty{ true };
+	// false if an archive in the search path can't be enumerated (mpq).
+	// in that case, lookups that miss fall back to PhysFS.
+	bool complete{ true };
+
+	uint64_t lookups{ 0 };
+	uint64_t opens{ 0 };
+	uint64_t prevLookups{ 0 };
+	uint64_t prevOpens{ 0 };
+	std::chrono::steady_clock::time_point prevStatsTime;
+	double lookupsPerSecond{ 0.0 };
+	double opensPerSecond{ 0.0 };
+
+	std::string normalize(const std::string_view path, bool toLower) const;
+	std::string normalize(const std::string_view path) const { return normalize(path, caseInsensitive); }
+	size_t getMountIndex(const char* realDir) const;
+
+	void indexDir(const std::string& dirPath, Entry& dirEntry);
+	void rebuild();
+	void updateIfDirty() { if (dirty == true) { rebuild(); } }
+
+	// doesn't update the lookup counter.
+	const Entry* get(const std::string_view path) const;
+
+	// true if a lookup that missed has to be checked with PhysFS.
+	bool needsFallback(const std::string_view path) const;
+
+public:
+	bool CaseInsensitive() const noexcept { return caseInsensitive; }
+	void CaseInsensitive(bool caseInsensitive_) noexcept;
+
+	// call when the search path or the files in the write dir change.
+	void invalidate() noexcept { dirty = true; }
+
+	// adds a newly written file or folder (and its parent folders)
+	// if it's in the search path.
+	void add(const std::string_view filePath,
+		PHYSFS_FileType type = PHYSFS_FILETYPE_REGULAR);
+
+	const Entry* find(const std::string_view path);
+
+	bool exists(const std::string_view path);
+
+	// opens a file for reading using the archive/folder's path case.
+	PHYSFS_File* openRead(const char* filePath);
+
+	// returns the archive/folder (in the search path) that owns the entry.
+	// entry pointers are valid until the next lookup after invalidate().
+	const std::string& getMount(const Entry& entry) const { return mounts[entry.mountIndex]; }
+
+	Stats getStats();
+};
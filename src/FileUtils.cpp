@@ -1,5 +1,6 @@
 #include "FileUtils.h"
 #include <cstring>
+#include "FileIndex.h"
 #include <filesystem>
 #include <memory>
 #include <fstream>
@@ -8,12 +9,16 @@
 
 namespace FileUtils
 {
+	static FileIndex fileIndex;
+	static size_t streamBufferSize{ 0x10000 };
+
 	void initPhysFS(const char* argv0)
 	{
 		static const char* mainArgv0 = argv0;
 		deinitPhysFS();
 		PHYSFS_init(mainArgv0);
 		PHYSFS_permitSymbolicLinks(1);
+		fileIndex.invalidate();
 	}
 
 	void deinitPhysFS()
@@ -65,6 +70,7 @@ namespace FileUtils
 	bool mount(const std::string_view file, const std::string_view mountPoint,
 		bool appendToSearchPath)
 	{
+		fileIndex.invalidate();
 		int append = appendToSearchPath == true ? 1 : 0;
 		try
 		{
@@ -104,6 +110,7 @@ namespace FileUtils
 
 	bool unmount(const std::string_view file)
 	{
+		fileIndex.invalidate();
 		if (PHYSFS_unmount(file.data()) != 0)
 		{
 			return true;
@@ -192,6 +199,7 @@ namespace FileUtils
 				}
 			}
 			PHYSFS_freeList(paths);
+			fileIndex.invalidate();
 			return true;
 		}
 		return false;
@@ -199,7 +207,16 @@ namespace FileUtils
 
 	bool createDir(const char* dirName) noexcept
 	{
-		return PHYSFS_mkdir(dirName) != 0;
+		if (PHYSFS_mkdir(dirName) != 0)
+		{
+			try
+			{
+				fileIndex.add(dirName, PHYSFS_FILETYPE_DIRECTORY);
+			}
+			catch (std::exception&) {}
+			return true;
+		}
+		return false;
 	}
 
 	bool deleteAll(const char* filePath, bool deleteRoot)
@@ -253,6 +270,7 @@ namespace FileUtils
 		{
 			ret = PHYSFS_delete(filePath) != 0;
 		}
+		fileIndex.invalidate();
 		return ret;
 	}
 
@@ -264,6 +282,7 @@ namespace FileUtils
 		{
 			if (strcmp(writeDir, realDir) == 0)
 			{
+				fileIndex.invalidate();
 				return PHYSFS_delete(filePath) != 0;
 			}
 		}
@@ -272,42 +291,107 @@ namespace FileUtils
 
 	bool exists(const char* filePath) noexcept
 	{
+		try
+		{
+			return fileIndex.exists(filePath);
+		}
+		catch (std::exception&) {}
 		return PHYSFS_exists(filePath) != 0;
 	}
 
+	PHYSFS_File* openRead(const char* filePath)
+	{
+		return fileIndex.openRead(filePath);
+	}
+
+	bool CaseInsensitivePaths() noexcept
+	{
+		return fileIndex.CaseInsensitive();
+	}
+
+	void CaseInsensitivePaths(bool caseInsensitive) noexcept
+	{
+		fileIndex.CaseInsensitive(caseInsensitive);
+	}
+
+	FileIndex::Stats getFileIndexStats()
+	{
+		return fileIndex.getStats();
+	}
+
+	std::string getRealFilePath(const char* filePath)
+	{
+		try
+		{
+			auto entry = fileIndex.find(filePath);
+			if (entry == nullptr ||
+				entry->isFile() == false)
+			{
+				return {};
+			}
+			const auto& mount = fileIndex.getMount(*entry);
+			std::filesystem::path mountPath(mount);
+			if (std::filesystem::is_directory(mountPath) == false)
+			{
+				return {};
+			}
+			std::string_view path(entry->path);
+			auto mountPoint = PHYSFS_getMountPoint(mount.c_str());
+			if (mountPoint != nullptr)
+			{
+				std::string_view mountPointStr(mountPoint);
+				while (mountPointStr.empty() == false && mountPointStr.front() == '/')
+				{
+					mountPointStr.remove_prefix(1);
+				}
+				if (mountPointStr.empty() == false)
+				{
+					if (path.substr(0, mountPointStr.size()) != mountPointStr)
+					{
+						return {};
+					}
+					path.remove_prefix(mountPointStr.size());
+				}
+			}
+			return (mountPath / std::filesystem::u8path(path)).u8string();
+		}
+		catch (std::exception&) {}
+		return {};
+	}
+
+	size_t StreamBufferSize() noexcept
+	{
+		return streamBufferSize;
+	}
+
+	void StreamBufferSize(size_t size) noexcept
+	{
+		streamBufferSize = size;
+	}
+
 	std::vector<std::string> getFileList(const std::string_view filePath,
 		const std::string_view fileExt, bool getFullPath)
 	{
 		std::vector<std::string> vec;
-		auto files = PHYSFS_enumerateFiles(filePath.data());
-		if (files != nullptr)
+		auto dirEntry = fileIndex.find(filePath);
+		if (dirEntry != nullptr)
 		{
-			PHYSFS_Stat fileStat;
-			for (char** file = files; *file != nullptr; file++)
+			for (const auto entry : dirEntry->children)
 			{
-				auto file2 = std::string(filePath) + '/' + std::string(*file);
-
-				if (Utils::endsWith(file2, fileExt) == false)
+				if (entry->isFile() == false ||
+					Utils::endsWith(entry->path, fileExt) == false)
 				{
 					continue;
 				}
-				if (PHYSFS_stat(file2.c_str(), &fileStat) == 0)
+				if (getFullPath == true)
 				{
-					continue;
+					vec.push_back(std::string(filePath) + '/' + std::string(entry->name()));
 				}
-				if (fileStat.filetype == PHYSFS_FILETYPE_REGULAR)
+				else
 				{
-					if (getFullPath == true)
-					{
-						vec.push_back(file2);
-					}
-					else
-					{
-						vec.push_back(std::string(*file));
-					}
+					vec.push_back(std::string(entry->name()));
 				}
 			}
-			PHYSFS_freeList(files);
 		}
 		return vec;
 	}
@@ -346,38 +430,27 @@ namespace FileUtils
 		const std::string_view rootPath)
 	{
 		std::vector<std::string> vecDirs;
-		auto dirs = PHYSFS_enumerateFiles(path.data());
-		if (dirs != nullptr)
+		auto dirEntry = fileIndex.find(path);
+		if (dirEntry != nullptr)
 		{
-			PHYSFS_Stat fileStat;
-			for (char** dir = dirs; *dir != nullptr; dir++)
+			for (const auto entry : dirEntry->children)
 			{
-				if (PHYSFS_stat(*dir, &fileStat) == 0)
+				if (entry->isDirectory() == false)
 				{
 					continue;
 				}
-				if (fileStat.filetype != PHYSFS_FILETYPE_DIRECTORY)
+				auto name = entry->name();
+				if (name.empty() == true || name[0] == '.')
 				{
 					continue;
 				}
-				if (**dir == '.')
+				if (rootPath.empty() == false &&
+					rootPath != fileIndex.getMount(*entry))
 				{
 					continue;
 				}
-				if (rootPath.empty() == false)
-				{
-					auto realDir = PHYSFS_getRealDir(*dir);
-					if (realDir != nullptr)
-					{
-						if (rootPath != realDir)
-						{
-							continue;
-						}
-					}
-				}
-				vecDirs.push_back(*dir);
+				vecDirs.push_back(std::string(name));
 			}
-			PHYSFS_freeList(dirs);
 		}
 		return vecDirs;
 	}
@@ -460,13 +533,92 @@ namespace FileUtils
 			if (file != nullptr)
 			{
 				PHYSFS_writeBytes(file, str.data(), str.size());
-				return PHYSFS_close(file) != 0;
+				auto success = PHYSFS_close(file) != 0;
+				fileIndex.add(filePath);
+				return success;
 			}
 		}
 		catch (std::exception&) {}
 		return false;
 	}
 
+	// same rules as PhysFS's platform independent paths: relative,
+	// '/' separated and without "." or ".." elements.
+	static bool isSafeWritePath(const std::string_view filePath) noexcept
+	{
+		if (filePath.empty() == true ||
+			filePath.front() == '/' ||
+			filePath.find_first_of(":\\") != std::string_view::npos)
+		{
+			return false;
+		}
+		size_t start = 0;
+		while (start <= filePath.size())
+		{
+			auto end = filePath.find('/', start);
+			if (end == std::string_view::npos)
+			{
+				end = filePath.size();
+			}
+			auto element = filePath.substr(start, end - start);
+			if (element == "." || element == "..")
+			{
+				return false;
+			}
+			start = end + 1;
+		}
+		return true;
+	}
+
+	bool saveTextAtomic(const std::string_view filePath, const std::string_view str) noexcept
+	{
+		if (isSafeWritePath(filePath) == false)
+		{
+			return false;
+		}
+		try
+		{
+			auto writeDir = PHYSFS_getWriteDir();
+			if (writeDir == nullptr)
+			{
+				return false;
+			}
+			std::string tmpFilePath(filePath);
+			tmpFilePath += ".tmp";
+			auto file = PHYSFS_openWrite(tmpFilePath.c_str());
+			if (file == nullptr)
+			{
+				return false;
+			}
+			auto written = PHYSFS_writeBytes(file, str.data(), str.size());
+			if (PHYSFS_close(file) != 0 &&
+				written == (PHYSFS_sint64)str.size())
+			{
+				// PhysFS can't rename files
+				auto path = std::filesystem::u8path(writeDir);
+				std::error_code ec;
+				std::filesystem::rename(path / std::filesystem::u8path(tmpFilePath),
+					path / std::filesystem::u8path(filePath), ec);
+				if (!ec)
+				{
+					return true;
+				}
+			}
+			PHYSFS_delete(tmpFilePath.c_str());
+		}
+		catch (std::exception&) {}
+		return false;
+	}
+
+	void addFile(const std::string_view filePath) noexcept
+	{
+		try
+		{
+			fileIndex.add(filePath);
+		}
+		catch (std::exception&) {}
+	}
+
 	bool exportFile(const char* inFile, const char* outFile)
 	{
 		try
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FileIndex.h"
 #include <string>
 #include <string_view>
 #include <vector>
@@ -33,8 +34,27 @@ namespace FileUtils
 
 	bool deleteFile(const char* filePath) noexcept;
 
+	// uses the file index (hashed lookup).
 	bool exists(const char* filePath) noexcept;
 
+	// opens a file for reading using the file index.
+	PHYSFS_File* openRead(const char* filePath);
+
+	// if true, file lookups ignore case.
+	bool CaseInsensitivePaths() noexcept;
+	void CaseInsensitivePaths(bool caseInsensitive) noexcept;
+
+	FileIndex::Stats getFileIndexStats();
+
+	// returns the file system path of a file in a folder mount.
+	// returns an empty string if the file is inside an archive.
+	std::string getRealFilePath(const char* filePath);
+
+	// read-ahead buffer size for streamed files (music, movies, sounds).
+	// 0 disables buffering.
+	size_t StreamBufferSize() noexcept;
+	void StreamBufferSize(size_t size) noexcept;
+
 	std::vector<std::string> getFileList(const std::string_view filePath,
 		const std::string_view fileExt, bool getFullPath);
 
@@ -60,6 +80,15 @@ namespace FileUtils
 	// creates path if it doesn't exist
 	bool saveText(const std::string_view filePath, const std::string_view str) noexcept;
 
+	// writes to filePath + ".tmp" and renames it to filePath, so filePath is never
+	// left half written. doesn't create the path or update the file index, so it
+	// can be called from worker threads (call addFile on the main thread after).
+	// absolute paths and paths with ".." are rejected.
+	bool saveTextAtomic(const std::string_view filePath, const std::string_view str) noexcept;
+
+	// adds a file written with saveTextAtomic to the file index.
+	void addFile(const std::string_view filePath) noexcept;
+
 	// writes file to a filesystem path (not to physfs's write dir path).
 	bool exportFile(const char* inFile, const char* outFile);
 }
@@ -0,0 +1,172 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include "Json/JsonParser.h"
+#include <string>
+#include <vector>
+
+namespace FrameProfiler
+{
+	struct Event
+	{
+		const char* name{ nullptr };
+		int64_t start{ 0 };
+		int64_t duration{ 0 };
+	};
+
+	struct Frame
+	{
+		uint64_t number{ 0 };
+		int64_t start{ 0 };
+		int64_t duration{ 0 };
+		// cleared when the frame is reused, keeping the allocated memory
+		std::vector<Event> events;
+	};
+
+	static std::string traceFile;
+	static std::chrono::steady_clock::time_point startTime;
+	static std::vector<Frame> frames;
+	static size_t currentFrame{ 0 };
+	static uint64_t frameNumber{ 0 };
+
+	static int64_t now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void enable(const std::string_view traceFile_, size_t frameCount)
+	{
+#ifndef NO_FRAME_PROFILER
+		traceFile = traceFile_;
+		startTime = std::chrono::steady_clock::now();
+		frames.clear();
+		frames.resize(std::max(frameCount, (size_t)1));
+		currentFrame = 0;
+		frameNumber = 0;
+		Impl::recording = true;
+		Impl::enabled = true;
+#endif
+	}
+
+	void beginFrame()
+	{
+		if (Impl::enabled == false)
+		{
+			return;
+		}
+		auto time = now();
+		if (frameNumber > 0)
+		{
+			auto& frame = frames[currentFrame];
+			frame.duration = time - frame.start;
+			currentFrame = (currentFrame + 1) % frames.size();
+		}
+		auto& frame = frames[currentFrame];
+		frame.number = ++frameNumber;
+		frame.start = time;
+		frame.duration = 0;
+		frame.events.clear();
+	}
+
+	size_t Impl::begin(const char* name)
+	{
+		if (frameNumber == 0)
+		{
+			return (size_t)-1;
+		}
+		auto& events = frames[currentFrame].events;
+		events.push_back({ name, now(), 0 });
+		return events.size() - 1;
+	}
+
+	void Impl::end(size_t eventIdx)
+	{
+		auto& events = frames[currentFrame].events;
+		if (eventIdx < events.size())
+		{
+			events[eventIdx].duration = now() - events[eventIdx].start;
+		}
+	}
+
+	// frame events (frameNumber > 0) have the frame number as argument.
+	static void writeEvent(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+		const char* name, int64_t start, int64_t duration, uint64_t frameNumber = 0)
+	{
+		writer.StartObject();
+		writer.Key("name");
+		writer.String(name);
+		writer.Key("cat");
+		writer.String("frame");
+		writer.Key("ph");
+		writer.String("X");
+		writer.Key("ts");
+		writer.Int64(start);
+		writer.Key("dur");
+		writer.Int64(duration);
+		writer.Key("pid");
+		writer.Int(1);
+		writer.Key("tid");
+		writer.Int(1);
+		if (frameNumber > 0)
+		{
+			writer.Key("args");
+			writer.StartObject();
+			writer.Key("frame");
+			writer.Uint64(frameNumber);
+			writer.EndObject();
+		}
+		writer.EndObject();
+	}
+
+	void dump()
+	{
+		if (Impl::enabled == false)
+		{
+			return;
+		}
+		dump(traceFile);
+	}
+
+	void dump(const std::string_view traceFile_)
+	{
+		if (Impl::enabled == false)
+		{
+			return;
+		}
+
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("traceEvents");
+		writer.StartArray();
+
+		// oldest frame first. the current frame is unfinished and skipped.
+		for (size_t i = 1; i <= frames.size(); i++)
+		{
+			const auto& frame = frames[(currentFrame + i) % frames.size()];
+			if (frame.number == 0 || frame.duration == 0)
+			{
+				continue;
+			}
+			writeEvent(writer, "Game::play", frame.start, frame.duration, frame.number);
+			for (const auto& event : frame.events)
+			{
+				writeEvent(writer, event.name, event.start, event.duration);
+			}
+		}
+
+		writer.EndArray();
+		writer.EndObject();
+
+		try
+		{
+			std::ofstream file(std::filesystem::u8path(traceFile_), std::ios::out | std::ios::binary);
+			file.write(buffer.GetString(), buffer.GetSize());
+		}
+		catch (std::exception&) {}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// records nested timed scopes of the main thread for the last frames
+// (a ring buffer) and writes them as a Chrome/Perfetto trace file.
+// enabled with the --profile-frames[:traceFile] command line option and
+// dumped at exit or with the game.dumpFrameProfile action.
+// when disabled, each scope costs a single branch. building with
+// NO_FRAME_PROFILER removes the scopes completely.
+namespace FrameProfiler
+{
+	namespace Impl
+	{
+		inline bool enabled{ false };
+		// only the thread that enabled the profiler records scopes
+		inline thread_local bool recording{ false };
+
+		size_t begin(const char* name);
+		void end(size_t eventIdx);
+	}
+
+	inline bool Enabled() noexcept { return Impl::enabled; }
+
+	constexpr size_t DefaultFrameCount = 300;
+
+	// traceFile is a filesystem path (not in PhysFS's write dir).
+	void enable(const std::string_view traceFile, size_t frameCount = DefaultFrameCount);
+
+	// ends the current frame and starts the next one.
+	void beginFrame();
+
+	// writes the recorded frames to the trace file given in enable.
+	void dump();
+
+	// writes the recorded frames to traceFile.
+	void dump(const std::string_view traceFile);
+
+	class Scope
+	{
+	private:
+		size_t eventIdx{ (size_t)-1 };
+
+	public:
+		// name must be a string literal (it isn't copied).
+		Scope(const char* name)
+		{
+			if (Impl::enabled == true && Impl::recording == true)
+			{
+				eventIdx = Impl::begin(name);
+			}
+		}
+		~Scope()
+		{
+			if (eventIdx != (size_t)-1)
+			{
+				Impl::end(eventIdx);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+}
+
+#ifdef NO_FRAME_PROFILER
+#define PROFILE_FRAME()
+#define PROFILE_SCOPE(name)
+#else
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_FRAME() FrameProfiler::beginFrame()
+#define PROFILE_SCOPE(name) FrameProfiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
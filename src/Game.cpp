@@ -1,17 +1,23 @@
 #include "Game.h"
 #include "Button.h"
 #include "FileUtils.h"
+#include "FrameProfiler.h"
 #include "Game/Formula.h"
 #include "Game/Level.h"
 #include "Image.h"
+#include "InputRecorder.h"
 #include "Json/JsonUtils.h"
 #include "Parser/Parser.h"
+#include "PerfCounters.h"
 #include "SFML/SFMLUtils.h"
+#include "Utils/FrameArena.h"
 #include "Utils/ReverseIterable.h"
 #include "Utils/Utils.h"
 
 Game::~Game()
 {
+	jobSystem.stop();
+	renderThread.stop();
 	resourceManager = {};
 	if (window.isOpen() == true)
 	{
@@ -65,6 +71,13 @@ void Game::reset()
 
 	elapsedTime = {};
 	totalElapsedTime = {};
+	simulationTick = {};
+	simulationTime = {};
+	interpolation = { 1.f };
+	inputProcessed = { true };
+	skipIdleFrames = { false };
+	frameDirty = { true };
+	useRenderThread = { false };
 
 	path = {};
 	title = {};
@@ -86,6 +99,8 @@ void Game::load(const std::string_view gamefilePath, const std::string_view main
 	{
 		window.close();
 	}
+	jobSystem.stop();
+	renderThread.stop();
 	reset();
 	FileUtils::unmountAll();
 	Parser::parseGame(*this, gamefilePath, mainFile);
@@ -97,6 +112,16 @@ void Game::init()
 	{
 		return;
 	}
+	if (headless == true)
+	{
+		updateGameWindowSize();
+		if (gameSprite.getTexture() == nullptr)
+		{
+			recreateRenderTexture(gameTexture);
+			gameSprite.setTexture(gameTexture.getTexture(), true);
+		}
+		return;
+	}
 
 #ifdef __ANDROID__
 	window.create(sf::VideoMode::getDesktopMode(), title);
@@ -208,90 +233,357 @@ void Game::play()
 
 	while (window.isOpen() == true)
 	{
+		PROFILE_FRAME();
+		FrameArena::reset();
+
 		processEvents();
 
-		window.clear();
-		gameTexture.clear();
+		jobSystem.runMainThreadJobs();
+
+		auto frameTime = frameClock.restart();
+		PerfCounters::endFrame(frameTime.asMicroseconds());
+		frameTime = InputRecorder::endFrame(frameTime);
+
+		updateFrame(frameTime);
+
+		if (loadingScreen == nullptr &&
+			isIdleFrame() == true)
+		{
+			// the window keeps showing the last drawn frame
+			sf::sleep(getIdleFrameTime());
+			continue;
+		}
+
+		drawFrame();
+	}
+}
 
-		elapsedTime = frameClock.restart();
+void Game::updateFrame(sf::Time frameTime)
+{
+	if (simulationTick == sf::Time::Zero ||
+		loadingScreen != nullptr)
+	{
+		elapsedTime = frameTime;
 		totalElapsedTime += elapsedTime;
 
 		updateEvents();
 
 		resourceManager.clearFinishedSounds();
 
-		if (drawLoadingScreen() == false)
+		if (loadingScreen == nullptr)
+		{
+			update();
+		}
+		inputProcessed = true;
+	}
+	else
+	{
+		updateSimulation(frameTime);
+
+		resourceManager.clearFinishedSounds();
+
+		// the cursor and the fade are updated per frame
+		elapsedTime = frameTime;
+
+		if (loadingScreen == nullptr)
+		{
+			if (auto level = resourceManager.getCurrentLevel())
+			{
+				level->interpolate(*this, interpolation);
+			}
+		}
+	}
+
+	if (loadingScreen == nullptr)
+	{
+		updateCursor();
+	}
+}
+
+void Game::drawFrame()
+{
+	frameDirty = false;
+
+	if (headless == false)
+	{
+		window.clear();
+	}
+	gameTexture.clear();
+
+	if (drawLoadingScreen() == false)
+	{
+		drawUI();
+		drawCursor();
+		drawWindow();
+	}
+}
+
+bool Game::isIdleFrame() const noexcept
+{
+	return skipIdleFrames == true &&
+		frameDirty == false &&
+		fadeObj.isRunning() == false;
+}
+
+sf::Time Game::getIdleFrameTime() const noexcept
+{
+	if (framerate > 0)
+	{
+		return sf::microseconds(1000000 / (sf::Int64)framerate);
+	}
+	return sf::milliseconds(10);
+}
+
+void Game::updateSimulation(sf::Time frameTime)
+{
+	// avoids a long catch up after a stall (loading, dragging the window)
+	simulationTime += std::min(frameTime, simulationTick * (float)MaxSimulationTicksPerFrame);
+
+	unsigned ticks = 0;
+	while (simulationTime >= simulationTick &&
+		ticks < MaxSimulationTicksPerFrame)
+	{
+		elapsedTime = simulationTick;
+		totalElapsedTime += elapsedTime;
+
+		updateEvents();
+		update();
+
+		inputProcessed = true;
+		simulationTime -= simulationTick;
+		ticks++;
+
+		// a tick can start loading a new game
+		if (loadingScreen != nullptr)
 		{
-			drawAndUpdate();
-			drawCursor();
-			drawWindow();
+			simulationTime = sf::Time::Zero;
+			break;
 		}
 	}
+	if (simulationTime >= simulationTick)
+	{
+		simulationTime %= simulationTick;
+	}
+	interpolation = std::clamp(simulationTime / simulationTick, 0.f, 1.f);
+}
+
+unsigned Game::SimulationRate() const noexcept
+{
+	if (simulationTick == sf::Time::Zero)
+	{
+		return 0;
+	}
+	return (unsigned)std::round(1.f / simulationTick.asSeconds());
+}
+
+void Game::SimulationRate(unsigned ticksPerSecond) noexcept
+{
+	if (ticksPerSecond == 0)
+	{
+		simulationTick = sf::Time::Zero;
+	}
+	else
+	{
+		simulationTick = sf::microseconds(1000000 / (sf::Int64)ticksPerSecond);
+	}
+	simulationTime = sf::Time::Zero;
+	interpolation = 1.f;
+}
+
+void Game::clearProcessedInput() noexcept
+{
+	// with a fixed tick, frames without ticks keep the events for the next tick
+	if (inputProcessed == true)
+	{
+		mousePressed = false;
+		mouseReleased = false;
+		mouseMoved = false;
+		mouseScrolled = false;
+		keyPressed = false;
+		textEntered = false;
+		inputProcessed = false;
+	}
 }
 
 void Game::processEvents()
 {
-	mousePressed = false;
-	mouseReleased = false;
-	mouseMoved = false;
-	mouseScrolled = false;
-	keyPressed = false;
-	textEntered = false;
+	if (InputRecorder::isReplaying() == true)
+	{
+		processReplayEvents();
+		return;
+	}
+
+	PROFILE_SCOPE("Game::processEvents");
+
+	clearProcessedInput();
 
 	sf::Event evt;
 	while (window.pollEvent(evt))
 	{
-		switch (evt.type)
+		if (InputRecorder::isRecording() == true)
 		{
-		case sf::Event::Closed:
-			onClosed();
-			break;
-		case sf::Event::Resized:
-			onResized(evt.size);
-			break;
-		case sf::Event::LostFocus:
-			onLostFocus();
-			break;
-		case sf::Event::GainedFocus:
-			onGainedFocus();
-			break;
-		case sf::Event::TextEntered:
-			onTextEntered(evt.text);
-			break;
-		case sf::Event::KeyPressed:
-			onKeyPressed(evt);
-			break;
-		case sf::Event::KeyReleased:
-			onKeyReleased(evt);
-			break;
-		case sf::Event::MouseWheelScrolled:
-			onMouseWheelScrolled(evt.mouseWheelScroll);
-			break;
-		case sf::Event::MouseButtonPressed:
-			onMouseButtonPressed(evt.mouseButton);
-			break;
-		case sf::Event::MouseButtonReleased:
-			onMouseButtonReleased(evt.mouseButton);
-			break;
-		case sf::Event::MouseMoved:
-			onMouseMoved(evt.mouseMove);
-			break;
-		case sf::Event::TouchBegan:
-			onTouchBegan(evt.touch);
-			break;
-		case sf::Event::TouchMoved:
-			onTouchMoved(evt.touch);
-			break;
-		case sf::Event::TouchEnded:
-			onTouchEnded(evt.touch);
-			break;
-		default:
-			break;
+			InputRecorder::addEvent(toGameCoordinates(evt));
 		}
+		processEvent(evt);
 	}
 	resourceManager.processCompositeInputEvents(*this);
 }
 
+void Game::processReplayEvents()
+{
+	// live input is ignored, except for closing the window
+	bool closed = false;
+	sf::Event evt;
+	while (window.pollEvent(evt))
+	{
+		if (evt.type == sf::Event::Closed)
+		{
+			closed = true;
+		}
+	}
+
+	auto events = InputRecorder::nextFrame();
+	if (events != nullptr)
+	{
+		processEvents(*events);
+	}
+	else
+	{
+		// the replay ended
+		processEvents(std::vector<sf::Event>());
+		closed = true;
+	}
+
+	if (closed == true)
+	{
+		onClosed();
+	}
+}
+
+sf::Event Game::toGameCoordinates(sf::Event evt) const
+{
+	if (headless == true)
+	{
+		return evt;
+	}
+	auto toGameCoords = [this](int& x, int& y)
+	{
+		auto coords = window.mapPixelToCoords(sf::Vector2i(x, y));
+		x = (int)std::round(coords.x);
+		y = (int)std::round(coords.y);
+	};
+	switch (evt.type)
+	{
+	case sf::Event::MouseWheelMoved:
+		toGameCoords(evt.mouseWheel.x, evt.mouseWheel.y);
+		break;
+	case sf::Event::MouseWheelScrolled:
+		toGameCoords(evt.mouseWheelScroll.x, evt.mouseWheelScroll.y);
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		toGameCoords(evt.mouseButton.x, evt.mouseButton.y);
+		break;
+	case sf::Event::MouseMoved:
+		toGameCoords(evt.mouseMove.x, evt.mouseMove.y);
+		break;
+	case sf::Event::TouchBegan:
+	case sf::Event::TouchMoved:
+	case sf::Event::TouchEnded:
+		toGameCoords(evt.touch.x, evt.touch.y);
+		break;
+	default:
+		break;
+	}
+	return evt;
+}
+
+void Game::processEvents(const std::vector<sf::Event>& events)
+{
+	PROFILE_SCOPE("Game::processEvents");
+
+	clearProcessedInput();
+
+	for (const auto& evt : events)
+	{
+		// button presses use the current mouse position, which is only
+		// updated by the events without a window or when replaying
+		if (hasGameCoordinateInput() == true)
+		{
+			switch (evt.type)
+			{
+			case sf::Event::MouseButtonPressed:
+			case sf::Event::MouseButtonReleased:
+				updateMousePosition(sf::Vector2i(evt.mouseButton.x, evt.mouseButton.y));
+				break;
+			case sf::Event::MouseWheelScrolled:
+				updateMousePosition(sf::Vector2i(evt.mouseWheelScroll.x, evt.mouseWheelScroll.y));
+				break;
+			case sf::Event::TouchBegan:
+			case sf::Event::TouchEnded:
+				updateMousePosition(sf::Vector2i(evt.touch.x, evt.touch.y));
+				break;
+			default:
+				break;
+			}
+		}
+		processEvent(evt);
+	}
+	resourceManager.processCompositeInputEvents(*this);
+}
+
+void Game::processEvent(const sf::Event& evt)
+{
+	frameDirty = true;
+	switch (evt.type)
+	{
+	case sf::Event::Closed:
+		onClosed();
+		break;
+	case sf::Event::Resized:
+		onResized(evt.size);
+		break;
+	case sf::Event::LostFocus:
+		onLostFocus();
+		break;
+	case sf::Event::GainedFocus:
+		onGainedFocus();
+		break;
+	case sf::Event::TextEntered:
+		onTextEntered(evt.text);
+		break;
+	case sf::Event::KeyPressed:
+		onKeyPressed(evt);
+		break;
+	case sf::Event::KeyReleased:
+		onKeyReleased(evt);
+		break;
+	case sf::Event::MouseWheelScrolled:
+		onMouseWheelScrolled(evt.mouseWheelScroll);
+		break;
+	case sf::Event::MouseButtonPressed:
+		onMouseButtonPressed(evt.mouseButton);
+		break;
+	case sf::Event::MouseButtonReleased:
+		onMouseButtonReleased(evt.mouseButton);
+		break;
+	case sf::Event::MouseMoved:
+		onMouseMoved(evt.mouseMove);
+		break;
+	case sf::Event::TouchBegan:
+		onTouchBegan(evt.touch);
+		break;
+	case sf::Event::TouchMoved:
+		onTouchMoved(evt.touch);
+		break;
+	case sf::Event::TouchEnded:
+		onTouchEnded(evt.touch);
+		break;
+	default:
+		break;
+	}
+}
+
 void Game::onClosed()
 {
 	window.close();
@@ -375,8 +667,11 @@ void Game::updateGameWindowSize()
 	}
 
 	// clears artefacts
-	window.clear();
-	window.display();
+	if (window.isOpen() == true)
+	{
+		window.clear();
+		window.display();
+	}
 
 	// update game texture
 	recreateRenderTexture(gameTexture);
@@ -557,19 +852,42 @@ void Game::onTouchEnded(const sf::Event::TouchEvent& evt)
 
 void Game::setMousePosition(sf::Vector2i mousePos)
 {
+	if (hasGameCoordinateInput() == true)
+	{
+		updateMousePosition(mousePos);
+		return;
+	}
 	mousePos = window.mapCoordsToPixel({ (float)mousePos.x , (float)mousePos.y });
 	sf::Mouse::setPosition(mousePos, window);
 	updateMousePosition();
 }
 
+bool Game::hasGameCoordinateInput() const noexcept
+{
+	return headless == true || InputRecorder::isReplaying() == true;
+}
+
 void Game::updateMousePosition()
 {
+	if (hasGameCoordinateInput() == true)
+	{
+		updateMousePosition(mousePositioni);
+		return;
+	}
 	updateMousePosition(sf::Mouse::getPosition(window));
 }
 
 void Game::updateMousePosition(const sf::Vector2i mousePos)
 {
-	mousePositionf = window.mapPixelToCoords(mousePos);
+	// without a window or when replaying, positions are in game coordinates
+	if (hasGameCoordinateInput() == true)
+	{
+		mousePositionf = sf::Vector2f(mousePos);
+	}
+	else
+	{
+		mousePositionf = window.mapPixelToCoords(mousePos);
+	}
 	mousePositionf.x = std::round(mousePositionf.x);
 	mousePositionf.y = std::round(mousePositionf.y);
 	mousePositioni.x = (int)mousePositionf.x;
@@ -588,9 +906,16 @@ void Game::updateCursorPosition()
 
 void Game::updateEvents()
 {
+	PROFILE_SCOPE("Game::updateEvents");
+
 	if (paused == false)
 	{
+		auto numEvents = eventManager.size();
 		eventManager.update(*this);
+		if (eventManager.size() != numEvents)
+		{
+			frameDirty = true;
+		}
 	}
 }
 
@@ -607,6 +932,8 @@ bool Game::drawLoadingScreen()
 
 void Game::update()
 {
+	PROFILE_SCOPE("Game::update");
+
 	for (auto& res : reverse(resourceManager))
 	{
 		if (((int)res.ignore & (int)IgnoreResource::Update) == 0)
@@ -628,6 +955,8 @@ void Game::update()
 
 void Game::drawUI()
 {
+	PROFILE_SCOPE("Game::drawUI");
+
 	for (auto& res : resourceManager)
 	{
 		if (((int)res.ignore & (int)IgnoreResource::Draw) == 0)
@@ -644,10 +973,13 @@ void Game::drawUI()
 	}
 }
 
-void Game::drawAndUpdate()
+void Game::updateCursor()
 {
-	update();
-	drawUI();
+	auto cursor = resourceManager.getCursor();
+	if (cursor != nullptr)
+	{
+		cursor->update(*this);
+	}
 }
 
 void Game::drawCursor()
@@ -655,7 +987,6 @@ void Game::drawCursor()
 	auto cursor = resourceManager.getCursor();
 	if (cursor != nullptr)
 	{
-		cursor->update(*this);
 		cursor->draw(*this, gameTexture);
 	}
 }
@@ -688,6 +1019,10 @@ void Game::drawWindow()
 		));
 	}
 	fadeObj.update(*this);
+	if (headless == true)
+	{
+		return;
+	}
 	window.draw(gameSprite, states);
 	window.display();
 }
@@ -695,6 +1030,7 @@ void Game::drawWindow()
 void Game::draw()
 {
 	drawUI();
+	updateCursor();
 	drawCursor();
 	drawWindow();
 }
@@ -1110,6 +1446,64 @@ bool Game::getProperty(const std::string_view prop, Variable& var) const
 	return getGameProperty(props.second, var);
 }
 
+bool Game::getPerfProperty(const std::string_view prop, Variable& var) const
+{
+	auto props = Utils::splitStringIn2(prop, '.');
+	switch (str2int16(props.first))
+	{
+	case str2int16("allocations"):
+		var = Variable((int64_t)PerfCounters::getAllocations());
+		break;
+	case str2int16("drawCalls"):
+		var = Variable((int64_t)PerfCounters::get(PerfCounters::Counter::DrawCalls));
+		break;
+	case str2int16("events"):
+		var = Variable((int64_t)eventManager.size());
+		break;
+	case str2int16("fps"):
+		var = Variable(PerfCounters::getFPS());
+		break;
+	case str2int16("frameTime"):
+	{
+		// frameTime.99 is the 99th percentile. the default is the median.
+		auto percentile = props.second.empty() == false ?
+			Utils::strtod(props.second) : 50.0;
+		var = Variable(PerfCounters::getFrameTime(percentile));
+		break;
+	}
+	case str2int16("levelObjects"):
+	{
+		auto level = resourceManager.getCurrentLevel();
+		var = Variable((int64_t)(level != nullptr ? level->getLevelObjectCount() : 0));
+		break;
+	}
+	case str2int16("levelObjectUpdates"):
+		var = Variable((int64_t)PerfCounters::get(PerfCounters::Counter::LevelObjectUpdates));
+		break;
+	case str2int16("pathSearches"):
+		var = Variable((int64_t)PerfCounters::get(PerfCounters::Counter::PathSearches));
+		break;
+	case str2int16("pendingLights"):
+	{
+		auto level = resourceManager.getCurrentLevel();
+		var = Variable((int64_t)(level != nullptr ? level->Map().getPendingLightCount() : 0));
+		break;
+	}
+	case str2int16("resourceMemory"):
+		var = Variable((int64_t)resourceManager.getTextureMemory(props.second));
+		break;
+	case str2int16("textureBinds"):
+		var = Variable((int64_t)PerfCounters::get(PerfCounters::Counter::TextureBinds));
+		break;
+	case str2int16("uniformUpdates"):
+		var = Variable((int64_t)PerfCounters::get(PerfCounters::Counter::UniformUpdates));
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
 bool Game::getGameProperty(const std::string_view prop, Variable& var) const
 {
 	auto props = Utils::splitStringIn2(prop, '.');
@@ -1127,6 +1521,31 @@ bool Game::getGameProperty(const std::string_view prop, Variable& var) const
 		}
 		break;
 	}
+	case str2int16("fileIndex"):
+	{
+		auto stats = FileUtils::getFileIndexStats();
+		switch (str2int16(props.second))
+		{
+		case str2int16("entries"):
+			var = Variable((int64_t)stats.entries);
+			break;
+		case str2int16("lookups"):
+			var = Variable((int64_t)stats.lookups);
+			break;
+		case str2int16("lookupsPerSecond"):
+			var = Variable(stats.lookupsPerSecond);
+			break;
+		case str2int16("opens"):
+			var = Variable((int64_t)stats.opens);
+			break;
+		case str2int16("opensPerSecond"):
+			var = Variable(stats.opensPerSecond);
+			break;
+		default:
+			return false;
+		}
+		break;
+	}
 	case str2int16("framerate"):
 		var = Variable((int64_t)framerate);
 		break;
@@ -1232,6 +1651,8 @@ bool Game::getGameProperty(const std::string_view prop, Variable& var) const
 	case str2int16("path"):
 		var = Variable(path);
 		break;
+	case str2int16("perf"):
+		return getPerfProperty(props.second, var);
 	case str2int16("refSize"):
 	{
 		if (props.second == "x")
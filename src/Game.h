@@ -3,8 +3,10 @@
 #include "EventManager.h"
 #include "FadeInOut.h"
 #include "InputEvent.h"
+#include "JobSystem.h"
 #include "LoadingScreen.h"
 #include "Queryable.h"
+#include "RenderThread.h"
 #include "ResourceManager.h"
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -77,10 +79,33 @@ private:
 	sf::Time elapsedTime;
 	sf::Time totalElapsedTime;
 
+	// fixed simulation tick (zero updates once per frame).
+	sf::Time simulationTick;
+	// simulation time not yet run
+	sf::Time simulationTime;
+	// position between the last two ticks (for drawing)
+	float interpolation;
+	// input events are kept until a simulation tick handles them
+	bool inputProcessed;
+
+	// skips drawing frames where nothing changed
+	bool skipIdleFrames;
+	bool frameDirty;
+
+	// no window (benchmarks). kept across loads.
+	bool headless{ false };
+
+	// max ticks run per frame. the rest is dropped (the game slows down).
+	static constexpr unsigned MaxSimulationTicksPerFrame = 5;
+
 	std::string path;
 	std::string title;
 	std::string version;
 
+	// declared before the resources, so levels can wait for it when destroyed
+	mutable RenderThread renderThread;
+	bool useRenderThread;
+
 	ResourceManager resourceManager;
 	EventManager eventManager;
 
@@ -91,7 +116,16 @@ private:
 
 	GameShaders shaders;
 
+	JobSystem jobSystem;
+
+	void clearProcessedInput() noexcept;
 	void processEvents();
+	void processReplayEvents();
+	void processEvent(const sf::Event& evt);
+	// converts the window positions of the event to game coordinates (for recordings).
+	sf::Event toGameCoordinates(sf::Event evt) const;
+	bool hasGameCoordinateInput() const noexcept;
+	void updateSimulation(sf::Time frameTime);
 	void onClosed();
 	void onResized(const sf::Event::SizeEvent& evt);
 	void onLostFocus() noexcept;
@@ -110,10 +144,12 @@ private:
 
 	void updateMousePosition(const sf::Vector2i mousePos);
 	void updateEvents();
+	void updateCursor();
 	void drawCursor();
 	void drawUI();
 	void update();
-	void drawAndUpdate();
+	bool isIdleFrame() const noexcept;
+	sf::Time getIdleFrameTime() const noexcept;
 	void drawWindow();
 
 	void updateGameWindowSize();
@@ -225,6 +261,28 @@ public:
 	const sf::Time& getElapsedTime() const noexcept { return elapsedTime; }
 	const sf::Time& getTotalElapsedTime() const noexcept { return totalElapsedTime; }
 
+	// simulation ticks per second (0 updates once per frame with the frame's elapsed time).
+	unsigned SimulationRate() const noexcept;
+	void SimulationRate(unsigned ticksPerSecond) noexcept;
+	float getInterpolation() const noexcept { return interpolation; }
+
+	// when enabled, frames are only drawn after input, events, fades or a call to invalidate.
+	bool SkipIdleFrames() const noexcept { return skipIdleFrames; }
+	void SkipIdleFrames(bool skip) noexcept
+	{
+		skipIdleFrames = skip;
+		frameDirty = true;
+	}
+
+	// marks the current frame as changed. drawables call it when they
+	// change without input (animations, movies, text, levels).
+	void invalidate() noexcept { frameDirty = true; }
+
+	// when enabled, init doesn't create a window and frames are only drawn
+	// to the game texture. input comes from processEvents(events).
+	bool isHeadless() const noexcept { return headless; }
+	void Headless(bool headless_) noexcept { headless = headless_; }
+
 	const std::string& getPath() const noexcept { return path; }
 	const std::string& getTitle() const noexcept { return title; }
 	const std::string& getVersion() const noexcept { return version; }
@@ -235,6 +293,14 @@ public:
 	ResourceManager& Resources() noexcept { return resourceManager; }
 	const ResourceManager& Resources() const noexcept { return resourceManager; }
 	EventManager& Events() noexcept { return eventManager; }
+	JobSystem& Jobs() noexcept { return jobSystem; }
+
+	// level surfaces are rendered on the render thread when enabled.
+	RenderThread* getRenderThread() const noexcept
+	{
+		return useRenderThread == true ? &renderThread : nullptr;
+	}
+	void UseRenderThread(bool use) noexcept { useRenderThread = use; }
 
 	void close() { window.close(); }
 	void setIcon(unsigned int width, unsigned int height, const sf::Uint8* pixels)
@@ -264,6 +330,13 @@ public:
 
 	void play();
 
+	// one iteration of play without polling the window or sleeping.
+	void updateFrame(sf::Time frameTime);
+	void drawFrame();
+
+	// handles the given events instead of the window's.
+	void processEvents(const std::vector<sf::Event>& events);
+
 	const std::unordered_map<std::string, Variable>& getVariables() const noexcept { return variables; }
 
 	// gets variable without tokens. ex: "var"
@@ -316,6 +389,8 @@ public:
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
 	bool getGameProperty(const std::string_view prop, Variable& var) const;
+	// game.perf.* (see PerfCounters)
+	bool getPerfProperty(const std::string_view prop, Variable& var) const;
 	void setGameProperty(const std::string_view prop, const Variable& val);
 
 	virtual const Queryable* getQueryable(const std::string_view prop) const;
@@ -1,72 +1,212 @@
 #include "Classifier.h"
+#include <algorithm>
+#include "Utils/Utils.h"
 
-Variable Classifier::get(const Queryable& obj, uint16_t skipFirst) const
+Classifier::Classifier(std::vector<ClassifierValueInterval> values)
 {
-	Variable returnVar;
-	bool hasResult = false;
-	for (const auto& classVal : classifierValues)
+	intervals.reserve(values.size());
+	for (auto& interval : values)
 	{
-		bool hasValue = false;
-		Variable value;
-		if (classVal.property.empty() == true)
+		intervals.push_back(compile(interval));
+	}
+}
+
+Classifier::CompiledInterval Classifier::compile(ClassifierValueInterval& interval)
+{
+	CompiledInterval compiled;
+	compiled.property = std::move(interval.property);
+
+	auto pos = compiled.property.find('.');
+	compiled.propHash = str2int16(std::string_view(compiled.property).substr(0, pos));
+	compiled.propsPos = pos != std::string::npos ? pos + 1 : compiled.property.size();
+
+	// each min and max + 1 starts a new range
+	compiled.rangeStarts.push_back(std::numeric_limits<int64_t>::min());
+	for (uint32_t i = 0; i < (uint32_t)interval.values.size(); i++)
+	{
+		auto& classVal = interval.values[i];
+		if (std::holds_alternative<ClassifierValue::ValuePair>(classVal.compare) == true)
 		{
-			hasValue = true;
+			const auto& minMax = std::get<ClassifierValue::ValuePair>(classVal.compare);
+			if (minMax.first <= minMax.second)
+			{
+				compiled.rangeStarts.push_back(minMax.first);
+				compiled.rangeStarts.push_back((int64_t)minMax.second + 1);
+			}
 		}
-		else if (obj.getProperty(classVal.property, value) == true)
+		else
 		{
-			hasValue = true;
+			compiled.textValues.push_back(
+				std::make_pair(std::get<std::string>(classVal.compare), i));
 		}
-		if (hasValue == true)
+		compiled.values.push_back(std::move(classVal.value));
+	}
+	std::sort(compiled.rangeStarts.begin(), compiled.rangeStarts.end());
+	compiled.rangeStarts.erase(
+		std::unique(compiled.rangeStarts.begin(), compiled.rangeStarts.end()),
+		compiled.rangeStarts.end());
+
+	// value of each range (first one that contains it), merging equal neighbours
+	std::vector<int64_t> rangeStarts;
+	for (auto start : compiled.rangeStarts)
+	{
+		auto value = NoValue;
+		for (uint32_t i = 0; i < (uint32_t)interval.values.size(); i++)
 		{
-			for (const auto& itemElem : classVal.values)
+			const auto& compare = interval.values[i].compare;
+			if (std::holds_alternative<ClassifierValue::ValuePair>(compare) == true)
 			{
-				bool compareResult = false;
-
-				if (std::holds_alternative<ClassifierValue::ValuePair>(itemElem.compare) == true)
-				{
-					const auto& minMax = std::get<ClassifierValue::ValuePair>(itemElem.compare);
-					LevelObjValue intVal = 0;
-					if (std::holds_alternative<int64_t>(value) == true)
-					{
-						intVal = (LevelObjValue)std::get<int64_t>(value);
-					}
-					else if (std::holds_alternative<bool>(value) == true)
-					{
-						intVal = (LevelObjValue)std::get<bool>(value);
-					}
-					if (intVal >= minMax.first && intVal <= minMax.second)
-					{
-						compareResult = true;
-					}
-				}
-				else
-				{
-					const auto& str = std::get<std::string>(value);
-					if (std::holds_alternative<std::string>(itemElem.compare) == true &&
-						std::get<std::string>(itemElem.compare) == str)
-					{
-						compareResult = true;
-					}
-				}
-				if (compareResult == true)
+				const auto& minMax = std::get<ClassifierValue::ValuePair>(compare);
+				if (start >= minMax.first && start <= minMax.second)
 				{
-					if (skipFirst > 0)
-					{
-						skipFirst--;
-					}
-					else
-					{
-						returnVar = itemElem.value;
-						hasResult = true;
-					}
+					value = i;
 					break;
 				}
 			}
-			if (hasResult == true)
+		}
+		if (compiled.rangeValues.empty() == true ||
+			compiled.rangeValues.back() != value)
+		{
+			rangeStarts.push_back(start);
+			compiled.rangeValues.push_back(value);
+		}
+	}
+	compiled.rangeStarts = std::move(rangeStarts);
+
+	if (compiled.rangeStarts.size() > 2 &&
+		compiled.rangeStarts.back() - compiled.rangeStarts[1] <= MaxDirectIndexSize)
+	{
+		auto minValue = compiled.rangeStarts[1];
+		compiled.directValues.resize((size_t)(compiled.rangeStarts.back() - minValue));
+		for (size_t i = 1; i < compiled.rangeStarts.size() - 1; i++)
+		{
+			std::fill(compiled.directValues.begin() + (compiled.rangeStarts[i] - minValue),
+				compiled.directValues.begin() + (compiled.rangeStarts[i + 1] - minValue),
+				compiled.rangeValues[i]);
+		}
+	}
+	compiled.zeroValue = compiled.findInt(0);
+
+	// stable, so the first value of each text is kept
+	std::stable_sort(compiled.textValues.begin(), compiled.textValues.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+	compiled.textValues.erase(
+		std::unique(compiled.textValues.begin(), compiled.textValues.end(),
+			[](const auto& a, const auto& b) { return a.first == b.first; }),
+		compiled.textValues.end());
+
+	return compiled;
+}
+
+uint32_t Classifier::CompiledInterval::findInt(int64_t value) const noexcept
+{
+	if (directValues.empty() == false)
+	{
+		if (value < rangeStarts[1])
+		{
+			return rangeValues.front();
+		}
+		if (value >= rangeStarts.back())
+		{
+			return rangeValues.back();
+		}
+		return directValues[(size_t)(value - rangeStarts[1])];
+	}
+	auto it = std::upper_bound(rangeStarts.begin(), rangeStarts.end(), value);
+	return rangeValues[(it - rangeStarts.begin()) - 1];
+}
+
+uint32_t Classifier::CompiledInterval::find(const Variable& value) const
+{
+	if (std::holds_alternative<std::string>(value) == true)
+	{
+		const auto& str = std::get<std::string>(value);
+		auto it = std::lower_bound(textValues.begin(), textValues.end(), str,
+			[](const auto& a, const std::string& b) { return a.first < b; });
+		if (it != textValues.end() && it->first == str)
+		{
+			return std::min(zeroValue, it->second);
+		}
+		return zeroValue;
+	}
+	LevelObjValue intVal = 0;
+	if (std::holds_alternative<int64_t>(value) == true)
+	{
+		intVal = (LevelObjValue)std::get<int64_t>(value);
+	}
+	else if (std::holds_alternative<bool>(value) == true)
+	{
+		intVal = (LevelObjValue)std::get<bool>(value);
+	}
+	return findInt(intVal);
+}
+
+bool Classifier::getIntervalValue(const CompiledInterval& interval,
+	const Queryable& obj, uint16_t& skipFirst, Variable& returnVar)
+{
+	Variable value;
+	if (interval.property.empty() == false)
+	{
+		auto props = std::string_view(interval.property).substr(interval.propsPos);
+		if (obj.getPropertyByHash(interval.property, interval.propHash, props, value) == false)
+		{
+			return false;
+		}
+	}
+	auto idx = interval.find(value);
+	if (idx == NoValue)
+	{
+		return false;
+	}
+	if (skipFirst > 0)
+	{
+		skipFirst--;
+		return false;
+	}
+	returnVar = interval.values[idx];
+	return true;
+}
+
+Variable Classifier::get(const Queryable& obj, uint16_t skipFirst) const
+{
+	Variable returnVar;
+	for (const auto& interval : intervals)
+	{
+		if (getIntervalValue(interval, obj, skipFirst, returnVar) == true)
+		{
+			break;
+		}
+	}
+	return returnVar;
+}
+
+void Classifier::get(const std::vector<const Queryable*>& objs,
+	std::vector<Variable>& vars, uint16_t skipFirst) const
+{
+	vars.assign(objs.size(), {});
+
+	// objects without a value and the matches they still have to skip
+	std::vector<std::pair<size_t, uint16_t>> pending;
+	pending.reserve(objs.size());
+	for (size_t i = 0; i < objs.size(); i++)
+	{
+		pending.push_back(std::make_pair(i, skipFirst));
+	}
+	for (const auto& interval : intervals)
+	{
+		if (pending.empty() == true)
+		{
+			break;
+		}
+		size_t numPending = 0;
+		for (auto& obj : pending)
+		{
+			if (getIntervalValue(interval, *objs[obj.first], obj.second, vars[obj.first]) == true)
 			{
-				break;
+				continue;
 			}
+			pending[numPending++] = obj;
 		}
+		pending.resize(numPending);
 	}
-	return returnVar;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameProperties.h"
+#include <limits>
 #include "Queryable.h"
 #include <string>
 #include <vector>
@@ -23,11 +24,53 @@ struct ClassifierValueInterval
 class Classifier
 {
 private:
-	std::vector<ClassifierValueInterval> classifierValues;
+	static constexpr uint32_t NoValue = std::numeric_limits<uint32_t>::max();
+
+	// max number of integers in the domain of the ranges to index directly.
+	static constexpr int64_t MaxDirectIndexSize = 256;
+
+	// an interval compiled into lookup tables. a lookup returns the index
+	// of the first value that matches (or NoValue), like a linear scan would.
+	struct CompiledInterval
+	{
+		std::string property;
+		// hash of the property up to the first '.' and the position of the rest
+		uint16_t propHash{ 0 };
+		size_t propsPos{ 0 };
+
+		std::vector<Variable> values;
+
+		// the ranges split into consecutive ranges, sorted by start.
+		// rangeStarts[0] is the min value.
+		std::vector<int64_t> rangeStarts;
+		std::vector<uint32_t> rangeValues;
+		// values for rangeStarts[1] to rangeStarts.back() - 1, if it's a small domain.
+		std::vector<uint32_t> directValues;
+		// strings are compared with the ranges as 0
+		uint32_t zeroValue{ NoValue };
+		// sorted by text, first value of each text
+		std::vector<std::pair<std::string, uint32_t>> textValues;
+
+		uint32_t findInt(int64_t value) const noexcept;
+		uint32_t find(const Variable& value) const;
+	};
+
+	std::vector<CompiledInterval> intervals;
+
+	static CompiledInterval compile(ClassifierValueInterval& interval);
+
+	// gets the value of obj from interval. returns true and sets returnVar
+	// if a value matches and there are no more matches to skip.
+	static bool getIntervalValue(const CompiledInterval& interval,
+		const Queryable& obj, uint16_t& skipFirst, Variable& returnVar);
 
 public:
-	Classifier(std::vector<ClassifierValueInterval> values) noexcept
-		: classifierValues(std::move(values)) {}
+	Classifier(std::vector<ClassifierValueInterval> values);
 
 	Variable get(const Queryable& obj, uint16_t skipFirst = 0) const;
+
+	// gets the value of each object (same as get). each interval is checked
+	// for all the objects without a value before moving to the next one.
+	void get(const std::vector<const Queryable*>& objs,
+		std::vector<Variable>& vars, uint16_t skipFirst = 0) const;
 };
@@ -28,6 +28,23 @@ public:
 		return true;
 	}
 
+	// gets the values of the objects. returns false if there's no classifier.
+	bool getVars(size_t idx, const std::vector<const Queryable*>& objs,
+		std::vector<Variable>& vars) const
+	{
+		if (idx >= classifiers.size())
+		{
+			return false;
+		}
+		auto classifier = classifiers[idx].first;
+		if (classifier == nullptr)
+		{
+			return false;
+		}
+		classifier->get(objs, vars, classifiers[idx].second);
+		return true;
+	}
+
 	template <class T>
 	T getNumber(size_t idx, const Queryable& obj) const
 	{
@@ -63,6 +80,27 @@ public:
 		return true;
 	}
 
+	// gets the texts of the objects. returns false if there's no classifier.
+	bool getTexts(size_t idx, const std::vector<const Queryable*>& objs,
+		std::vector<std::string>& texts, bool replaceVars = true) const
+	{
+		std::vector<Variable> vars;
+		if (getVars(idx, objs, vars) == false)
+		{
+			return false;
+		}
+		texts.resize(objs.size());
+		for (size_t i = 0; i < objs.size(); i++)
+		{
+			texts[i] = VarUtils::toString(vars[i]);
+			if (replaceVars == true && texts[i].empty() == false)
+			{
+				texts[i] = GameUtils::replaceStringWithQueryable(texts[i], *objs[i]);
+			}
+		}
+		return true;
+	}
+
 	void set(size_t idx, Classifier* classifier, uint16_t skipFirst)
 	{
 		if (idx >= classifiers.size())
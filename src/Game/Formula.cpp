@@ -5,6 +5,7 @@
 #include <cstdlib>
 #endif
 #include <cmath>
+#include "FrameProfiler.h"
 #include "Utils/Utils.h"
 
 Formula::FormulaIterator::FormulaIterator(const std::string_view formula_,
@@ -337,6 +338,8 @@ void Formula::skipTokens(FormulaElementIterator& it)
 double Formula::eval(FormulaElementIterator& it, const Queryable* queryA,
 	const Queryable* queryB, int32_t randomNum)
 {
+	PROFILE_SCOPE("Formula::eval");
+
 	double val = 0.0;
 	FormulaOp currUnaryOp = FormulaOp::None;
 	FormulaOp currBinaryOp = FormulaOp::Add;
@@ -628,6 +631,17 @@ double Formula::eval(const Queryable& query, int32_t randomNum) const
 	return eval(it, &query, &query, randomNum);
 }
 
+void Formula::eval(const std::vector<const Queryable*>& queries,
+	std::vector<double>& values, int32_t randomNum) const
+{
+	values.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		FormulaElementIterator it(elements);
+		values[i] = eval(it, queries[i], queries[i], randomNum);
+	}
+}
+
 double Formula::eval(int32_t randomNum) const
 {
 	FormulaElementIterator it(elements);
@@ -145,6 +145,10 @@ public:
 	double eval(const Queryable& queryA, const Queryable& queryB,
 		int32_t randomNum = 0) const;
 
+	// evaluates the formula for each query (values[i] is the result of queries[i]).
+	void eval(const std::vector<const Queryable*>& queries,
+		std::vector<double>& values, int32_t randomNum = 0) const;
+
 	// minMaxNum - string_view with random number to use
 	// minMaxNum > 0 -> use given number (ex: :rnd(10) = randomNum)
 	// minMaxNum = 0 -> disabled (ex: :rnd(10) = 0-9)
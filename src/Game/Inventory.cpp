@@ -1,4 +1,5 @@
 #include "Inventory.h"
+#include <algorithm>
 #include "Game/GameHashes.h"
 #include "Utils/Utils.h"
 
@@ -16,8 +17,10 @@ void Inventory::init(size_t size_)
 {
 	uint8_t newSize = (size_ > 0xFF ? 0xFF : (uint8_t)size_);
 	size = PairUInt8(newSize, 1);
+	releaseItems();
 	items.resize(newSize);
 	resetIndexes();
+	rebuildIndex();
 }
 
 void Inventory::init(const PairUInt8& size_)
@@ -31,8 +34,10 @@ void Inventory::init(const PairUInt8& size_)
 	{
 		size = size_;
 	}
+	releaseItems();
 	items.resize(size.x * size.y);
 	resetIndexes();
+	rebuildIndex();
 }
 
 void Inventory::resetIndexes() noexcept
@@ -43,17 +48,112 @@ void Inventory::resetIndexes() noexcept
 	}
 }
 
-bool Inventory::empty() const noexcept
+void Inventory::unindexSlot(size_t idx)
 {
-	for (const auto& item : items)
+	const auto& item = items[idx];
+	if (item.first != nullptr)
 	{
-		if (item.first != nullptr ||
-			item.second >= 0)
+		auto it = classSlots.find(item.first->Class()->IdHash16());
+		if (it != classSlots.end())
 		{
-			return false;
+			auto& index = it->second;
+			auto& slots = index.slots;
+			auto slotIt = std::lower_bound(slots.begin(), slots.end(), (uint16_t)idx);
+			if (slotIt != slots.end() && *slotIt == (uint16_t)idx)
+			{
+				slots.erase(slotIt);
+				LevelObjValue quantity;
+				if (item.first->getIntByHash(ItemProp::Quantity, quantity) == true)
+				{
+					index.quantity -= quantity;
+					index.quantityItems--;
+				}
+			}
+			if (slots.empty() == true)
+			{
+				classSlots.erase(it);
+			}
+		}
+		item.first->inventory = nullptr;
+	}
+	if (isSlotFree(idx) == true)
+	{
+		auto bit = getSlotBit(idx);
+		freeSlots[bit / 64] &= ~((uint64_t)1 << (bit % 64));
+		freeSlotCount--;
+	}
+}
+
+void Inventory::indexSlot(size_t idx)
+{
+	const auto& item = items[idx];
+	if (item.first != nullptr)
+	{
+		auto& index = classSlots[item.first->Class()->IdHash16()];
+		auto& slots = index.slots;
+		auto slotIt = std::lower_bound(slots.begin(), slots.end(), (uint16_t)idx);
+		if (slotIt == slots.end() || *slotIt != (uint16_t)idx)
+		{
+			slots.insert(slotIt, (uint16_t)idx);
+			LevelObjValue quantity;
+			if (item.first->getIntByHash(ItemProp::Quantity, quantity) == true)
+			{
+				index.quantity += quantity;
+				index.quantityItems++;
+			}
+		}
+		item.first->inventory = this;
+	}
+	else if (item.second < 0 && isSlotFree(idx) == false)
+	{
+		auto bit = getSlotBit(idx);
+		freeSlots[bit / 64] |= ((uint64_t)1 << (bit % 64));
+		freeSlotCount++;
+	}
+}
+
+void Inventory::releaseItems() noexcept
+{
+	for (auto& item : items)
+	{
+		if (item.first != nullptr &&
+			item.first->inventory == this)
+		{
+			item.first->inventory = nullptr;
 		}
 	}
-	return true;
+}
+
+void Inventory::updateQuantity(const Item& item, bool hadQuantity,
+	LevelObjValue oldQuantity, LevelObjValue newQuantity) noexcept
+{
+	auto it = classSlots.find(item.Class()->IdHash16());
+	if (it == classSlots.end())
+	{
+		return;
+	}
+	auto& index = it->second;
+	if (hadQuantity == true)
+	{
+		index.quantity -= oldQuantity;
+	}
+	else
+	{
+		index.quantityItems++;
+	}
+	index.quantity += newQuantity;
+}
+
+void Inventory::rebuildIndex()
+{
+	classSlots.clear();
+	rowWords = ((size_t)size.x + 63) / 64;
+	freeSlots.assign(rowWords * size.y, 0);
+	freeSlotCount = 0;
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		indexSlot(i);
+	}
 }
 
 void Inventory::allowType(const std::string_view type)
@@ -170,9 +270,11 @@ bool Inventory::setAndDontEnforceItemSize(size_t idx, std::shared_ptr<Item>& ite
 	{
 		item->clearMapPosition();
 	}
+	unindexSlot(idx);
 	oldItem = std::move(items[idx].first);
 	items[idx].first = std::move(item);
 	items[idx].second = -1;
+	indexSlot(idx);
 
 	LevelObjValue transferedQuantity;
 	if (updateQuantities(itemPtr, oldItem.get(), transferedQuantity) == true)
@@ -215,41 +317,55 @@ bool Inventory::setAndEnforceItemSize(const PairUInt8& position,
 	}
 	Item* itemPtr = item.get();
 	Item* oldItemPtr = nullptr;
-	for (size_t i = pos.x; i < posEndX; i++)
+	size_t oldIdx = 0;
+	if (isRectFree(pos.x, pos.y, posEndX - pos.x, posEndY - pos.y) == false)
 	{
-		for (size_t j = pos.y; j < posEndY; j++)
+		for (size_t i = pos.x; i < posEndX; i++)
 		{
-			const auto& item2 = get(i, j);
-			if (item2 != nullptr)
+			for (size_t j = pos.y; j < posEndY; j++)
 			{
-				if (oldItemPtr == nullptr)
-				{
-					oldItemPtr = item2;
-				}
-				else if (oldItemPtr != item2)
+				auto idx = getIndex(i, j);
+				const auto& item2 = get(idx);
+				if (item2 != nullptr)
 				{
-					return false;
+					if (oldItemPtr == nullptr)
+					{
+						oldItemPtr = item2;
+						oldIdx = items[idx].second >= 0 ? (size_t)items[idx].second : idx;
+					}
+					else if (oldItemPtr != item2)
+					{
+						return false;
+					}
 				}
 			}
 		}
 	}
 	if (oldItemPtr != nullptr)
 	{
-		int32_t oldIdx = -1;
-		for (size_t i = 0; i < items.size(); i++)
+		// the old item only uses the slots of its size, starting at oldIdx.
+		const auto& oldItemSize = oldItemPtr->Class()->InventorySize();
+		auto oldPosX = oldIdx % size.x;
+		auto oldPosY = oldIdx / size.x;
+		auto oldEndX = std::min(oldPosX + oldItemSize.x, (size_t)size.x);
+		auto oldEndY = std::min(oldPosY + oldItemSize.y, (size_t)size.y);
+		for (size_t j = oldPosY; j < oldEndY; j++)
 		{
-			if (oldIdx >= 0)
+			for (size_t i = oldPosX; i < oldEndX; i++)
 			{
-				if (items[i].second == oldIdx)
+				auto idx = getIndex(i, j);
+				if (idx == oldIdx)
 				{
-					items[i].second = -1;
+					unindexSlot(idx);
+					oldItem = std::move(items[idx].first);
+					indexSlot(idx);
+				}
+				else if (items[idx].second == (int32_t)oldIdx)
+				{
+					unindexSlot(idx);
+					items[idx].second = -1;
+					indexSlot(idx);
 				}
-				continue;
-			}
-			if (items[i].first.get() == oldItemPtr)
-			{
-				oldIdx = (int32_t)i;
-				oldItem = std::move(items[i].first);
 			}
 		}
 	}
@@ -264,9 +380,11 @@ bool Inventory::setAndEnforceItemSize(const PairUInt8& position,
 		for (size_t j = pos.y; j < posEndY; j++)
 		{
 			size_t idx = i + j * size.x;
+			unindexSlot(idx);
 			if (newIdx >= 0)
 			{
 				items[idx].second = newIdx;
+				indexSlot(idx);
 				continue;
 			}
 			if (item != nullptr)
@@ -275,6 +393,7 @@ bool Inventory::setAndEnforceItemSize(const PairUInt8& position,
 			}
 			items[idx].first = std::move(item);
 			items[idx].second = -1;
+			indexSlot(idx);
 			newIdx = (int32_t)idx;
 		}
 	}
@@ -288,19 +407,6 @@ bool Inventory::setAndEnforceItemSize(const PairUInt8& position,
 	return true;
 }
 
-bool Inventory::isFull() const noexcept
-{
-	for (const auto& item : items)
-	{
-		if (item.first == nullptr &&
-			item.second < 0)
-		{
-			return false;
-		}
-	}
-	return true;
-}
-
 bool Inventory::isSlotInUse(size_t idx) const
 {
 	if (idx >= items.size())
@@ -319,37 +425,64 @@ bool Inventory::isSlotInUse(const PairUInt8& position) const
 	return isSlotInUse(position.x + position.y * size.x);
 }
 
-bool Inventory::isSlotEmpty(int x, int y,
-	const PairUInt8& itemSize, size_t& itemIdx) const
+bool Inventory::isRectFree(size_t x, size_t y, size_t width, size_t height) const noexcept
 {
-	size_t sizeX = (size_t)x;
-	size_t sizeY = (size_t)y;
-	if (enforceItemSize == true)
+	if (width == 0 || height == 0)
 	{
-		sizeX += itemSize.x;
-		sizeY += itemSize.y;
-	}
-	else
-	{
-		sizeX++;
-		sizeY++;
+		return true;
 	}
-	for (size_t i = x; i < sizeX; i++)
+	auto firstWord = x / 64;
+	auto lastWord = (x + width - 1) / 64;
+	for (size_t j = y; j < y + height; j++)
 	{
-		for (size_t j = y; j < sizeY; j++)
+		const auto* row = &freeSlots[j * rowWords];
+		for (auto w = firstWord; w <= lastWord; w++)
 		{
-			size_t idx = i + j * size.x;
-			if (items[idx].first != nullptr ||
-				items[idx].second >= 0)
+			// bits of [x, x + width) in word w
+			auto start = (w == firstWord ? x % 64 : 0);
+			auto end = (w == lastWord ? (x + width - 1) % 64 + 1 : 64);
+			auto mask = (end == 64 ? ~(uint64_t)0 : ((uint64_t)1 << end) - 1);
+			mask &= ~(((uint64_t)1 << start) - 1);
+			if ((row[w] & mask) != mask)
 			{
 				return false;
 			}
 		}
 	}
-	itemIdx = (size_t)(x + y * (int)size.x);
 	return true;
 }
 
+void Inventory::getFreeRuns(size_t y, size_t width, uint64_t* runs) const noexcept
+{
+	const auto* row = &freeSlots[y * rowWords];
+	std::copy(row, row + rowWords, runs);
+
+	// runs has the starts of free runs of len slots.
+	// runs &= runs >> shift extends them to len + shift (shift <= len).
+	size_t len = 1;
+	while (len < width)
+	{
+		auto shift = std::min(len, width - len);
+		auto wordShift = shift / 64;
+		auto bitShift = shift % 64;
+		for (size_t i = 0; i < rowWords; i++)
+		{
+			uint64_t shifted = 0;
+			auto src = i + wordShift;
+			if (src < rowWords)
+			{
+				shifted = runs[src] >> bitShift;
+				if (bitShift != 0 && src + 1 < rowWords)
+				{
+					shifted |= runs[src + 1] << (64 - bitShift);
+				}
+			}
+			runs[i] &= shifted;
+		}
+		len += shift;
+	}
+}
+
 bool Inventory::getFreeSlot(const Item& item,
 	size_t& itemIdx, InventoryPosition invPos) const
 {
@@ -358,75 +491,82 @@ bool Inventory::getFreeSlot(const Item& item,
 		return false;
 	}
 
-	const auto& itemSize = item.Class()->InventorySize();
+	// classes without an inventory size use 1x1 (the parser's default)
+	auto itemSize = item.Class()->InventorySize();
+	itemSize.x = std::max(itemSize.x, (uint8_t)1);
+	itemSize.y = std::max(itemSize.y, (uint8_t)1);
 
-	if (itemSize.x > size.x || itemSize.y > size.y)
+	if (items.empty() == true ||
+		itemSize.x > size.x || itemSize.y > size.y)
 	{
 		return false;
 	}
 
-	int sizeX = (int)size.x - (int)itemSize.x;
-	int sizeY = (int)size.y - (int)itemSize.y;
-
-	switch (invPos)
+	// without enforcing the item size, items only use their top left slot.
+	size_t width = 1;
+	size_t height = 1;
+	if (enforceItemSize == true)
 	{
-	default:
-	case InventoryPosition::TopLeft:
+		width = itemSize.x;
+		height = itemSize.y;
+	}
+	size_t maxX = (size_t)(size.x - itemSize.x);
+	size_t maxY = (size_t)(size.y - itemSize.y);
+	bool fromTop = (invPos != InventoryPosition::BottomLeft &&
+		invPos != InventoryPosition::BottomRight);
+	bool fromLeft = (invPos != InventoryPosition::TopRight &&
+		invPos != InventoryPosition::BottomRight);
+
+	// ignore the positions after maxX
+	auto lastWord = maxX / 64;
+	auto lastWordMask = (maxX % 64 == 63 ?
+		~(uint64_t)0 : ((uint64_t)1 << (maxX % 64 + 1)) - 1);
+
+	for (size_t n = 0; n <= maxY; n++)
 	{
-		for (int y = 0; y <= sizeY; y++)
+		auto y = (fromTop == true ? n : maxY - n);
+
+		// positions in row y where the item fits
+		uint64_t fits[MaxRowWords];
+		getFreeRuns(y, width, fits);
+		for (size_t j = y + 1; j < y + height; j++)
 		{
-			for (int x = 0; x <= sizeX; x++)
+			uint64_t runs[MaxRowWords];
+			getFreeRuns(j, width, runs);
+			for (size_t i = 0; i <= lastWord; i++)
 			{
-				if (isSlotEmpty(x, y, itemSize, itemIdx) == true)
-				{
-					return true;
-				}
+				fits[i] &= runs[i];
 			}
 		}
-		break;
-	}
-	case InventoryPosition::TopRight:
-	{
-		for (int y = 0; y <= sizeY; y++)
+		fits[lastWord] &= lastWordMask;
+
+		for (size_t i = 0; i <= lastWord; i++)
 		{
-			for (int x = sizeX; x >= 0; x--)
+			auto w = (fromLeft == true ? i : lastWord - i);
+			auto word = fits[w];
+			if (word == 0)
 			{
-				if (isSlotEmpty(x, y, itemSize, itemIdx) == true)
-				{
-					return true;
-				}
+				continue;
 			}
-		}
-		break;
-	}
-	case InventoryPosition::BottomLeft:
-	{
-		for (int y = sizeY; y >= 0; y--)
-		{
-			for (int x = 0; x <= sizeX; x++)
+			size_t bit = 0;
+			if (fromLeft == true)
 			{
-				if (isSlotEmpty(x, y, itemSize, itemIdx) == true)
+				while ((word & ((uint64_t)1 << bit)) == 0)
 				{
-					return true;
+					bit++;
 				}
 			}
-		}
-		break;
-	}
-	case InventoryPosition::BottomRight:
-	{
-		for (int y = sizeY; y >= 0; y--)
-		{
-			for (int x = sizeX; x >= 0; x--)
+			else
 			{
-				if (isSlotEmpty(x, y, itemSize, itemIdx) == true)
+				bit = 63;
+				while ((word & ((uint64_t)1 << bit)) == 0)
 				{
-					return true;
+					bit--;
 				}
 			}
+			itemIdx = getIndex(w * 64 + bit, y);
+			return true;
 		}
-		break;
-	}
 	}
 	return false;
 }
@@ -437,34 +577,19 @@ bool Inventory::hasFreeSlot(const Item& item) const
 	return getFreeSlot(item, itemIdx, InventoryPosition::TopLeft);
 }
 
-bool Inventory::hasItem(uint16_t classIdHash16) const
-{
-	for (const auto& item : (*this))
-	{
-		if (item.Class()->IdHash16() == classIdHash16)
-		{
-			return true;
-		}
-	}
-	return false;
-}
-
 bool Inventory::findByClass(uint16_t classIdHash16, size_t& idx, Item*& item) const
 {
 	auto size = items.size();
-	if (idx < size)
+	auto it = classSlots.find(classIdHash16);
+	if (idx < size && it != classSlots.end())
 	{
-		for (size_t i = idx; i < size; i++)
+		const auto& slots = it->second.slots;
+		auto slotIt = std::lower_bound(slots.begin(), slots.end(), idx);
+		if (slotIt != slots.end())
 		{
-			if (isSlotInUse(i) == true)
-			{
-				if (items[i].first->Class()->IdHash16() == classIdHash16)
-				{
-					idx = i;
-					item = items[i].first.get();
-					return true;
-				}
-			}
+			idx = *slotIt;
+			item = items[idx].first.get();
+			return true;
 		}
 	}
 	idx = size;
@@ -475,25 +600,22 @@ uint32_t Inventory::findFreeQuantity(
 	uint16_t classIdHash16, size_t& idx, Item*& itemFound) const
 {
 	auto size = items.size();
-	if (idx < size)
-	{
-		for (size_t i = idx; i < size; i++)
-		{
-			if (isSlotInUse(i) == true)
+	auto it = classSlots.find(classIdHash16);
+	if (idx < size && it != classSlots.end())
+	{
+		const auto& slots = it->second.slots;
+		for (auto slotIt = std::lower_bound(slots.begin(), slots.end(), idx);
+			slotIt != slots.end(); ++slotIt)
+		{
+			auto itemPtr = items[*slotIt].first.get();
+			auto itemQuantity = itemPtr->getIntByHash(ItemProp::Quantity);
+			auto itemCapacity = itemPtr->getIntByHash(ItemProp::Capacity);
+			if (itemQuantity < itemCapacity &&
+				itemCapacity > 0)
 			{
-				if (items[i].first->Class()->IdHash16() == classIdHash16)
-				{
-					auto itemPtr = items[i].first.get();
-					auto itemQuantity = itemPtr->getIntByHash(ItemProp::Quantity);
-					auto itemCapacity = itemPtr->getIntByHash(ItemProp::Capacity);
-					if (itemQuantity < itemCapacity &&
-						itemCapacity > 0)
-					{
-						idx = i;
-						itemFound = itemPtr;
-						return (uint32_t)(itemCapacity - itemQuantity);
-					}
-				}
+				idx = *slotIt;
+				itemFound = itemPtr;
+				return (uint32_t)(itemCapacity - itemQuantity);
 			}
 		}
 	}
@@ -553,25 +675,12 @@ uint32_t Inventory::findSmallestFreeQuantity(uint16_t classIdHash16,
 	return 0;
 }
 
-unsigned Inventory::countFreeSlotsNoChecks(uint16_t classIdHash16) const
-{
-	unsigned count = 0;
-	for (const auto& item : items)
-	{
-		if (item.first == nullptr && item.second < 0)
-		{
-			count++;
-		}
-	}
-	return count;
-}
-
 unsigned Inventory::countFreeSlots(uint16_t classIdHash16) const
 {
 	unsigned count = 0;
 	if (isTypeAllowed(classIdHash16) == true)
 	{
-		count = countFreeSlotsNoChecks(classIdHash16);
+		count = countFreeSlotsNoChecks();
 	}
 	return count;
 }
@@ -679,20 +788,12 @@ bool Inventory::getQuantity(uint16_t classIdHash16, uint32_t& quantity) const
 {
 	bool isQuantifiable = false;
 	int64_t totalQuantity = 0;
-	if (isTypeAllowed(classIdHash16) == true)
+	auto it = classSlots.find(classIdHash16);
+	if (it != classSlots.end() &&
+		isTypeAllowed(classIdHash16) == true)
 	{
-		for (const auto& item : (*this))
-		{
-			LevelObjValue quant;
-			if (item.Class()->IdHash16() == classIdHash16)
-			{
-				if (item.getIntByHash(ItemProp::Quantity, quant) == true)
-				{
-					totalQuantity += quant;
-					isQuantifiable = true;
-				}
-			}
-		}
+		totalQuantity = it->second.quantity;
+		isQuantifiable = it->second.quantityItems > 0;
 		if (totalQuantity < 0)
 		{
 			totalQuantity = 0;
@@ -729,13 +830,13 @@ uint32_t Inventory::getMaxCapacity(const ItemClass& itemClass) const
 		maxCapacity += freeQuantity;
 		itemIdx++;
 	}
-	auto freeSlots = countFreeSlotsNoChecks(itemClass.IdHash16());
-	if (freeSlots > 0)
+	auto numFreeSlots = countFreeSlotsNoChecks();
+	if (numFreeSlots > 0)
 	{
 		auto defaultCapacity = itemClass.getDefaultByHash(ItemProp::Capacity);
 		if (defaultCapacity > 0)
 		{
-			maxCapacity += (uint64_t)defaultCapacity * freeSlots;
+			maxCapacity += (uint64_t)defaultCapacity * numFreeSlots;
 			if (maxCapacity >= std::numeric_limits<uint32_t>::max())
 			{
 				return std::numeric_limits<uint32_t>::max();
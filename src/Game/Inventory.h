@@ -5,6 +5,7 @@
 #include <iterator>
 #include <memory>
 #include "PairXY.h"
+#include <unordered_map>
 #include "Utils/iterator_tpl.h"
 #include <vector>
 
@@ -19,8 +20,56 @@ private:
 	std::vector<uint16_t> allowedTypes;
 	bool enforceItemSize{ false };
 
+	struct ClassIndex
+	{
+		// slots (sorted) with an item of the class
+		std::vector<uint16_t> slots;
+		// sum of the quantities of the items
+		int64_t quantity{ 0 };
+		// number of items with a quantity
+		uint16_t quantityItems{ 0 };
+	};
+
+	// index of the items, updated when a slot changes.
+	// items in the inventory update the quantities (see updateQuantity).
+
+	// by item class id
+	std::unordered_map<uint16_t, ClassIndex> classSlots;
+	// bit set if the slot has no item and isn't used by a bigger item.
+	// each row starts in a new word (bit x of the row is slot x).
+	std::vector<uint64_t> freeSlots;
+	size_t rowWords{ 0 };
+	unsigned freeSlotCount{ 0 };
+
+	// max words in a row (PairUInt8 size)
+	static constexpr size_t MaxRowWords = 4;
+
+	size_t getSlotBit(size_t idx) const noexcept
+	{
+		return (idx / size.x) * rowWords * 64 + (idx % size.x);
+	}
+
+	bool isSlotFree(size_t idx) const noexcept
+	{
+		auto bit = getSlotBit(idx);
+		return (freeSlots[bit / 64] & ((uint64_t)1 << (bit % 64))) != 0;
+	}
+
+	// removes slot idx from the index. call before changing the slot.
+	void unindexSlot(size_t idx);
+	// adds slot idx to the index. call after changing the slot.
+	void indexSlot(size_t idx);
+	void rebuildIndex();
+	// clears the inventory of the items, so they stop updating it.
+	void releaseItems() noexcept;
+
+	friend class Item;
+	// called by an item in this inventory when its quantity changes.
+	void updateQuantity(const Item& item, bool hadQuantity,
+		LevelObjValue oldQuantity, LevelObjValue newQuantity) noexcept;
+
 	// Doesn't perform the check for allowed class types. only for items whose size is 1
-	unsigned countFreeSlotsNoChecks(uint16_t classIdHash16) const;
+	unsigned countFreeSlotsNoChecks() const noexcept { return freeSlotCount; }
 
 	bool setAndDontEnforceItemSize(size_t idx, std::shared_ptr<Item>& item,
 		std::shared_ptr<Item>& oldItem);
@@ -28,8 +77,11 @@ private:
 	bool setAndEnforceItemSize(const PairUInt8& position, std::shared_ptr<Item>& item,
 		std::shared_ptr<Item>& oldItem);
 
-	bool isSlotEmpty(int x, int y,
-		const PairUInt8& itemSize, size_t& itemIdx) const;
+	// true if all the slots in the rectangle are free.
+	bool isRectFree(size_t x, size_t y, size_t width, size_t height) const noexcept;
+
+	// sets bit x of runs if slots x to x + width - 1 of row y are free.
+	void getFreeRuns(size_t y, size_t width, uint64_t* runs) const noexcept;
 
 	void resetIndexes() noexcept;
 
@@ -99,11 +151,16 @@ public:
 	Inventory() noexcept {}
 	Inventory(size_t size_);
 	Inventory(const PairUInt8& size_);
+	~Inventory() { releaseItems(); }
+
+	// items point to the inventory they're in.
+	Inventory(const Inventory&) = delete;
+	Inventory& operator=(const Inventory&) = delete;
 
 	void init(size_t size_);
 	void init(const PairUInt8& size_);
 
-	bool empty() const noexcept;
+	bool empty() const noexcept { return freeSlotCount == items.size(); }
 
 	size_t Size() const noexcept { return items.size(); }
 	const PairUInt8& getXYSize() const noexcept { return size; }
@@ -133,7 +190,7 @@ public:
 	bool set(const PairUInt8& position, std::shared_ptr<Item>& item,
 		std::shared_ptr<Item>& oldItem);
 
-	bool isFull() const noexcept;
+	bool isFull() const noexcept { return freeSlotCount == 0; }
 
 	// only checks the specified slot. if a slot is indexing another slot, it returns false.
 	bool isSlotInUse(size_t idx) const;
@@ -145,7 +202,10 @@ public:
 
 	bool hasFreeSlot(const Item& item) const;
 
-	bool hasItem(uint16_t classIdHash16) const;
+	bool hasItem(uint16_t classIdHash16) const
+	{
+		return classSlots.find(classIdHash16) != classSlots.end();
+	}
 
 	// finds an item by the item's class id
 	// returns true if successful and sets both index and item
@@ -6,7 +6,7 @@
 #include "Player.h"
 #include "Utils/Utils.h"
 
-Item::Item(const ItemClass* class__) : LevelObject(class__)
+Item::Item(const ItemClass* class__) : LevelObject(class__, TypeTag)
 {
 	animation.setTexturePack(class__->getDropTexturePack());
 	animation.textureIndexRange = class__->getDropTextureIndexRange();
@@ -132,7 +132,6 @@ bool Item::getNumberPropByHash(const Queryable& owner, uint16_t propHash,
 void Item::update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr)
 {
 	processQueuedActions(game);
-	updateHover(game, level, thisPtr);
 
 	if (hasValidState() == true &&
 		animation.update(game.getElapsedTime()) == true)
@@ -149,6 +148,14 @@ void Item::update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr)
 	}
 }
 
+bool Item::canSleep() const noexcept
+{
+	// hover is enabled again once the drop animation finishes
+	return LevelObject::canSleep() == true &&
+		wasHoverEnabledOnItemDrop == false &&
+		animation.isAnimationAtEnd() == true;
+}
+
 bool Item::getProperty(const std::string_view prop, Variable& var) const
 {
 	if (prop.empty() == true)
@@ -156,8 +163,13 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 		return false;
 	}
 	auto props = Utils::splitStringIn2(prop, '.');
-	auto propHash = str2int16(props.first);
-	if (getLevelObjProp(propHash, props.second, var) == true)
+	return getPropertyByHash(prop, str2int16(props.first), props.second, var);
+}
+
+bool Item::getPropertyByHash(const std::string_view prop, uint16_t propHash,
+	const std::string_view props, Variable& var) const
+{
+	if (getLevelObjProp(propHash, props, var) == true)
 	{
 		return true;
 	}
@@ -176,7 +188,7 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 	case str2int16("d"):
 	case str2int16("description"):
 	{
-		size_t idx = Utils::strtou(props.second);
+		size_t idx = Utils::strtou(props);
 		if (idx >= descriptions.size())
 		{
 			idx = 0;
@@ -185,27 +197,27 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 		break;
 	}
 	case str2int16("eval"):
-		var = Variable((int64_t)Formula::evalString(props.second, this, itemOwner));
+		var = Variable((int64_t)Formula::evalString(props, this, itemOwner));
 		break;
 	case str2int16("evalMin"):
-		var = Variable((int64_t)Formula::evalMinString(props.second, this, itemOwner));
+		var = Variable((int64_t)Formula::evalMinString(props, this, itemOwner));
 		break;
 	case str2int16("evalMax"):
-		var = Variable((int64_t)Formula::evalMaxString(props.second, this, itemOwner));
+		var = Variable((int64_t)Formula::evalMaxString(props, this, itemOwner));
 		break;
 	case str2int16("evalf"):
-		var = Variable(Formula::evalString(props.second, this, itemOwner));
+		var = Variable(Formula::evalString(props, this, itemOwner));
 		break;
 	case str2int16("evalMinf"):
-		var = Variable(Formula::evalMinString(props.second, this, itemOwner));
+		var = Variable(Formula::evalMinString(props, this, itemOwner));
 		break;
 	case str2int16("evalMaxf"):
-		var = Variable(Formula::evalMaxString(props.second, this, itemOwner));
+		var = Variable(Formula::evalMaxString(props, this, itemOwner));
 		break;
 	case str2int16("hasDescription"):
 	{
 		bool hasDescr = false;
-		size_t idx = Utils::strtou(props.second);
+		size_t idx = Utils::strtou(props);
 		if (idx < descriptions.size())
 		{
 			hasDescr = descriptions[idx].empty() == false;
@@ -221,7 +233,7 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 		break;
 	case str2int16("inventorySize"):
 	{
-		if (props.second == "x")
+		if (props == "x")
 		{
 			var = Variable((int64_t)Class()->InventorySize().x);
 		}
@@ -262,14 +274,14 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 		var = Variable((int64_t)properties.size());
 		break;
 	case str2int16("hasProperty"):
-		var = Variable(hasInt(props.second));
+		var = Variable(hasInt(props));
 		break;
 	case str2int16("baseSpell"):
 	{
 		auto spelli = getBaseSpell();
 		if (spelli != nullptr)
 		{
-			return spelli->getProperty(props.second, var);
+			return spelli->getProperty(props, var);
 		}
 		return false;
 	}
@@ -277,7 +289,7 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 	{
 		if (spell != nullptr)
 		{
-			return spell->getProperty(props.second, var);
+			return spell->getProperty(props, var);
 		}
 		return false;
 	}
@@ -289,7 +301,7 @@ bool Item::getProperty(const std::string_view prop, Variable& var) const
 			var = Variable((int64_t)value);
 			break;
 		}
-		else if (Class()->evalFormula(propHash, *this, *this, value, props.second) == true)
+		else if (Class()->evalFormula(propHash, *this, *this, value, props) == true)
 		{
 			var = Variable((int64_t)value);
 			break;
@@ -380,10 +392,22 @@ void Item::setIntByHash(uint16_t propHash, LevelObjValue value)
 		break;
 	default:
 	{
+		LevelObjValue oldValue = 0;
+		bool hadValue = false;
+		if (propHash == ItemProp::Quantity &&
+			inventory != nullptr)
+		{
+			hadValue = properties.getValue(propHash, oldValue);
+		}
 		if (properties.setValue(propHash, value) == false)
 		{
 			return;
 		}
+		if (propHash == ItemProp::Quantity &&
+			inventory != nullptr)
+		{
+			inventory->updateQuantity(*this, hadValue, oldValue, value);
+		}
 	}
 	}
 	updateClassifierVals = true;
@@ -426,6 +450,78 @@ void Item::updateClassifierValues() const
 	}
 }
 
+void Item::updateClassifierValues(const ItemClass& itemClass,
+	const std::vector<Item*>& items)
+{
+	std::vector<const Queryable*> queries;
+	std::vector<const Queryable*> identifiedQueries;
+	queries.reserve(items.size());
+	for (auto item : items)
+	{
+		// querying the items while updating them uses the current values
+		item->updateClassifierVals = false;
+		queries.push_back(item);
+		if (item->identified == true)
+		{
+			identifiedQueries.push_back(item);
+		}
+	}
+
+	std::vector<LevelObjValue> prices;
+	itemClass.getPricePrefix1(queries, prices);
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		items[i]->pricePrefix1 = prices[i];
+	}
+	itemClass.getPricePrefix2(queries, prices);
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		items[i]->pricePrefix2 = prices[i];
+	}
+	itemClass.getPriceSuffix1(queries, prices);
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		items[i]->priceSuffix1 = prices[i];
+	}
+	itemClass.getPriceSuffix2(queries, prices);
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		items[i]->priceSuffix2 = prices[i];
+	}
+
+	std::vector<std::string> texts;
+	itemClass.getFullNames(identifiedQueries, texts);
+	size_t identifiedIdx = 0;
+	for (auto item : items)
+	{
+		if (item->identified == true &&
+			texts[identifiedIdx].empty() == false)
+		{
+			item->name = std::move(texts[identifiedIdx]);
+		}
+		else
+		{
+			item->name = item->SimpleName();
+		}
+		if (item->identified == true)
+		{
+			identifiedIdx++;
+		}
+	}
+
+	for (size_t i = 0; i < std::tuple_size<decltype(descriptions)>::value; i++)
+	{
+		if (itemClass.getDescriptions(i, queries, texts) == false)
+		{
+			continue;
+		}
+		for (size_t j = 0; j < items.size(); j++)
+		{
+			items[j]->descriptions[i] = std::move(texts[j]);
+		}
+	}
+}
+
 void Item::applyDefaults()
 {
 	for (const auto& prop : Class()->Defaults())
@@ -607,7 +703,6 @@ bool Item::use(Player& player, const Level& level, uint32_t& quantityLeft)
 			itemQuantity--;
 			setIntByHash(ItemProp::Quantity, itemQuantity);
 			quantityLeft = (uint32_t)itemQuantity;
-			player.updateItemQuantityCache(ItemProp::Quantity);
 		}
 		player.updateProperties();
 	}
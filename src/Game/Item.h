@@ -6,6 +6,7 @@
 #include "Save/SaveItem.h"
 #include "Utils/FixedMap.h"
 
+class Inventory;
 class Player;
 
 class Item : public LevelObject
@@ -15,6 +16,8 @@ private:
 
 	const Queryable* itemOwner{ nullptr };
 	const SpellInstance* spell{ nullptr };
+	// the inventory the item is in. it's told when the quantity changes.
+	Inventory* inventory{ nullptr };
 
 	bool wasHoverEnabledOnItemDrop{ false };
 
@@ -48,10 +51,13 @@ private:
 	// updates item's price based on whether it's identified or not.
 	void updatePrice() const;
 
+	friend class Inventory;
 	friend void Save::serialize(void* serializeObj, Save::Properties& props,
 		const Game& game, const Level& level, const Item& item);
 
 public:
+	static constexpr LevelObjectType TypeTag = LevelObjectType::Item;
+
 	using iterator = ItemProperties::iterator;
 	using const_iterator = ItemProperties::const_iterator;
 	using reverse_iterator = ItemProperties::reverse_iterator;
@@ -93,9 +99,13 @@ public:
 		Save::serialize(serializeObj, props, game, level, *this);
 	}
 
+	virtual bool canSleep() const noexcept;
+
 	virtual void update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr);
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
+	virtual bool getPropertyByHash(const std::string_view prop, uint16_t propHash,
+		const std::string_view props, Variable& var) const;
 	virtual void setProperty(const std::string_view prop, const Variable& val);
 
 	virtual const std::string_view getType() const { return "item"; }
@@ -118,6 +128,11 @@ public:
 
 	void applyDefaults();
 
+	// updates the classifier values (prices, name and descriptions) of items
+	// of itemClass, evaluating each classifier for all the items at once.
+	static void updateClassifierValues(const ItemClass& itemClass,
+		const std::vector<Item*>& items);
+
 	bool needsRecharge() const;
 	bool needsRepair() const;
 	bool isUsable() const noexcept;
@@ -1,4 +1,5 @@
 #include "ItemClass.h"
+#include <algorithm>
 #include "GameUtils.h"
 
 ItemClass::ItemClass(const std::shared_ptr<TexturePack>& textureDrop_,
@@ -6,6 +7,8 @@ ItemClass::ItemClass(const std::shared_ptr<TexturePack>& textureDrop_,
 	uint32_t inventoryIdx_) : textureDrop(textureDrop_),
 	textureInventory(textureInventory_), inventoryIdx(inventoryIdx_)
 {
+	// items only animate when dropped
+	updateClass = UpdateClass::EventDriven;
 	if (textureDrop_ != nullptr)
 	{
 		dropTextureIndexRange = textureDrop_->getRange(-1, -1);
@@ -44,13 +47,42 @@ bool ItemClass::getFullName(const Queryable& item, std::string& fullName) const
 	classifiers.getText(PrefixClassifier, item, strPrefix);
 	classifiers.getText(SuffixClassifier, item, strSuffix);
 
-	bool hasPrefix = strPrefix.empty() == false;
-	bool hasSuffix = strSuffix.empty() == false;
-
-	if (hasPrefix == false && hasSuffix == false)
+	if (strPrefix.empty() == true && strSuffix.empty() == true)
 	{
 		return false;
 	}
+	makeFullName(item, strPrefix, strSuffix, fullName);
+	return true;
+}
+
+void ItemClass::getFullNames(const std::vector<const Queryable*>& items,
+	std::vector<std::string>& fullNames) const
+{
+	std::vector<std::string> prefixes;
+	std::vector<std::string> suffixes;
+	classifiers.getTexts(PrefixClassifier, items, prefixes);
+	classifiers.getTexts(SuffixClassifier, items, suffixes);
+	prefixes.resize(items.size());
+	suffixes.resize(items.size());
+
+	fullNames.resize(items.size());
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		if (prefixes[i].empty() == true && suffixes[i].empty() == true)
+		{
+			fullNames[i].clear();
+			continue;
+		}
+		makeFullName(*items[i], prefixes[i], suffixes[i], fullNames[i]);
+	}
+}
+
+void ItemClass::makeFullName(const Queryable& item, const std::string& strPrefix,
+	const std::string& strSuffix, std::string& fullName) const
+{
+	bool hasPrefix = strPrefix.empty() == false;
+	bool hasSuffix = strSuffix.empty() == false;
+
 	if (hasPrefix == true)
 	{
 		fullName = GameUtils::replaceStringWithQueryable(strPrefix, item) + ' ';
@@ -71,7 +103,6 @@ bool ItemClass::getFullName(const Queryable& item, std::string& fullName) const
 	{
 		fullName += ' ' + GameUtils::replaceStringWithQueryable(strSuffix, item);
 	}
-	return true;
 }
 
 LevelObjValue ItemClass::getClassifierNumOrFormula(size_t idx, const Queryable& item) const
@@ -96,6 +127,63 @@ LevelObjValue ItemClass::getClassifierNumOrFormula(size_t idx, const Queryable&
 	return 0;
 }
 
+void ItemClass::getClassifierNumOrFormula(size_t idx,
+	const std::vector<const Queryable*>& items, std::vector<LevelObjValue>& values) const
+{
+	values.assign(items.size(), 0);
+	std::vector<Variable> vars;
+	if (classifiers.getVars(idx, items, vars) == false)
+	{
+		return;
+	}
+
+	// formulas are parsed once and evaluated for all the items that use them.
+	std::vector<std::pair<std::string_view, std::vector<size_t>>> formulaItems;
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		const auto& var = vars[i];
+		if (std::holds_alternative<std::string>(var) == true)
+		{
+			const auto& str = std::get<std::string>(var);
+			auto it = std::find_if(formulaItems.begin(), formulaItems.end(),
+				[&str](const auto& elem) { return elem.first == str; });
+			if (it == formulaItems.end())
+			{
+				formulaItems.emplace_back(str, std::vector<size_t>{ i });
+			}
+			else
+			{
+				it->second.push_back(i);
+			}
+		}
+		else if (std::holds_alternative<int64_t>(var) == true)
+		{
+			values[i] = (LevelObjValue)std::get<int64_t>(var);
+		}
+		else if (std::holds_alternative<double>(var) == true)
+		{
+			values[i] = (LevelObjValue)std::get<double>(var);
+		}
+	}
+
+	std::vector<const Queryable*> formulaQueries;
+	std::vector<double> formulaValues;
+	for (const auto& elem : formulaItems)
+	{
+		Formula f(elem.first);
+		formulaQueries.clear();
+		for (auto i : elem.second)
+		{
+			formulaQueries.push_back(items[i]);
+		}
+		f.eval(formulaQueries, formulaValues);
+		for (size_t i = 0; i < elem.second.size(); i++)
+		{
+			values[elem.second[i]] = (LevelObjValue)formulaValues[i];
+		}
+	}
+}
+
 LevelObjValue ItemClass::getPricePrefix1(const Queryable& item) const
 {
 	return getClassifierNumOrFormula(PricePrefix1Classifier, item);
@@ -116,6 +204,30 @@ LevelObjValue ItemClass::getPriceSuffix2(const Queryable& item) const
 	return getClassifierNumOrFormula(PriceSuffix2Classifier, item);
 }
 
+void ItemClass::getPricePrefix1(const std::vector<const Queryable*>& items,
+	std::vector<LevelObjValue>& prices) const
+{
+	getClassifierNumOrFormula(PricePrefix1Classifier, items, prices);
+}
+
+void ItemClass::getPricePrefix2(const std::vector<const Queryable*>& items,
+	std::vector<LevelObjValue>& prices) const
+{
+	getClassifierNumOrFormula(PricePrefix2Classifier, items, prices);
+}
+
+void ItemClass::getPriceSuffix1(const std::vector<const Queryable*>& items,
+	std::vector<LevelObjValue>& prices) const
+{
+	getClassifierNumOrFormula(PriceSuffix1Classifier, items, prices);
+}
+
+void ItemClass::getPriceSuffix2(const std::vector<const Queryable*>& items,
+	std::vector<LevelObjValue>& prices) const
+{
+	getClassifierNumOrFormula(PriceSuffix2Classifier, items, prices);
+}
+
 void ItemClass::setPricePrefix1(Classifier* classifier)
 {
 	classifiers.set(PricePrefix1Classifier, classifier, 0);
@@ -161,6 +273,12 @@ bool ItemClass::getDescription(size_t idx, const Queryable& item, std::string& d
 	return classifiers.getText(DescriptionClassifier + idx, item, description);
 }
 
+bool ItemClass::getDescriptions(size_t idx, const std::vector<const Queryable*>& items,
+	std::vector<std::string>& descriptions) const
+{
+	return classifiers.getTexts(DescriptionClassifier + idx, items, descriptions);
+}
+
 const SpellInstance* ItemClass::getSpell() const noexcept
 {
 	if (spell.spell == nullptr)
@@ -47,6 +47,12 @@ private:
 
 	LevelObjValue getClassifierNumOrFormula(size_t idx, const Queryable& item) const;
 
+	void getClassifierNumOrFormula(size_t idx, const std::vector<const Queryable*>& items,
+		std::vector<LevelObjValue>& values) const;
+
+	void makeFullName(const Queryable& item, const std::string& strPrefix,
+		const std::string& strSuffix, std::string& fullName) const;
+
 public:
 	ItemClass(const std::shared_ptr<TexturePack>& textureDrop_,
 		const std::shared_ptr<TexturePack>& textureInventory_,
@@ -107,11 +113,25 @@ public:
 
 	bool getFullName(const Queryable& item, std::string& fullName) const;
 
+	// full name of each item or an empty string if it has no prefix/suffix.
+	void getFullNames(const std::vector<const Queryable*>& items,
+		std::vector<std::string>& fullNames) const;
+
 	LevelObjValue getPricePrefix1(const Queryable& item) const;
 	LevelObjValue getPricePrefix2(const Queryable& item) const;
 	LevelObjValue getPriceSuffix1(const Queryable& item) const;
 	LevelObjValue getPriceSuffix2(const Queryable& item) const;
 
+	// prices of each item (0 if there's no classifier).
+	void getPricePrefix1(const std::vector<const Queryable*>& items,
+		std::vector<LevelObjValue>& prices) const;
+	void getPricePrefix2(const std::vector<const Queryable*>& items,
+		std::vector<LevelObjValue>& prices) const;
+	void getPriceSuffix1(const std::vector<const Queryable*>& items,
+		std::vector<LevelObjValue>& prices) const;
+	void getPriceSuffix2(const std::vector<const Queryable*>& items,
+		std::vector<LevelObjValue>& prices) const;
+
 	void setPricePrefix1(Classifier* classifier);
 	void setPricePrefix2(Classifier* classifier);
 	void setPriceSuffix1(Classifier* classifier);
@@ -121,6 +141,9 @@ public:
 
 	bool getDescription(size_t idx, const Queryable& item, std::string& description) const;
 
+	bool getDescriptions(size_t idx, const std::vector<const Queryable*>& items,
+		std::vector<std::string>& descriptions) const;
+
 	bool hasSpell() const noexcept { return spell.spell != nullptr; }
 	const SpellInstance* getSpell() const noexcept;
 	void setSpell(Spell* obj);
@@ -0,0 +1,68 @@
+#include "ItemGenerator.h"
+#include "Item.h"
+#include <limits>
+#include "Utils/Utils.h"
+
+void ItemGenerator::setProperty(uint16_t propHash, LevelObjValue min, LevelObjValue max)
+{
+	if (min > max)
+	{
+		std::swap(min, max);
+	}
+	for (auto& prop : properties)
+	{
+		if (prop.propHash == propHash)
+		{
+			prop.min = min;
+			prop.max = max;
+			return;
+		}
+	}
+	properties.push_back({ propHash, min, max });
+}
+
+void ItemGenerator::generate(const ItemClass& itemClass, size_t count,
+	std::mt19937& rng, std::vector<std::shared_ptr<Item>>& items) const
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	std::vector<Item*> newItems;
+	newItems.reserve(count);
+	items.reserve(items.size() + count);
+	for (size_t i = 0; i < count; i++)
+	{
+		auto item = std::make_shared<Item>(&itemClass);
+		newItems.push_back(item.get());
+		items.push_back(std::move(item));
+	}
+
+	// one property at a time for all the items
+	for (const auto& prop : properties)
+	{
+		if (prop.min == prop.max)
+		{
+			for (auto item : newItems)
+			{
+				item->setIntByHash(prop.propHash, prop.min);
+			}
+			continue;
+		}
+		for (auto item : newItems)
+		{
+			item->setIntByHash(prop.propHash,
+				Utils::Random::get<LevelObjValue>(rng, prop.min, prop.max));
+		}
+	}
+
+	Item::updateClassifierValues(itemClass, newItems);
+}
+
+void ItemGenerator::generate(const ItemClass& itemClass, size_t count,
+	std::vector<std::shared_ptr<Item>>& items) const
+{
+	std::mt19937 rng(Utils::Random::get<uint32_t>(std::numeric_limits<uint32_t>::max()));
+	generate(itemClass, count, rng, items);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "GameProperties.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+class Item;
+class ItemClass;
+
+// creates items in batches (shop stock, drop tables).
+// the random property values of a batch come from one generator and the
+// classifier values (prices, names, descriptions) are evaluated for all the
+// items of a class at once, instead of on the first query of each item.
+class ItemGenerator
+{
+private:
+	struct PropertyRange
+	{
+		uint16_t propHash;
+		LevelObjValue min;
+		LevelObjValue max;
+	};
+
+	std::vector<PropertyRange> properties;
+
+public:
+	// sets the property of the generated items to a random value in [min, max].
+	void setProperty(uint16_t propHash, LevelObjValue min, LevelObjValue max);
+
+	// creates count items of itemClass and adds them to the end of items.
+	void generate(const ItemClass& itemClass, size_t count,
+		std::mt19937& rng, std::vector<std::shared_ptr<Item>>& items) const;
+
+	// uses a generator seeded from Utils::Random (repeatable in replays).
+	void generate(const ItemClass& itemClass, size_t count,
+		std::vector<std::shared_ptr<Item>>& items) const;
+};
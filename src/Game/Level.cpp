@@ -1,8 +1,10 @@
 #include "Level.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "GameHashes.h"
 #include "GameUtils.h"
 #include "Panel.h"
+#include "PerfCounters.h"
 #include "Player.h"
 #include "SimpleLevelObject.h"
 #include "Utils/Utils.h"
@@ -13,8 +15,8 @@ void Level::Init(const Game& game, LevelMap map_,
 	int32_t indexToDrawObjects)
 {
 	map = std::move(map_);
-	clickedObject.reset();
-	hoverObject.reset();
+	clickedObject = {};
+	hoverObject = {};
 
 	surface.tileWidth = std::max(tileWidth, 2);
 	surface.tileHeight = std::max(tileHeight, 2);
@@ -27,6 +29,7 @@ void Level::Init(const Game& game, LevelMap map_,
 	automapSurface.blockWidth = surface.blockWidth;
 	automapSurface.blockHeight = surface.blockHeight;
 
+	waitForRenderThread();
 	levelLayers.clear();
 	for (const auto& layer : levelLayers_)
 	{
@@ -66,6 +69,7 @@ void Level::Init(const Game& game, LevelMap map_,
 	}
 
 	map.setDefaultTileSize(surface.tileWidth, surface.tileHeight);
+	pickGrid.init(map);
 
 	setCurrentMapPosition(PairFloat(-1.f, -1.f), false);
 
@@ -80,8 +84,9 @@ void Level::Init(const Game& game, LevelMap map_,
 
 void Level::Init()
 {
-	clickedObject.reset();
-	hoverObject.reset();
+	clickedObject = {};
+	hoverObject = {};
+	pickGrid.init(map);
 
 	map.initLights();
 	updateLevelObjectPositions();
@@ -108,6 +113,7 @@ void Level::setAutomap(const TilesetLevelLayer& automapLayer, int tileWidth,
 	automapSurface.blockWidth = automapSurface.tileWidth / 2;
 	automapSurface.blockHeight = automapSurface.tileHeight / 2;
 
+	waitForRenderThread();
 	bool updated = false;
 	for (auto& layer : levelLayers)
 	{
@@ -127,6 +133,12 @@ void Level::setAutomap(const TilesetLevelLayer& automapLayer, int tileWidth,
 	viewNeedsUpdate = true;
 }
 
+void Level::waitForRenderThread() const
+{
+	surface.waitForRenderThread();
+	automapSurface.waitForRenderThread();
+}
+
 void Level::addDrawable(LevelDrawable obj)
 {
 	for (const auto& drawable : drawables)
@@ -213,6 +225,8 @@ void Level::updateLevelObjectPositions()
 		{
 			obj->MapPosition(map, mapPosition);
 		}
+		// sleeping objects aren't updated, so they're added here
+		pickGrid.update(*obj, map);
 	}
 }
 
@@ -392,23 +406,59 @@ void Level::addLevelObject(std::shared_ptr<LevelObject> obj, const PairFloat& ma
 		levelObjectIds[obj->getId()] = obj;
 	}
 	obj->MapPosition(map, mapCoord);
-	levelObjects.push_back(obj);
+	auto objPtr = obj.get();
+	objPtr->setLevelHandle(levelObjects.insert(std::move(obj)));
+	if (objPtr->getUpdateClass() == UpdateClass::Always)
+	{
+		alwaysObjects.push_back(objPtr->getLevelHandle());
+	}
+	pickGrid.update(*objPtr, map);
+	wakeLevelObject(*objPtr);
+}
+
+void Level::wakeLevelObject(LevelObject& obj)
+{
+	if (obj.Awake() == true ||
+		obj.getUpdateClass() == UpdateClass::Never ||
+		getLevelObject(obj.getLevelHandle()) != &obj)
+	{
+		return;
+	}
+	obj.Awake(true);
+	awakeObjects.push_back(obj.getLevelHandle());
 }
 
 void Level::clearCache(const LevelObject* obj) noexcept
 {
-	if (clickedObject.lock().get() == obj)
+	if (currentPlayer.lock().get() == obj)
+	{
+		currentPlayer.reset();
+	}
+	pickGrid.remove(obj);
+}
+
+std::shared_ptr<LevelObject> Level::eraseLevelObject(SlotMapHandle handle)
+{
+	auto objPtr = levelObjects.get(handle);
+	if (objPtr == nullptr)
 	{
-		clickedObject.reset();
+		return nullptr;
 	}
-	if (hoverObject.lock().get() == obj)
+	auto obj = std::move(*objPtr);
+	levelObjects.erase(handle);
+	obj->setLevelHandle({});
+	obj->Awake(false);
+	if (obj->getUpdateClass() == UpdateClass::Always)
 	{
-		hoverObject.reset();
+		alwaysObjects.erase(std::remove(alwaysObjects.begin(),
+			alwaysObjects.end(), handle), alwaysObjects.end());
 	}
-	if (currentPlayer.lock().get() == obj)
+	if (obj->getId().empty() == false)
 	{
-		currentPlayer.reset();
+		levelObjectIds.erase(obj->getId());
 	}
+	clearCache(obj.get());
+	return obj;
 }
 
 void Level::deleteLevelObjectById(const std::string_view id)
@@ -417,20 +467,12 @@ void Level::deleteLevelObjectById(const std::string_view id)
 	{
 		return;
 	}
-	for (auto it = levelObjects.begin(); it != levelObjects.end(); ++it)
+	auto it = levelObjectIds.find(std::string(id));
+	if (it != levelObjectIds.end())
 	{
-		if ((*it)->getId() == id)
-		{
-			auto obj = it->get();
-			obj->remove(map);
-			clearCache(obj);
-			if (obj->getId().empty() == false)
-			{
-				levelObjectIds.erase(obj->getId());
-			}
-			levelObjects.erase(it);
-			break;
-		}
+		auto obj = it->second.get();
+		obj->remove(map);
+		eraseLevelObject(obj->getLevelHandle());
 	}
 }
 
@@ -440,18 +482,12 @@ void Level::deleteLevelObjectByClass(const std::string_view classId)
 	{
 		return;
 	}
-	for (auto it = levelObjects.begin(); it != levelObjects.end(); ++it)
+	for (const auto& obj : levelObjects)
 	{
-		if ((*it)->getClassId() == classId)
+		if (obj->getClassId() == classId)
 		{
-			auto obj = it->get();
 			obj->remove(map);
-			clearCache(obj);
-			if (obj->getId().empty() == false)
-			{
-				levelObjectIds.erase(obj->getId());
-			}
-			levelObjects.erase(it);
+			eraseLevelObject(obj->getLevelHandle());
 			break;
 		}
 	}
@@ -459,6 +495,8 @@ void Level::deleteLevelObjectByClass(const std::string_view classId)
 
 void Level::draw(const Game& game, sf::RenderTarget& target) const
 {
+	PROFILE_SCOPE("Level::draw");
+
 	if (visible == false)
 	{
 		return;
@@ -466,10 +504,8 @@ void Level::draw(const Game& game, sf::RenderTarget& target) const
 
 	auto origView = target.getView();
 
-	surface.clear(sf::Color::Black);
-	automapSurface.clear(sf::Color::Transparent);
-
-	SpriteShaderCache spriteCache;
+	surface.clear(sf::Color::Black, game.getRenderThread());
+	automapSurface.clear(sf::Color::Transparent, game.getRenderThread());
 
 	for (size_t i = 0; i < levelLayers.size(); i++)
 	{
@@ -501,8 +537,7 @@ void Level::draw(const Game& game, sf::RenderTarget& target) const
 		if (holdsTilesetLevelLayer(levelLayer.layer) == true)
 		{
 			const auto& layer = std::get<TilesetLevelLayer>(levelLayer.layer);
-			layer.draw(layerInfo, spriteCache,
-				game.Shaders().Sprite, *this,
+			layer.draw(layerInfo, game.Shaders().CommandListSprite, *this,
 				i == indexToDrawLevelObjects,
 				levelLayer.automap
 			);
@@ -593,7 +628,7 @@ void Level::onMouseButtonPressed(Game& game)
 	case sf::Mouse::Left:
 	{
 		clickedMapPosition = getMapCoordOverMouse();
-		clickedObject.reset();
+		clickedObject = {};
 		if (leftAction != nullptr)
 		{
 			game.Events().addBack(leftAction);
@@ -640,7 +675,7 @@ void Level::onTouchBegan(Game& game)
 	case 0:
 	{
 		clickedMapPosition = getMapCoordOverMouse();
-		clickedObject.reset();
+		clickedObject = {};
 		if (leftAction != nullptr)
 		{
 			game.Events().addBack(leftAction);
@@ -662,6 +697,8 @@ void Level::onTouchBegan(Game& game)
 
 void Level::update(Game& game)
 {
+	PROFILE_SCOPE("Level::update");
+
 	if (visible == false)
 	{
 		return;
@@ -677,6 +714,9 @@ void Level::update(Game& game)
 		return;
 	}
 
+	// levels animate and move every frame
+	game.invalidate();
+
 	updateZoom(game);
 	updateMouse(game);
 	map.updateLights();
@@ -723,10 +763,8 @@ void Level::update(Game& game)
 	{
 		hasMouseInside = false;
 	}
-	for (auto& obj : levelObjects)
-	{
-		obj->update(game, *this, obj);
-	}
+	updateLevelObjects(game);
+	updateHover(game);
 	if (currentMapPosition.x == -1.f &&
 		currentMapPosition.y == -1.f)
 	{
@@ -760,10 +798,203 @@ void Level::update(Game& game)
 	{
 		viewNeedsUpdate = false;
 	}
+	prevTickViewCenter = tickViewCenter;
+	tickViewCenter = { newViewCenterX, newViewCenterY };
 
 	updateDrawables(game);
 }
 
+void Level::queueLevelObjectUpdate(LevelObject& obj)
+{
+	if (obj.UpdateTick() != updateTick)
+	{
+		obj.UpdateTick(updateTick);
+		updatedObjects.push_back(obj.getLevelHandle());
+	}
+}
+
+void Level::updateLevelObjects(Game& game)
+{
+	updateTick++;
+	std::swap(updatedObjects, prevUpdatedObjects);
+	updatedObjects.clear();
+
+	if (auto player = currentPlayer.lock())
+	{
+		queueLevelObjectUpdate(*player);
+	}
+	for (const auto& handle : alwaysObjects)
+	{
+		if (auto obj = getLevelObject(handle))
+		{
+			queueLevelObjectUpdate(*obj);
+		}
+	}
+	for (const auto& handle : awakeObjects)
+	{
+		if (auto obj = getLevelObject(handle))
+		{
+			queueLevelObjectUpdate(*obj);
+		}
+	}
+
+	// active region (see TilesetLevelLayer::updateVisibleArea)
+	const auto& mapSize = map.MapSizei();
+	if (mapSize.x > 0 && mapSize.y > 0)
+	{
+		auto marginX = (float)(surface.tileWidth * (ActiveRegionMargin + 1));
+		auto marginY = (float)(surface.tileHeight * (ActiveRegionMargin + 1));
+		sf::Vector2f TL{
+			surface.visibleRect.left - marginX,
+			surface.visibleRect.top - marginY
+		};
+		sf::Vector2f TR{ TL.x + surface.visibleRect.width + marginX * 2.f, TL.y };
+		sf::Vector2f BL{ TL.x, TL.y + surface.visibleRect.height + marginY * 2.f };
+		sf::Vector2f BR{ TR.x, BL.y };
+
+		auto mapTL = map.toMapCoord(TL, surface.blockWidth, surface.blockHeight);
+		auto mapTR = map.toMapCoord(TR, surface.blockWidth, surface.blockHeight);
+		auto mapBL = map.toMapCoord(BL, surface.blockWidth, surface.blockHeight);
+		auto mapBR = map.toMapCoord(BR, surface.blockWidth, surface.blockHeight);
+
+		auto startX = std::clamp((int32_t)mapTL.x, 0, mapSize.x - 1);
+		auto endX = std::clamp((int32_t)mapBR.x, 0, mapSize.x - 1);
+		auto startY = std::clamp((int32_t)mapTR.y, 0, mapSize.y - 1);
+		auto endY = std::clamp((int32_t)mapBL.y, 0, mapSize.y - 1);
+
+		for (auto x = startX; x <= endX; x++)
+		{
+			for (auto y = startY; y <= endY; y++)
+			{
+				for (auto obj : map[x][y])
+				{
+					if (obj->getUpdateClass() == UpdateClass::NearView)
+					{
+						queueLevelObjectUpdate(*obj);
+					}
+				}
+			}
+		}
+	}
+
+	// objects that are no longer updated stop interpolating
+	for (const auto& handle : prevUpdatedObjects)
+	{
+		auto obj = getLevelObject(handle);
+		if (obj != nullptr && obj->UpdateTick() != updateTick)
+		{
+			obj->beginTick();
+			obj->interpolate(1.f);
+		}
+	}
+
+	PerfCounters::add(PerfCounters::Counter::LevelObjectUpdates, updatedObjects.size());
+
+	for (const auto& handle : updatedObjects)
+	{
+		// updates can remove objects
+		auto objPtr = levelObjects.get(handle);
+		if (objPtr == nullptr)
+		{
+			continue;
+		}
+		auto obj = *objPtr;
+		obj->beginTick();
+		obj->update(game, *this, obj);
+		pickGrid.update(*obj, map);
+
+		// leaving the active region mustn't stop a movement or animation
+		if (obj->Awake() == false &&
+			obj->getUpdateClass() == UpdateClass::NearView &&
+			obj->canSleep() == false)
+		{
+			wakeLevelObject(*obj);
+		}
+	}
+
+	awakeObjects.erase(std::remove_if(awakeObjects.begin(), awakeObjects.end(),
+		[&](const SlotMapHandle& handle)
+		{
+			auto obj = getLevelObject(handle);
+			if (obj == nullptr)
+			{
+				return true;
+			}
+			// objects woken by this tick's updates weren't updated yet
+			if (obj->UpdateTick() == updateTick &&
+				obj->canSleep() == true)
+			{
+				obj->Awake(false);
+				return true;
+			}
+			return false;
+		}), awakeObjects.end());
+}
+
+void Level::updateHover(Game& game)
+{
+	if (enableHover == false)
+	{
+		return;
+	}
+	LevelObject* obj = nullptr;
+	if (hasMouseInside == true)
+	{
+		obj = pickGrid.pick(map, mousePositionf, mapCoordOverMouse);
+	}
+	if (obj != nullptr && levelObjects.contains(clickedObject) == false)
+	{
+		clickedObject = obj->getLevelHandle();
+	}
+	auto oldObj = getHoverObject();
+	if (obj == oldObj)
+	{
+		return;
+	}
+	if (oldObj != nullptr)
+	{
+		oldObj->Hovered(false);
+		hoverObject = {};
+		executeHoverLeaveAction(game);
+	}
+	if (obj != nullptr)
+	{
+		obj->Hovered(true);
+		hoverObject = obj->getLevelHandle();
+		executeHoverEnterAction(game);
+	}
+}
+
+void Level::interpolate(Game& game, float alpha)
+{
+	if (visible == false || pause == true)
+	{
+		return;
+	}
+	game.invalidate();
+	for (const auto& handle : updatedObjects)
+	{
+		if (auto obj = getLevelObject(handle))
+		{
+			obj->interpolate(alpha);
+		}
+	}
+	auto viewOffset = (prevTickViewCenter - tickViewCenter) * (1.f - alpha);
+	if (std::abs(viewOffset.x) > surface.Size().x / 2.f ||
+		std::abs(viewOffset.y) > surface.Size().y / 2.f)
+	{
+		viewOffset = {};
+	}
+	auto newViewCenterX = std::round(tickViewCenter.x + viewOffset.x);
+	auto newViewCenterY = std::round(tickViewCenter.y + viewOffset.y);
+	if (surface.getCenter().x != newViewCenterX ||
+		surface.getCenter().y != newViewCenterY)
+	{
+		surface.setCenter(newViewCenterX, newViewCenterY);
+		updateTilesetLayersVisibleArea();
+	}
+}
+
 void Level::updateDrawables(Game& game)
 {
 	for (auto it = drawables.rbegin(); it != drawables.rend();)
@@ -832,7 +1063,7 @@ bool Level::getProperty(const std::string_view prop, Variable& var) const
 	{
 	case str2int16("clickedObject"):
 	{
-		if (auto obj = clickedObject.lock())
+		if (auto obj = getClickedObject())
 		{
 			return obj->getProperty(props.second, var);
 		}
@@ -857,7 +1088,7 @@ bool Level::getProperty(const std::string_view prop, Variable& var) const
 		return true;
 	case str2int16("hoverObject"):
 	{
-		if (auto obj = hoverObject.lock())
+		if (auto obj = getHoverObject())
 		{
 			return obj->getProperty(props.second, var);
 		}
@@ -954,7 +1185,7 @@ const Queryable* Level::getQueryable(const std::string_view prop) const
 	{
 	case str2int16("clickedObject"):
 	{
-		queryable = clickedObject.lock().get();
+		queryable = getClickedObject();
 		break;
 	}
 	case str2int16("currentPlayer"):
@@ -965,7 +1196,7 @@ const Queryable* Level::getQueryable(const std::string_view prop) const
 	break;
 	case str2int16("hoverObject"):
 	{
-		queryable = hoverObject.lock().get();
+		queryable = getHoverObject();
 		break;
 	}
 	break;
@@ -1065,9 +1296,16 @@ void Level::clearAllLevelObjects()
 		{
 			map[mapPos].removeObject(obj.get());
 		}
+		obj->setLevelHandle({});
+		obj->Awake(false);
 	}
 	levelObjects.clear();
 	levelObjectIds.clear();
+	pickGrid.clear();
+	alwaysObjects.clear();
+	awakeObjects.clear();
+	updatedObjects.clear();
+	prevUpdatedObjects.clear();
 }
 
 LevelObject* Level::getLevelObject(const std::string id) const
@@ -1109,11 +1347,19 @@ std::weak_ptr<LevelObject> Level::getLevelObjectPtr(const std::string id) const
 	switch (str2int16(id))
 	{
 	case str2int16("clickedObject"):
-		return clickedObject;
+		if (auto obj = levelObjects.get(clickedObject))
+		{
+			return *obj;
+		}
+		return {};
 	case str2int16("currentPlayer"):
 		return currentPlayer;
 	case str2int16("hoverObject"):
-		return hoverObject;
+		if (auto obj = levelObjects.get(hoverObject))
+		{
+			return *obj;
+		}
+		return {};
 	default:
 		break;
 	}
@@ -1142,6 +1388,7 @@ void Level::setCurrentPlayer(std::weak_ptr<Player> player_) noexcept
 
 void Level::clearPlayerClasses()
 {
+	waitForRenderThread();
 	for (auto it = levelObjectClasses.begin(); it != levelObjectClasses.end();)
 	{
 		auto plrClass = dynamic_cast<PlayerClass*>(it->second.get());
@@ -1168,6 +1415,7 @@ void Level::clearPlayerClasses()
 
 void Level::clearPlayerTextures() noexcept
 {
+	waitForRenderThread();
 	for (const auto& classObj : levelObjectClasses)
 	{
 		auto plrClass = dynamic_cast<PlayerClass*>(classObj.second.get());
@@ -1397,21 +1645,13 @@ bool Level::deleteItem(const ItemLocation& location)
 
 LevelObjValue Level::addItemQuantity(const ItemLocation& location, LevelObjValue amount)
 {
-	Player* player;
-	auto item = getItem(location, player);
+	auto item = getItem(location);
 	if (item != nullptr)
 	{
 		if (amount != 0)
 		{
 			LevelObjValue newAmount = amount;
 			auto newQuant = item->addQuantity(newAmount);
-
-			if (player != nullptr &&
-				std::get<ItemCoordInventory>(location).isSelectedItem() == false)
-			{
-				player->updateItemQuantityCache(
-					item->Class()->IdHash16(), (amount - newAmount));
-			}
 			if (newQuant == 0)
 			{
 				removeItem(location);
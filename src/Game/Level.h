@@ -7,6 +7,7 @@
 #include "LevelLayer.h"
 #include "LevelMap.h"
 #include "LevelObjectClass.h"
+#include "LevelPickGrid.h"
 #include "LevelSurface.h"
 #include "Quest.h"
 #include "Save/SaveLevel.h"
@@ -14,6 +15,7 @@
 #include <unordered_map>
 #include "Utils/EasedValue.h"
 #include "Utils/FixedArray.h"
+#include "Utils/SlotMap.h"
 
 class Panel;
 class Player;
@@ -61,6 +63,10 @@ private:
 	sf::Vector2f currentAutomapViewCenter;
 	bool smoothMovement{ false };
 
+	// view centers at the start and at the end of the last simulation tick
+	sf::Vector2f prevTickViewCenter;
+	sf::Vector2f tickViewCenter;
+
 	std::string id;
 	std::string name;
 	std::string path;
@@ -74,13 +80,29 @@ private:
 
 	PairFloat clickedMapPosition;
 
-	std::vector<std::shared_ptr<LevelObject>> levelObjects;
+	// objects keep their handle (LevelObject::getLevelHandle), removing is O(1).
+	SlotMap<std::shared_ptr<LevelObject>> levelObjects;
 	std::unordered_map<std::string, std::shared_ptr<LevelObject>> levelObjectIds;
 
-	std::weak_ptr<LevelObject> clickedObject;
-	std::weak_ptr<LevelObject> hoverObject;
+	// handles don't resolve once the objects are removed
+	SlotMapHandle clickedObject;
+	SlotMapHandle hoverObject;
+	LevelPickGrid pickGrid;
 	std::weak_ptr<Player> currentPlayer;
 
+	// objects are updated by their class' UpdateClass. NearView objects are
+	// updated inside the view plus this many tiles.
+	static constexpr int32_t ActiveRegionMargin = 8;
+
+	// UpdateClass::Always objects
+	std::vector<SlotMapHandle> alwaysObjects;
+	// updated until they can sleep
+	std::vector<SlotMapHandle> awakeObjects;
+	// objects updated in the current and previous tick
+	std::vector<SlotMapHandle> updatedObjects;
+	std::vector<SlotMapHandle> prevUpdatedObjects;
+	uint32_t updateTick{ 0 };
+
 	std::unordered_map<std::string, std::unique_ptr<Classifier>> classifiers;
 	std::unordered_map<std::string, std::unique_ptr<LevelObjectClass>> levelObjectClasses;
 
@@ -109,30 +131,28 @@ private:
 
 	void addLevelObject(std::shared_ptr<LevelObject> obj, const PairFloat& mapCoord);
 
-	// clears the clickedObject, hoverObject, currentPlayer if they're pointing to the given object.
+	// clears the currentPlayer if it's pointing to the given object
+	// and removes it from the pick grid.
 	void clearCache(const LevelObject* obj) noexcept;
 
+	// Removes level object from level. Object still needs to be deleted from map.
+	// Returns the removed object.
+	std::shared_ptr<LevelObject> eraseLevelObject(SlotMapHandle handle);
+
 	// Removes level object from level. Object still needs to be deleted from map.
 	// Returns the removed object.
 	template <class T>
 	std::shared_ptr<T> removeLevelObject(const LevelObject* obj)
 	{
-		std::shared_ptr<T> oldObj;
-		for (auto it = levelObjects.begin(); it != levelObjects.end(); ++it)
+		const auto& handle = obj->getLevelHandle();
+		auto objPtr = levelObjects.get(handle);
+		if (objPtr == nullptr ||
+			objPtr->get() != obj ||
+			obj->is<T>() == false)
 		{
-			if (it->get() == obj)
-			{
-				oldObj = std::move(std::dynamic_pointer_cast<T>(*it));
-				if (oldObj->getId().empty() == false)
-				{
-					levelObjectIds.erase(oldObj->getId());
-				}
-				levelObjects.erase(it);
-				break;
-			}
+			return nullptr;
 		}
-		clearCache(obj);
-		return oldObj;
+		return std::static_pointer_cast<T>(eraseLevelObject(handle));
 	}
 
 	LevelObject* parseLevelObjectIdOrMapPosition(
@@ -140,21 +160,32 @@ private:
 
 	void setLevelDrawablePosition(LevelDrawable& obj, Panel& panelObj);
 	void updateDrawables(Game& game);
+	// sets the object under the mouse as the hover object (after the objects are updated).
+	void updateHover(Game& game);
 	void updateLevelObjectPositions();
+	// adds obj to this tick's updates, if it isn't already.
+	void queueLevelObjectUpdate(LevelObject& obj);
+	// updates the current player, the Always and awake objects and the
+	// NearView objects in the active region (view plus ActiveRegionMargin).
+	void updateLevelObjects(Game& game);
 	void updateMouse(const Game& game);
 	void updateTilesetLayersVisibleArea();
 	void updateZoom(const Game& game);
+	// call before freeing layers or textures the render thread can be drawing.
+	void waitForRenderThread() const;
 
 	void onMouseButtonPressed(Game& game);
 	void onMouseScrolled(Game& game);
 	void onTouchBegan(Game& game);
 
-	friend void Save::save(const std::string_view filePath,
+	friend bool Save::save(const std::string_view filePath,
 		Save::Properties& props, const Game& game, const Level& level);
 	friend void Save::serialize(void* serializeObj,
 		Save::Properties& props, const Game& game, const Level& level);
 
 public:
+	~Level() { waitForRenderThread(); }
+
 	void Init(const Game& game, LevelMap map_,
 		const std::vector<LevelLayer>& levelLayers_,
 		int32_t tileWidth, int32_t tileHeight, int32_t indexToDrawObjects);
@@ -175,6 +206,7 @@ public:
 	Panel* getDrawable(size_t idx) const;
 	LevelDrawable* getLevelDrawable(const std::string& id);
 	size_t getItemCount() const noexcept { return drawables.size(); }
+	size_t getLevelObjectCount() const noexcept { return levelObjects.size(); }
 
 	Misc::Helper2D<const Level, const LevelCell&, int32_t> operator[] (int32_t x) const noexcept
 	{
@@ -206,64 +238,38 @@ public:
 	void clearAllLevelObjects();
 
 	template <class T>
-	void clearLevelObjects()
+	void clearLevelObjects(const std::vector<std::string>& excludeIds)
 	{
-		auto it = levelObjects.begin();
-		while (it != levelObjects.end())
+		// backwards, each removed object is replaced by the last one
+		for (auto i = levelObjects.size(); i > 0; i--)
 		{
-			if (dynamic_cast<T*>(it->get()) != nullptr)
+			const auto& obj = levelObjects[i - 1];
+			if (obj->is<T>() == false ||
+				std::find(excludeIds.begin(), excludeIds.end(),
+					obj->getId()) != excludeIds.end())
 			{
-				const auto& mapPos = (*it)->MapPosition();
-				if (map.isMapCoordValid(mapPos) == true)
-				{
-					map[mapPos].removeObject(it->get());
-				}
-				if ((*it)->getId().empty() == false)
-				{
-					levelObjectIds.erase((*it)->getId());
-				}
-				clearCache(it->get());
-				it = levelObjects.erase(it);
+				continue;
 			}
-			else
+			const auto& mapPos = obj->MapPosition();
+			if (map.isMapCoordValid(mapPos) == true)
 			{
-				++it;
+				map[mapPos].removeObject(obj.get());
 			}
+			eraseLevelObject(levelObjects.getHandle(i - 1));
 		}
 	}
 
 	template <class T>
-	void clearLevelObjects(const std::vector<std::string>& excludeIds)
+	void clearLevelObjects()
 	{
-		auto it = levelObjects.begin();
-		while (it != levelObjects.end())
-		{
-			if (dynamic_cast<T*>(it->get()) != nullptr
-				&& std::find(excludeIds.begin(), excludeIds.end(),
-				(*it)->getId()) == excludeIds.end())
-			{
-				const auto& mapPos = (*it)->MapPosition();
-				if (map.isMapCoordValid(mapPos) == true)
-				{
-					map[mapPos].removeObject(it->get());
-				}
-				if ((*it)->getId().empty() == false)
-				{
-					levelObjectIds.erase((*it)->getId());
-				}
-				it = levelObjects.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+		clearLevelObjects<T>({});
 	}
 
 	template <class T>
 	T* getLevelObject(const std::string id) const
 	{
-		return dynamic_cast<T*>(getLevelObject(id));
+		auto obj = getLevelObject(id);
+		return obj != nullptr ? obj->as<T>() : nullptr;
 	}
 
 	LevelObject* getLevelObject(const std::string id) const;
@@ -318,11 +324,18 @@ public:
 
 	const PairFloat& getClickedMapPosition() const noexcept { return clickedMapPosition; }
 
-	LevelObject* getClickedObject() const noexcept { return clickedObject.lock().get(); }
-	void setClickedObject(std::weak_ptr<LevelObject> object) noexcept { clickedObject = object; }
+	// nullptr if the object was removed from the level.
+	LevelObject* getLevelObject(const SlotMapHandle& handle) const noexcept
+	{
+		auto obj = levelObjects.get(handle);
+		return obj != nullptr ? obj->get() : nullptr;
+	}
 
-	LevelObject* getHoverObject() const noexcept { return hoverObject.lock().get(); }
-	void setHoverObject(std::weak_ptr<LevelObject> object) noexcept { hoverObject = object; }
+	LevelObject* getClickedObject() const noexcept { return getLevelObject(clickedObject); }
+	void setClickedObject(const SlotMapHandle& handle) noexcept { clickedObject = handle; }
+
+	LevelObject* getHoverObject() const noexcept { return getLevelObject(hoverObject); }
+	void setHoverObject(const SlotMapHandle& handle) noexcept { hoverObject = handle; }
 
 	virtual std::shared_ptr<Action> getAction(uint16_t nameHash16) const noexcept;
 	virtual bool setAction(uint16_t nameHash16, const std::shared_ptr<Action>& action) noexcept;
@@ -359,6 +372,11 @@ public:
 
 	void addLevelObject(std::shared_ptr<LevelObject> obj);
 
+	// updates obj (from the next tick) until it can sleep, even if it isn't
+	// near the view. used for wake events (moved, damaged, changed by actions).
+	// does nothing if obj isn't in this level or its UpdateClass is Never.
+	void wakeLevelObject(LevelObject& obj);
+
 	// Deletes level object by id. If id is empty, no action is performed.
 	void deleteLevelObjectById(const std::string_view id);
 
@@ -421,10 +439,15 @@ public:
 	InputEventType getCaptureInputEvents() const noexcept { return captureInputEvents; }
 	void setCaptureInputEvents(InputEventType e) noexcept { captureInputEvents = e; }
 
-	void save(const std::string_view filePath,
+	bool save(const std::string_view filePath,
 		Save::Properties& props, const Game& game) const
 	{
-		Save::save(filePath, props, game, *this);
+		return Save::save(filePath, props, game, *this);
+	}
+	void saveAsync(const std::string_view filePath, Save::Properties& props,
+		Game& game, std::function<void(bool)> onComplete) const
+	{
+		Save::saveAsync(filePath, props, game, *this, std::move(onComplete));
 	}
 	virtual void serialize(void* serializeObj,
 		Save::Properties& props, const Game& game, const Level& level)
@@ -434,6 +457,11 @@ public:
 
 	virtual void draw(const Game& game, sf::RenderTarget& target) const;
 	virtual void update(Game& game);
+
+	// with a fixed simulation tick, moves the level objects and the view
+	// between the last two ticks (alpha is in [0, 1]) before drawing.
+	void interpolate(Game& game, float alpha);
+
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
 	virtual const Queryable* getQueryable(const std::string_view prop) const;
 
@@ -115,11 +115,21 @@ LevelObject* LevelCell::front() const
 	return nullptr;
 }
 
+void LevelCell::updateObjectTypes() noexcept
+{
+	objectTypes = 0;
+	for (const auto obj : objects)
+	{
+		objectTypes |= obj->getTypeMask();
+	}
+}
+
 void LevelCell::addFront(LevelObject* obj)
 {
 	if (std::find(objects.begin(), objects.end(), obj) == objects.end())
 	{
 		objects.insert(objects.begin(), obj);
+		objectTypes |= obj->getTypeMask();
 	}
 }
 
@@ -128,6 +138,7 @@ void LevelCell::addBack(LevelObject* obj)
 	if (std::find(objects.begin(), objects.end(), obj) == objects.end())
 	{
 		objects.push_back(obj);
+		objectTypes |= obj->getTypeMask();
 	}
 }
 
@@ -138,6 +149,7 @@ bool LevelCell::removeObject(const LevelObject* obj)
 		if (*it == obj)
 		{
 			objects.erase(it);
+			updateObjectTypes();
 			return true;
 		}
 	}
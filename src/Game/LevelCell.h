@@ -15,10 +15,14 @@ public:
 private:
 	std::array<int16_t, NumberOfLayers> tileIndexes{ -1, -1, -1, -1,- 1, -1, -1, 0 };
 	std::vector<LevelObject*> objects;
+	// types of the objects in this cell
+	LevelObjectTypeMask objectTypes{ 0 };
 	uint8_t defaultLight{ 0 };
 	uint8_t currentLight{ 0 };
 	std::vector<uint8_t> lights;
 
+	void updateObjectTypes() noexcept;
+
 public:
 	LevelCell() {}
 	LevelCell(int16_t defaultTileLayer1)
@@ -67,12 +71,22 @@ public:
 
 	bool hasObjects() const noexcept { return objects.empty() == false; }
 
+	template <class T>
+	bool hasObject() const noexcept
+	{
+		return (objectTypes & getLevelObjectTypeMask<T>()) != 0;
+	}
+
 	template <class T>
 	T* getObject() const noexcept
 	{
+		if (hasObject<T>() == false)
+		{
+			return nullptr;
+		}
 		for (const auto object : objects)
 		{
-			const auto castObj = dynamic_cast<T*>(object);
+			const auto castObj = object->as<T>();
 			if (castObj != nullptr)
 			{
 				return castObj;
@@ -88,12 +102,17 @@ public:
 	template <class T>
 	T* removeObject()
 	{
+		if (hasObject<T>() == false)
+		{
+			return nullptr;
+		}
 		for (auto it = objects.begin(); it != objects.end(); ++it)
 		{
-			auto oldObj = dynamic_cast<T*>(*it);
+			auto oldObj = (*it)->as<T>();
 			if (oldObj != nullptr)
 			{
 				objects.erase(it);
+				updateObjectTypes();
 				return oldObj;
 			}
 		}
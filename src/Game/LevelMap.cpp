@@ -1,5 +1,7 @@
 #include "LevelMap.h"
+#include "FrameProfiler.h"
 #include "PathFinder.h"
+#include "PerfCounters.h"
 #include "Utils/EasingFunctions.h"
 
 LevelMap::LevelMap(const std::string_view tilFileName, const std::string_view solFileName,
@@ -229,6 +231,8 @@ void LevelMap::initLights()
 
 void LevelMap::updateLights()
 {
+	PROFILE_SCOPE("LevelMap::updateLights");
+
 	if (pendingLights.empty() == true)
 	{
 		return;
@@ -440,9 +444,12 @@ bool LevelMap::removeLevelObject(const LevelObject* obj)
 	return obj->remove(*this);
 }
 
-std::vector<PairFloat> LevelMap::getPath(const PairFloat& a, const PairFloat& b) const
+FrameVector<PairFloat> LevelMap::getPath(const PairFloat& a, const PairFloat& b) const
 {
-	std::vector<PairFloat> path;
+	PROFILE_SCOPE("LevelMap::getPath");
+	PerfCounters::add(PerfCounters::Counter::PathSearches);
+
+	FrameVector<PairFloat> path;
 
 	if (a == b)
 	{
@@ -8,6 +8,7 @@
 #include "PairXY.h"
 #include "Sol.h"
 #include "TileSet.h"
+#include "Utils/FrameArena.h"
 #include "Utils/Helper2D.h"
 #include <vector>
 
@@ -125,6 +126,7 @@ public:
 
 	void initLights();
 	void updateLights();
+	size_t getPendingLightCount() const noexcept { return pendingLights.size(); }
 
 	// sets area (tileBlock Dun file) for layer 0 and uses the Sol file to set the Sol layer.
 	void setTileSetAreaUseSol(int32_t x, int32_t y, const Dun& dun);
@@ -205,7 +207,8 @@ public:
 		return nullptr;
 	}
 
-	std::vector<PairFloat> getPath(const PairFloat& a, const PairFloat& b) const;
+	// the path is only valid during the current frame (see FrameArena).
+	FrameVector<PairFloat> getPath(const PairFloat& a, const PairFloat& b) const;
 
 	std::string toCSV(bool zeroBasedIndex) const;
 };
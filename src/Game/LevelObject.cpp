@@ -1,4 +1,5 @@
 #include "LevelObject.h"
+#include <cmath>
 #include "Game.h"
 #include "Game/Level.h"
 
@@ -75,7 +76,7 @@ void LevelObject::updateDrawPosition(const LevelMap& map, const PairFloat& mapPo
 	updateSpriteDrawPosition();
 }
 
-void LevelObject::updateSpriteDrawPosition()
+sf::Vector2f LevelObject::getSpriteDrawPosition() const
 {
 	auto drawPosition = basePosition;
 	if (absoluteOffset == false)
@@ -84,10 +85,27 @@ void LevelObject::updateSpriteDrawPosition()
 		drawPosition.x += -(float)(textureRect.width / 2);
 		drawPosition.y += -((float)textureRect.height) + tileBlockHeight;
 	}
-	sprite.setPosition(drawPosition);
+	return drawPosition;
+}
+
+void LevelObject::updateSpriteDrawPosition()
+{
+	sprite.setPosition(getSpriteDrawPosition());
 }
 
-PairFloat LevelObject::getCenterMapPosition(const PairFloat& mapPos)
+void LevelObject::interpolate(float alpha)
+{
+	// offset from the current position back towards the previous one
+	auto offset = (prevBasePosition - basePosition) * (1.f - alpha);
+	if (std::abs(offset.x) > MaxInterpolationDistance ||
+		std::abs(offset.y) > MaxInterpolationDistance)
+	{
+		offset = {};
+	}
+	sprite.setPosition(getSpriteDrawPosition() + offset);
+}
+
+PairFloat LevelObject::getCenterMapPosition(const PairFloat& mapPos) const
 {
 	PairFloat minMapPosition;
 	PairFloat maxMapPosition;
@@ -100,7 +118,7 @@ PairFloat LevelObject::getCenterMapPosition(const PairFloat& mapPos)
 }
 
 void LevelObject::getMinMaxMapPosition(const PairFloat& mapPos,
-	PairFloat& minMapPos, PairFloat& maxMapPos)
+	PairFloat& minMapPos, PairFloat& maxMapPos) const
 {
 	minMapPos = mapPos;
 	maxMapPos = mapPos;
@@ -122,64 +140,55 @@ void LevelObject::getMinMaxMapPosition(const PairFloat& mapPos,
 	}
 }
 
-void LevelObject::updateHover(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr)
+sf::FloatRect LevelObject::getHoverBounds(const LevelMap& map) const
 {
-	if (enableHover == false || level.EnableHover() == false)
-	{
-		return;
-	}
-	bool objHovered = level.HasMouseInside() == true;
 	if (cellSize.x == 0 || cellSize.y == 0)
 	{
-		objHovered = objHovered &&
-			(sprite.getGlobalBounds().contains(level.MousePositionf()) == true);
+		return sprite.getGlobalBounds();
 	}
-	else
-	{
-		PairFloat minMapPosition;
-		PairFloat maxMapPosition;
-		getMinMaxMapPosition(mapPosition, minMapPosition, maxMapPosition);
+	PairFloat minMapPosition;
+	PairFloat maxMapPosition;
+	getMinMaxMapPosition(mapPosition, minMapPosition, maxMapPosition);
 
-		auto mouseMapCoord = level.getMapCoordOverMouse();
+	// mouse map coordinates are rounded and offset by one block (Level::updateMouse)
+	minMapPosition.x -= 0.5f;
+	minMapPosition.y -= 0.5f;
+	maxMapPosition.x += 0.5f;
+	maxMapPosition.y += 0.5f;
+	auto left = map.toDrawCoord(PairFloat(minMapPosition.x, maxMapPosition.y)).x;
+	auto right = map.toDrawCoord(PairFloat(maxMapPosition.x, minMapPosition.y)).x;
+	auto top = map.toDrawCoord(minMapPosition).y;
+	auto bottom = map.toDrawCoord(maxMapPosition).y;
+	return sf::FloatRect(
+		left + (float)map.DefaultBlockWidth() - 1.f,
+		top + (float)map.DefaultBlockHeight() - 1.f,
+		right - left + 2.f,
+		bottom - top + 2.f
+	);
+}
 
-		objHovered = objHovered &&
-			(mouseMapCoord.x <= maxMapPosition.x &&
-				mouseMapCoord.x >= minMapPosition.x &&
-				mouseMapCoord.y <= maxMapPosition.y &&
-				mouseMapCoord.y >= minMapPosition.y);
-	}
-	if (objHovered == true)
+bool LevelObject::isMouseOver(const sf::Vector2f& mousePos, const PairFloat& mouseMapCoord) const
+{
+	if (cellSize.x == 0 || cellSize.y == 0)
 	{
-		if (level.getClickedObject() == nullptr)
-		{
-			level.setClickedObject(thisPtr);
-		}
-		if (hovered == false)
-		{
-			hovered = true;
-			if (outlineOnHover == true)
-			{
-				sprite.setOutlineEnabled(true);
-			}
-			level.setHoverObject(thisPtr);
-			level.executeHoverEnterAction(game);
-		}
+		return sprite.contains(mousePos);
 	}
-	else
+	PairFloat minMapPosition;
+	PairFloat maxMapPosition;
+	getMinMaxMapPosition(mapPosition, minMapPosition, maxMapPosition);
+
+	return (mouseMapCoord.x <= maxMapPosition.x &&
+		mouseMapCoord.x >= minMapPosition.x &&
+		mouseMapCoord.y <= maxMapPosition.y &&
+		mouseMapCoord.y >= minMapPosition.y);
+}
+
+void LevelObject::Hovered(bool hovered_)
+{
+	hovered = hovered_;
+	if (outlineOnHover == true)
 	{
-		if (hovered == true)
-		{
-			hovered = false;
-			if (outlineOnHover == true)
-			{
-				sprite.setOutlineEnabled(false);
-			}
-			if (level.getHoverObject() == this)
-			{
-				level.setHoverObject({});
-				level.executeHoverLeaveAction(game);
-			}
-		}
+		sprite.setOutlineEnabled(hovered_);
 	}
 }
 
@@ -199,6 +208,7 @@ bool LevelObject::MapPosition(LevelMap& map, const PairFloat& pos)
 
 bool LevelObject::MapPosition(Level& level, const PairFloat& pos)
 {
+	level.wakeLevelObject(*this);
 	return MapPosition(level.Map(), pos);
 }
 
@@ -209,6 +219,7 @@ bool LevelObject::move(LevelMap& map, const PairFloat& pos)
 
 bool LevelObject::move(Level& level, const PairFloat& pos)
 {
+	level.wakeLevelObject(*this);
 	return move(level.Map(), pos);
 }
 
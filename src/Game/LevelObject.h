@@ -9,19 +9,60 @@
 #include "Save/SaveProperties.h"
 #include "SFML/CompositeSprite.h"
 #include <string_view>
+#include <type_traits>
+#include "Utils/SlotMap.h"
 #include "Variable.h"
 
 class Game;
 class Level;
 class LevelMap;
+class LevelObject;
+
+// concrete type of a level object, used to filter level objects without RTTI.
+enum class LevelObjectType : uint8_t
+{
+	Item,
+	Player,
+	SimpleLevelObject
+};
+
+// one bit per LevelObjectType.
+typedef uint8_t LevelObjectTypeMask;
+
+constexpr LevelObjectTypeMask toTypeMask(LevelObjectType type) noexcept
+{
+	return (LevelObjectTypeMask)(1u << (uint8_t)type);
+}
+
+// mask of the types that are a T (all of them for LevelObject).
+template <class T>
+constexpr LevelObjectTypeMask getLevelObjectTypeMask() noexcept
+{
+	if constexpr (std::is_same_v<std::remove_const_t<T>, LevelObject> == true)
+	{
+		return (LevelObjectTypeMask)~0u;
+	}
+	else
+	{
+		return toTypeMask(T::TypeTag);
+	}
+}
 
 class LevelObject : public Queryable
 {
 protected:
 	const LevelObjectClass* class_{ nullptr };
+	LevelObjectType typeTag;
+	// handle in the level's object storage. invalid if not in a level.
+	SlotMapHandle levelHandle;
+	// update scheduling state (set by the level)
+	uint32_t updateTick{ 0 };
+	bool awake{ false };
 
 	CompositeSprite sprite;
 	sf::Vector2f basePosition;
+	// base position at the start of the current simulation tick
+	sf::Vector2f prevBasePosition;
 	sf::Vector2f anchorPosition;
 	bool absoluteOffset{ false };
 	float tileBlockHeight{ 0.f };
@@ -39,21 +80,24 @@ protected:
 
 	std::string id;
 
+	// in pixels, per tick
+	static constexpr float MaxInterpolationDistance = 128.f;
+
 	// gets common getProperty properties;
 	bool getLevelObjProp(const uint16_t propHash16,
 		const std::string_view prop, Variable& var) const;
 
-	PairFloat getCenterMapPosition(const PairFloat& mapPos);
+	PairFloat getCenterMapPosition(const PairFloat& mapPos) const;
 
 	void getMinMaxMapPosition(const PairFloat& mapPos,
-		PairFloat& minMapPos, PairFloat& maxMapPos);
+		PairFloat& minMapPos, PairFloat& maxMapPos) const;
 
 	bool hasValidState() const noexcept;
 	bool getCurrentTexture(TextureInfo& ti) const;
 	void updateDrawPosition(const LevelMap& map);
 	void updateDrawPosition(const LevelMap& map, const PairFloat& mapPos);
+	sf::Vector2f getSpriteDrawPosition() const;
 	void updateSpriteDrawPosition();
-	void updateHover(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr);
 	bool updateMapPositionBack(LevelMap& map, const PairFloat pos);
 	bool updateMapPositionFront(LevelMap& map, const PairFloat pos);
 
@@ -65,13 +109,21 @@ protected:
 	void MapPosition(const PairFloat& pos) noexcept { mapPosition = pos; }
 
 public:
-	LevelObject(const LevelObjectClass* class__) : class_(class__) {}
+	LevelObject(const LevelObjectClass* class__, LevelObjectType typeTag_)
+		: class_(class__), typeTag(typeTag_) {}
 	virtual ~LevelObject() = default;
 
 	const sf::Vector2f& getBasePosition() const noexcept { return basePosition; }
 	const sf::Vector2f& getAnchorPosition() const noexcept { return anchorPosition; }
 	bool updateTexture();
 
+	// called by the level before each (fixed) simulation tick.
+	void beginTick() noexcept { prevBasePosition = basePosition; }
+
+	// moves the sprite between the last two simulated positions
+	// (alpha is in [0, 1]). large jumps (teleports) aren't interpolated.
+	void interpolate(float alpha);
+
 	const sf::Vector2f& Position() const { return sprite.getPosition(); }
 	sf::Vector2f Size() const { return sprite.getSize(); }
 	const PairFloat& MapPosition() const noexcept { return mapPosition; }
@@ -103,6 +155,17 @@ public:
 	bool Hoverable() const noexcept { return enableHover; }
 	void Hoverable(bool hoverable) noexcept { enableHover = hoverable; }
 
+	// draw space rect that contains the hover area (see LevelPickGrid).
+	sf::FloatRect getHoverBounds(const LevelMap& map) const;
+
+	// objects with a cell size are hovered by map position, the others by
+	// sprite (per pixel, if the texture pack has alpha masks).
+	bool isMouseOver(const sf::Vector2f& mousePos, const PairFloat& mouseMapCoord) const;
+
+	// set by the level.
+	bool Hovered() const noexcept { return hovered; }
+	void Hovered(bool hovered_);
+
 	void setColor(const sf::Color& color) { sprite.setColor(color); }
 	void setOutline(const sf::Color& outline, const sf::Color& ignore) noexcept
 	{
@@ -118,16 +181,44 @@ public:
 	const std::string& getId() const { return id; }
 	const std::string& getClassId() const { return class_->Id(); }
 	virtual const std::string_view getType() const = 0;
+	LevelObjectType getTypeTag() const noexcept { return typeTag; }
+	LevelObjectTypeMask getTypeMask() const noexcept { return toTypeMask(typeTag); }
+
+	template <class T>
+	bool is() const noexcept { return (getLevelObjectTypeMask<T>() & getTypeMask()) != 0; }
+
+	// this object as a T or nullptr if it isn't one.
+	template <class T>
+	T* as() noexcept { return is<T>() == true ? static_cast<T*>(this) : nullptr; }
+
+	template <class T>
+	const T* as() const noexcept { return is<T>() == true ? static_cast<const T*>(this) : nullptr; }
+
+	const SlotMapHandle& getLevelHandle() const noexcept { return levelHandle; }
+	// set by the level when the object is added or removed.
+	void setLevelHandle(const SlotMapHandle& handle) noexcept { levelHandle = handle; }
+
+	UpdateClass getUpdateClass() const noexcept { return class_->getUpdateClass(); }
+
+	// awake objects are updated (even if not near the view)
+	// until they can sleep (no pending actions, movement or animations).
+	virtual bool canSleep() const noexcept { return queuedActions.empty(); }
+
+	// set by the level.
+	bool Awake() const noexcept { return awake; }
+	void Awake(bool awake_) noexcept { awake = awake_; }
+	// last level update tick this object was updated in.
+	uint32_t UpdateTick() const noexcept { return updateTick; }
+	void UpdateTick(uint32_t updateTick_) noexcept { updateTick = updateTick_; }
 
 	// serialize this object.
-	// serializeObj - currently is a RapidJson writer class
+	// serializeObj - a Save::Writer (json or binary)
 	virtual void serialize(void* serializeObj, Save::Properties& props,
 		const Game& game, const Level& level) const = 0;
 
-	void draw(sf::RenderTarget& target, sf::Shader* spriteShader,
-		SpriteShaderCache& cache, uint8_t light) const
+	void record(DrawCommandList& commands, sf::Shader* spriteShader, uint8_t light) const
 	{
-		sprite.draw(target, spriteShader, cache, light);
+		sprite.record(commands, spriteShader, light);
 	}
 
 	// Update
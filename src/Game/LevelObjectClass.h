@@ -1,12 +1,26 @@
 #pragma once
 
 #include "Actions/Action.h"
+#include <cstdint>
 #include "LightSource.h"
 #include <memory>
 #include <SFML/System/Vector2.hpp>
 #include "Utils/Utils.h"
 #include <vector>
 
+// when the level updates the objects of a class.
+enum class UpdateClass : uint8_t
+{
+	// every frame
+	Always,
+	// while near the view or awake
+	NearView,
+	// while awake (after being added, moved or changed by an action)
+	EventDriven,
+	// not updated (only drawn)
+	Never
+};
+
 class LevelObjectClass
 {
 protected:
@@ -17,6 +31,7 @@ protected:
 
 	LightSource lightSource;
 	sf::Vector2f anchorOffset;
+	UpdateClass updateClass{ UpdateClass::NearView };
 
 public:
 	virtual ~LevelObjectClass() = default;
@@ -38,4 +53,7 @@ public:
 
 	const sf::Vector2f& getAnchorOffset() const noexcept { return anchorOffset; }
 	void setAnchorOffset(const sf::Vector2f& offset_) noexcept { anchorOffset = offset_; }
+
+	UpdateClass getUpdateClass() const noexcept { return updateClass; }
+	void setUpdateClass(UpdateClass updateClass_) noexcept { updateClass = updateClass_; }
 };
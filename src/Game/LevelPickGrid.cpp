@@ -0,0 +1,161 @@
+#include "LevelPickGrid.h"
+#include <algorithm>
+#include "LevelMap.h"
+#include "LevelObject.h"
+
+// objects are drawn by map position (x, then y) and by their order in the cell.
+// returns true if a is drawn after (in front of) b.
+static bool isDrawnAfter(const LevelMap& map, const LevelObject* a, const LevelObject* b)
+{
+	const auto& posA = a->MapPosition();
+	const auto& posB = b->MapPosition();
+	if (posA.x != posB.x)
+	{
+		return posA.x > posB.x;
+	}
+	if (posA.y != posB.y)
+	{
+		return posA.y > posB.y;
+	}
+	for (const auto obj : map[posA])
+	{
+		if (obj == a)
+		{
+			return false;
+		}
+		if (obj == b)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+PairInt32 LevelPickGrid::toCell(float x, float y) const noexcept
+{
+	return PairInt32(
+		std::clamp((int32_t)((x - origin.x) / CellSize), 0, gridSize.x - 1),
+		std::clamp((int32_t)((y - origin.y) / CellSize), 0, gridSize.y - 1)
+	);
+}
+
+void LevelPickGrid::addToCells(LevelObject* obj, const Entry& entry)
+{
+	for (auto y = entry.startCell.y; y <= entry.endCell.y; y++)
+	{
+		for (auto x = entry.startCell.x; x <= entry.endCell.x; x++)
+		{
+			cells[(size_t)y * gridSize.x + x].push_back(obj);
+		}
+	}
+}
+
+void LevelPickGrid::removeFromCells(const LevelObject* obj, const Entry& entry)
+{
+	for (auto y = entry.startCell.y; y <= entry.endCell.y; y++)
+	{
+		for (auto x = entry.startCell.x; x <= entry.endCell.x; x++)
+		{
+			auto& cell = cells[(size_t)y * gridSize.x + x];
+			auto it = std::find(cell.begin(), cell.end(), obj);
+			if (it != cell.end())
+			{
+				*it = cell.back();
+				cell.pop_back();
+			}
+		}
+	}
+}
+
+void LevelPickGrid::init(const LevelMap& map)
+{
+	// isometric map, the corners are the left, right, top and bottom points
+	auto mapSize = map.MapSizef();
+	origin.x = map.toDrawCoord(PairFloat(0.f, mapSize.y)).x;
+	origin.y = map.toDrawCoord(PairFloat(0.f, 0.f)).y;
+	auto right = map.toDrawCoord(PairFloat(mapSize.x, 0.f)).x;
+	auto bottom = map.toDrawCoord(mapSize).y;
+
+	gridSize.x = std::max((int32_t)((right - origin.x) / CellSize) + 1, 1);
+	gridSize.y = std::max((int32_t)((bottom - origin.y) / CellSize) + 1, 1);
+
+	entries.clear();
+	cells.clear();
+	cells.resize((size_t)gridSize.x * gridSize.y);
+}
+
+void LevelPickGrid::clear()
+{
+	entries.clear();
+	for (auto& cell : cells)
+	{
+		cell.clear();
+	}
+}
+
+void LevelPickGrid::update(LevelObject& obj, const LevelMap& map)
+{
+	if (cells.empty() == true)
+	{
+		return;
+	}
+	if (obj.Hoverable() == false ||
+		map.isMapCoordValid(obj.MapPosition()) == false)
+	{
+		remove(&obj);
+		return;
+	}
+	auto bounds = obj.getHoverBounds(map);
+	auto it = entries.find(&obj);
+	if (it != entries.end() && it->second.bounds == bounds)
+	{
+		return;
+	}
+	auto startCell = toCell(bounds.left, bounds.top);
+	auto endCell = toCell(bounds.left + bounds.width, bounds.top + bounds.height);
+	if (it == entries.end())
+	{
+		it = entries.insert(std::make_pair(&obj, Entry{ bounds, startCell, endCell })).first;
+		addToCells(&obj, it->second);
+		return;
+	}
+	auto& entry = it->second;
+	entry.bounds = bounds;
+	if (entry.startCell != startCell || entry.endCell != endCell)
+	{
+		removeFromCells(&obj, entry);
+		entry.startCell = startCell;
+		entry.endCell = endCell;
+		addToCells(&obj, entry);
+	}
+}
+
+void LevelPickGrid::remove(const LevelObject* obj)
+{
+	auto it = entries.find(obj);
+	if (it != entries.end())
+	{
+		removeFromCells(obj, it->second);
+		entries.erase(it);
+	}
+}
+
+LevelObject* LevelPickGrid::pick(const LevelMap& map,
+	const sf::Vector2f& mousePos, const PairFloat& mouseMapCoord) const
+{
+	if (cells.empty() == true)
+	{
+		return nullptr;
+	}
+	auto cellPos = toCell(mousePos.x, mousePos.y);
+	LevelObject* frontObj = nullptr;
+	for (const auto obj : cells[(size_t)cellPos.y * gridSize.x + cellPos.x])
+	{
+		if (obj->isMouseOver(mousePos, mouseMapCoord) == true &&
+			(frontObj == nullptr || isDrawnAfter(map, obj, frontObj) == true))
+		{
+			frontObj = obj;
+		}
+	}
+	return frontObj;
+}
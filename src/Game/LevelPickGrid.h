@@ -0,0 +1,52 @@
+#pragma once
+
+#include "PairXY.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <unordered_map>
+#include <vector>
+
+class LevelMap;
+class LevelObject;
+
+// uniform grid over the draw space of a level with the hoverable level objects
+// in the cells their hover bounds overlap. the level updates it after each
+// object update (objects are only moved between cells when their bounds change)
+// and picks the object under the mouse with one query per frame.
+class LevelPickGrid
+{
+private:
+	struct Entry
+	{
+		sf::FloatRect bounds;
+		// first and last cell overlapped by bounds
+		PairInt32 startCell;
+		PairInt32 endCell;
+	};
+
+	std::unordered_map<const LevelObject*, Entry> entries;
+	std::vector<std::vector<LevelObject*>> cells;
+	sf::Vector2f origin;
+	PairInt32 gridSize;
+
+	// in pixels
+	static constexpr float CellSize = 128.f;
+
+	// clamped to the grid, so objects outside the map are still found.
+	PairInt32 toCell(float x, float y) const noexcept;
+
+	void addToCells(LevelObject* obj, const Entry& entry);
+	void removeFromCells(const LevelObject* obj, const Entry& entry);
+
+public:
+	// sizes the grid to the draw space of the map and removes all objects.
+	void init(const LevelMap& map);
+	void clear();
+
+	// adds or moves the object. removes it if it can't be hovered.
+	void update(LevelObject& obj, const LevelMap& map);
+	void remove(const LevelObject* obj);
+
+	// the object drawn in front under the mouse (level coordinates), if any.
+	LevelObject* pick(const LevelMap& map,
+		const sf::Vector2f& mousePos, const PairFloat& mouseMapCoord) const;
+};
@@ -2,6 +2,8 @@
 #include <cmath>
 #include "Game.h"
 #include "Panel.h"
+#include "RenderThread.h"
+#include <SFML/OpenGL.hpp>
 #include "Utils/Utils.h"
 
 Anchor LevelSurface::getAnchor() const noexcept
@@ -83,14 +85,72 @@ void LevelSurface::recreateRenderTexture(bool smoothTexture)
 
 void LevelSurface::recreateRenderTexture(unsigned newWidth, unsigned newHeight, bool smoothTexture)
 {
-	auto texSize = texture.getSize();
+	auto texSize = textures[frontTexture].getSize();
 	if (texSize.x != newWidth || texSize.y != newHeight)
 	{
-		texture.create(newWidth, newHeight);
-		texture.setSmooth(smoothTexture);
-		texture.setRepeated(true);
-		sprite.setTexture(&texture.getTexture(), true);
+		waitForRenderThread();
+		for (auto& texture : textures)
+		{
+			// the back texture is only created when a render thread is used
+			if (&texture != &textures[frontTexture] &&
+				texture.getSize().x == 0)
+			{
+				continue;
+			}
+			texture.create(newWidth, newHeight);
+			texture.setSmooth(smoothTexture);
+			texture.setRepeated(true);
+		}
+		sprite.setTexture(&textures[frontTexture].getTexture(), true);
+	}
+}
+
+sf::RenderTexture& LevelSurface::mainThreadTexture() const noexcept
+{
+	if (renderThread == nullptr)
+	{
+		return textures[frontTexture];
+	}
+	return backTexture();
+}
+
+void LevelSurface::createBackTexture() const
+{
+	const auto& front = textures[frontTexture];
+	auto& back = backTexture();
+	if (back.getSize() != front.getSize())
+	{
+		back.create(front.getSize().x, front.getSize().y);
+		back.setSmooth(front.isSmooth());
+		back.setRepeated(true);
+	}
+}
+
+void LevelSurface::waitForRenderThread() const
+{
+	if (renderTicket == 0)
+	{
+		return;
+	}
+	renderThread->wait(renderTicket);
+	renderTicket = 0;
+
+	// the rendered frame is the one drawn from now on
+	frontTexture = 1 - frontTexture;
+	sprite.setTexture(&textures[frontTexture].getTexture());
+}
+
+void LevelSurface::flush() const
+{
+	if (renderingOnMainThread == false)
+	{
+		// after a direct draw, the rest of the frame is rendered here
+		waitForRenderThread();
+		createBackTexture();
+		renderingOnMainThread = true;
 	}
+	commands.submit(mainThreadTexture());
+	commands.clear();
 }
 
 void LevelSurface::updateVisibleArea()
@@ -105,21 +165,53 @@ void LevelSurface::updateVisibleArea()
 
 void LevelSurface::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	if (visible == true)
+	if (visible == false)
+	{
+		commands.clear();
+		return;
+	}
+	if (renderingOnMainThread == true)
 	{
-		texture.display();
-		target.draw(sprite, states);
+		flush();
+		mainThreadTexture().display();
+		if (renderThread != nullptr)
+		{
+			frontTexture = 1 - frontTexture;
+			sprite.setTexture(&textures[frontTexture].getTexture());
+		}
 	}
+	else
+	{
+		// draws the previous frame while this one is rendered
+		waitForRenderThread();
+		createBackTexture();
+		// the render thread's context must see the draws that used the back texture
+		glFlush();
+		renderTicket = renderThread->submit(commands, backTexture());
+	}
+	target.draw(sprite, states);
 }
 
 void LevelSurface::draw(const Game& game, const Panel& obj) const
 {
-	obj.draw(game, texture, visibleRect);
+	flush();
+	obj.draw(game, mainThreadTexture(), visibleRect);
 }
 
 void LevelSurface::draw(const sf::Drawable& obj) const
 {
-	texture.draw(obj);
+	flush();
+	mainThreadTexture().draw(obj);
+}
+
+void LevelSurface::draw(const sf::Sprite& obj) const
+{
+	commands.addSprite(obj, sf::BlendAlpha);
+}
+
+void LevelSurface::draw(const sf::FloatRect& rect, const sf::Color& color) const
+{
+	commands.addRectangle(rect, color);
 }
 
 void LevelSurface::init(const Game& game)
@@ -133,9 +225,16 @@ void LevelSurface::init(const Game& game)
 	recreateRenderTexture(game.SmoothScreen());
 }
 
-void LevelSurface::clear(const sf::Color& color) const
+void LevelSurface::clear(const sf::Color& color, RenderThread* renderThread_) const
 {
-	texture.clear(color);
+	if (renderThread != renderThread_)
+	{
+		waitForRenderThread();
+		renderThread = renderThread_;
+	}
+	commands.clear();
+	renderingOnMainThread = (renderThread == nullptr);
+	commands.addClear(color);
 }
 
 bool LevelSurface::updateZoom(const Game& game, float newZoom)
@@ -163,7 +262,7 @@ void LevelSurface::stretchSpriteToZoom(float zoom)
 {
 	if (zoom > 1.f)
 	{
-		auto size = texture.getSize();
+		auto size = textures[frontTexture].getSize();
 		if (supportsBigTextures == false)
 		{
 			sprite.setTextureRect({ 0, 0, (int)size.x, (int)size.y });
@@ -179,7 +278,7 @@ void LevelSurface::stretchSpriteToZoom(float zoom)
 	}
 	else
 	{
-		auto size = texture.getSize();
+		auto size = textures[frontTexture].getSize();
 		auto sizeDiffX = (size.x - drawView.getSize().x) / 2.f * zoom;
 		auto sizeDiffY = (size.y - drawView.getSize().y) / 2.f * zoom;
 		sf::IntRect textureRect(
@@ -216,7 +315,7 @@ void LevelSurface::updateView(const Game& game)
 
 void LevelSurface::updateDrawView() const
 {
-	texture.setView(drawView.getView());
+	commands.addView(drawView.getView());
 }
 
 void LevelSurface::updateDrawView(const sf::FloatRect& viewportOffset) const
@@ -224,7 +323,7 @@ void LevelSurface::updateDrawView(const sf::FloatRect& viewportOffset) const
 	if (viewportOffset == sf::FloatRect(0.f, 0.f, 0.f, 0.f) ||
 		mapView.getZoom() != 1.f)
 	{
-		texture.setView(drawView.getView());
+		commands.addView(drawView.getView());
 	}
 	else
 	{
@@ -244,6 +343,6 @@ void LevelSurface::updateDrawView(const sf::FloatRect& viewportOffset) const
 		float height = (newView.getSize().y / drawView.getSize().y);
 
 		newView.setViewport({ top, left, width, height });
-		texture.setView(newView);
+		commands.addView(newView);
 	}
 }
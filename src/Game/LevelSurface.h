@@ -4,16 +4,26 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
+#include "SFML/DrawCommandList.h"
 #include "SFML/View2.h"
 
 class Panel;
-struct SpriteShaderCache;
+class RenderThread;
 
 class LevelSurface
 {
 private:
-	sf::RectangleShape sprite;
-	mutable sf::RenderTexture texture;
+	mutable sf::RectangleShape sprite;
+	// with a render thread, one texture is drawn while the other one is rendered
+	mutable sf::RenderTexture textures[2];
+	mutable size_t frontTexture{ 0 };
+	// sprites are recorded and drawn in batches when the frame ends
+	// or before something is drawn directly (panels).
+	mutable DrawCommandList commands;
+	mutable RenderThread* renderThread{ nullptr };
+	mutable uint64_t renderTicket{ 0 };
+	// true if the current frame is rendered by the main thread
+	mutable bool renderingOnMainThread{ false };
 	View2 mapView{ true };
 	View2 drawView{ true };
 	bool supportsBigTextures{ false };
@@ -24,7 +34,17 @@ private:
 	void updateVisibleArea();
 	void stretchSpriteToZoom(float zoom);
 
+	sf::RenderTexture& backTexture() const noexcept { return textures[1 - frontTexture]; }
+	// the texture the main thread renders to
+	sf::RenderTexture& mainThreadTexture() const noexcept;
+	void createBackTexture() const;
+	// draws the recorded commands on the main thread.
+	void flush() const;
+
 public:
+	LevelSurface() = default;
+	~LevelSurface() { waitForRenderThread(); }
+
 	static constexpr float ZoomMin = 0.5f;
 	static constexpr float ZoomMax = 2.0f;
 
@@ -53,17 +73,24 @@ public:
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 	void draw(const Game& game, const Panel& obj) const;
 	void draw(const sf::Drawable& obj) const;
+	void draw(const sf::Sprite& obj) const;
+	void draw(const sf::FloatRect& rect, const sf::Color& color) const;
 
 	template <class T>
-	void draw(const T& obj, sf::Shader* spriteShader,
-		SpriteShaderCache& cache, uint8_t light = 255) const
+	void draw(const T& obj, sf::Shader* spriteShader, uint8_t light = 255) const
 	{
-		obj.draw(texture, spriteShader, cache, light);
+		obj.record(commands, spriteShader, light);
 	}
 
 	void init(const Game& game);
 
-	void clear(const sf::Color& color) const;
+	// waits for the frame submitted to the render thread, if any.
+	// call before freeing textures that frame can use.
+	void waitForRenderThread() const;
+
+	// starts a new frame. with a render thread, the frame is rendered
+	// on it and drawn one frame later.
+	void clear(const sf::Color& color, RenderThread* renderThread_ = nullptr) const;
 
 	// newZoom is inverted. numbers < 1 = zoom in and numbers > 1 = zoom out
 	bool updateZoom(const Game& game, float newZoom);
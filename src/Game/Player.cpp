@@ -4,7 +4,7 @@
 #include "Level.h"
 #include "Utils/Utils.h"
 
-Player::Player(const PlayerClass* class__, const Level& level) : LevelObject(class__)
+Player::Player(const PlayerClass* class__, const Level& level) : LevelObject(class__, TypeTag)
 {
 	animation.animType = AnimationType::Looped;
 	cellSize.x = -2;
@@ -118,14 +118,14 @@ void Player::updateWalkPath(Game& game, LevelMap& map)
 	}
 }
 
-void Player::setWalkPath(const std::vector<PairFloat>& walkPath_, bool doAction)
+void Player::setWalkPath(const FrameVector<PairFloat>& walkPath_, bool doAction)
 {
 	if (walkPath_.empty() == true ||
 		playerStatus == PlayerStatus::Dead)
 	{
 		return;
 	}
-	walkPath = walkPath_;
+	walkPath.assign(walkPath_.begin(), walkPath_.end());
 	executeActionOnDestination = doAction;
 	playerStatus = PlayerStatus::Walk;
 	if (walkPath.empty() == false)
@@ -180,7 +180,7 @@ void Player::Walk(const LevelMap& map, const PlayerDirection direction, bool doA
 		map.isMapCoordValid(b) == true &&
 		map[b].Passable() == true)
 	{
-		std::vector<PairFloat> path;
+		FrameVector<PairFloat> path;
 		path.push_back(b);
 		path.push_back(a);
 		setWalkPath(path, doAction);
@@ -389,8 +389,26 @@ void Player::update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr
 		updateDead(game, level);
 		break;
 	}
+}
 
-	updateHover(game, level, thisPtr);
+bool Player::canSleep() const noexcept
+{
+	if (LevelObject::canSleep() == false ||
+		walkPath.empty() == false)
+	{
+		return false;
+	}
+	switch (playerStatus)
+	{
+	case PlayerStatus::Stand:
+		// the next update sets the status to dead
+		return LifeNow() > 0;
+	case PlayerStatus::Dead:
+		return playerAnimation == PlayerAnimation::Die1 &&
+			animation.isAnimationAtEnd() == true;
+	default:
+		return false;
+	}
 }
 
 const std::string& Player::Name() const
@@ -589,15 +607,8 @@ bool Player::getProperty(const std::string_view prop, Variable& var) const
 	}
 	case str2int16("itemQuantity"):
 	{
-		auto classIdHash16 = str2int16(props.second);
 		uint32_t itemQuantity = 0;
-		if (itemQuantityCache.getValue(classIdHash16, itemQuantity) == false)
-		{
-			if (inventories.getQuantity(classIdHash16, itemQuantity) == true)
-			{
-				itemQuantityCache.updateValue(classIdHash16, itemQuantity);
-			}
-		}
+		inventories.getQuantity(str2int16(props.second), itemQuantity);
 		var = Variable((int64_t)itemQuantity);
 		break;
 	}
@@ -1135,30 +1146,7 @@ void Player::updateNameAndDescriptions() const
 LevelObjValue Player::addItemQuantity(const ItemClass& itemClass,
 	const LevelObjValue amount, InventoryPosition invPos)
 {
-	auto remaining = inventories.addQuantity(itemClass, amount, invPos, this);
-	if (amount != 0)
-	{
-		updateItemQuantityCache(itemClass.IdHash16(), amount - remaining);
-	}
-	return remaining;
-}
-
-void Player::updateItemQuantityCache(uint16_t classIdHash16, LevelObjValue amount) noexcept
-{
-	auto quantity = itemQuantityCache.getValue(classIdHash16);
-	if (quantity != nullptr)
-	{
-		(*quantity) += amount;
-	}
-}
-
-void Player::updateItemQuantityCache(uint16_t classIdHash16) noexcept
-{
-	auto quantity = itemQuantityCache.getValue(classIdHash16);
-	if (quantity != nullptr)
-	{
-		(*quantity) = inventories.getQuantity(classIdHash16);
-	}
+	return inventories.addQuantity(itemClass, amount, invPos, this);
 }
 
 uint32_t Player::getMaxItemCapacity(const ItemClass& itemClass) const
@@ -1255,13 +1243,11 @@ bool Player::setItem(size_t invIdx, size_t itemIdx, std::shared_ptr<Item>& item,
 	{
 		if (itemPtr != nullptr)
 		{
-			updateItemQuantityCache(itemPtr->Class()->IdHash16());
 			itemPtr->clearMapPosition();
 			itemPtr->updateOwner(this);
 		}
 		else if (oldItem != nullptr)
 		{
-			updateItemQuantityCache(oldItem->Class()->IdHash16());
 			oldItem->updateOwner(nullptr);
 		}
 		if (bodyInventoryIdx == invIdx)
@@ -1293,7 +1279,6 @@ bool Player::setItemInFreeSlot(size_t invIdx, std::shared_ptr<Item>& item,
 				if (Inventory::updateQuantities(
 					quantItem, item.get(), transferedQuantity, true) == true)
 				{
-					updateItemQuantityCache(item->Class()->IdHash16(), transferedQuantity);
 					return true;
 				}
 			}
@@ -1310,7 +1295,6 @@ bool Player::setItemInFreeSlot(size_t invIdx, std::shared_ptr<Item>& item,
 					(unsigned)itemSlots <= freeSlots)
 				{
 					inventory.addQuantity(*item->Class(), itemSlots, invPos, this);
-					updateItemQuantityCache(item->Class()->IdHash16(), itemSlots);
 					return true;
 				}
 				// if you can't add all of it, add none and return.
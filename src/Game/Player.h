@@ -10,7 +10,7 @@
 #include <SFML/Audio/Sound.hpp>
 #include <unordered_map>
 #include "Utils/FixedMap.h"
-#include "Utils/LRUCache.h"
+#include "Utils/FrameArena.h"
 
 class Player : public LevelObject
 {
@@ -92,8 +92,6 @@ private:
 
 	FixedMap<uint16_t, Number32, 8> customProperties;
 
-	mutable LRUCache<uint16_t, uint32_t, 3> itemQuantityCache;
-
 	sf::Sound currentSound;
 
 	int16_t attackSound{ -1 };
@@ -130,6 +128,8 @@ private:
 		const Game& game, const Level& level, const Player& player);
 
 public:
+	static constexpr LevelObjectType TypeTag = LevelObjectType::Player;
+
 	Player(const PlayerClass* class__, const Level& level);
 
 	constexpr const PlayerClass* Class() const noexcept
@@ -155,6 +155,8 @@ public:
 		Save::serialize(serializeObj, props, game, level, *this);
 	}
 
+	virtual bool canSleep() const noexcept;
+
 	virtual void update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr);
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
@@ -185,7 +187,7 @@ public:
 	bool setNumber(const std::string_view prop, const Number32& value, const Level* level) noexcept;
 
 	void clearWalkPath() noexcept { walkPath.clear(); }
-	void setWalkPath(const std::vector<PairFloat>& walkPath_, bool doAction);
+	void setWalkPath(const FrameVector<PairFloat>& walkPath_, bool doAction);
 	void Walk(const LevelMap& map, const PairFloat& walkToMapPos, bool doAction);
 	void Walk(const LevelMap& map, const PlayerDirection direction, bool doAction);
 
@@ -324,9 +326,6 @@ public:
 	LevelObjValue addItemQuantity(const ItemClass& itemClass,
 		const LevelObjValue amount, InventoryPosition invPos);
 
-	void updateItemQuantityCache(uint16_t classIdHash16, LevelObjValue amount) noexcept;
-	void updateItemQuantityCache(uint16_t classIdHash16) noexcept;
-
 	uint32_t getMaxItemCapacity(const ItemClass& itemClass) const;
 
 	bool isAI() const noexcept { return useAI; }
@@ -10,7 +10,7 @@ using namespace SaveUtils;
 void Save::serialize(void* serializeObj, Properties& props,
 	const Game& game, const Level& level, const Item& item)
 {
-	auto& writer = *((PrettyWriter<StringBuffer>*)serializeObj);
+	auto& writer = *((Save::Writer*)serializeObj);
 	const auto& itemClass = *item.Class();
 
 	writer.StartObject();
@@ -1,31 +1,130 @@
 #include "SaveLevel.h"
+#include <deque>
 #include "FileUtils.h"
+#include "Game.h"
 #include "Game/Level.h"
 #include "Game/Player.h"
 #include "Game/SimpleLevelObject.h"
 #include "Json/JsonParser.h"
+#include <mutex>
 #include "SaveItem.h"
 #include "SaveUtils.h"
 
 using namespace rapidjson;
 using namespace SaveUtils;
 
-void Save::save(const std::string_view filePath, Properties& props,
+struct PendingSave
+{
+	std::string filePath;
+	JsonBinary::Writer snapshot;
+	bool saveBinary{ false };
+	bool compress{ false };
+	std::function<void(bool)> onComplete;
+};
+
+// written by one job at a time, so saves to the same file finish in order.
+static std::mutex pendingSavesMutex;
+static std::deque<PendingSave> pendingSaves;
+static bool writingSaves{ false };
+
+static void writePendingSaves(JobSystem& jobs)
+{
+	while (true)
+	{
+		PendingSave save;
+		{
+			std::lock_guard<std::mutex> lock(pendingSavesMutex);
+			if (pendingSaves.empty() == true)
+			{
+				writingSaves = false;
+				return;
+			}
+			save = std::move(pendingSaves.front());
+			pendingSaves.pop_front();
+		}
+
+		auto file = (save.saveBinary == true ?
+			save.snapshot.getFile(save.compress) : save.snapshot.getJson());
+		auto success = (file.empty() == false &&
+			FileUtils::saveTextAtomic(save.filePath, file));
+
+		jobs.runOnMainThread([filePath = std::move(save.filePath),
+			onComplete = std::move(save.onComplete), success]()
+		{
+			if (success == true)
+			{
+				FileUtils::addFile(filePath);
+			}
+			if (onComplete != nullptr)
+			{
+				onComplete(success);
+			}
+		});
+	}
+}
+
+bool Save::save(const std::string_view filePath, Properties& props,
+	const Game& game, const Level& level)
+{
+	return FileUtils::saveText(filePath, serializeToString(props, game, level));
+}
+
+void Save::saveAsync(const std::string_view filePath, Properties& props,
+	Game& game, const Level& level, std::function<void(bool)> onComplete)
+{
+	PendingSave save;
+	save.filePath = filePath;
+	save.saveBinary = props.saveBinary;
+	save.compress = props.compress;
+	save.onComplete = std::move(onComplete);
+
+	// the snapshot only records the values (no formatting, compression or I/O)
+	Writer writer(save.snapshot);
+	serialize(&writer, props, game, level);
+
+	auto path = FileUtils::getFilePath(filePath);
+	if (path.empty() == false)
+	{
+		FileUtils::createDir(path.c_str());
+	}
+
+	std::lock_guard<std::mutex> lock(pendingSavesMutex);
+	pendingSaves.push_back(std::move(save));
+	if (writingSaves == false)
+	{
+		writingSaves = true;
+		auto& jobs = game.Jobs();
+		jobs.run([&jobs]() { writePendingSaves(jobs); });
+	}
+}
+
+std::string Save::serializeToString(Properties& props,
 	const Game& game, const Level& level)
 {
+	if (props.saveBinary == true)
+	{
+		JsonBinary::Writer binaryWriter;
+		Writer writer(binaryWriter);
+
+		serialize(&writer, props, game, level);
+
+		return binaryWriter.getFile(props.compress);
+	}
+
 	StringBuffer buffer(0, std::numeric_limits<uint16_t>::max());
-	PrettyWriter<StringBuffer> writer(buffer);
-	writer.SetIndent(' ', 2);
+	PrettyWriter<StringBuffer> jsonWriter(buffer);
+	jsonWriter.SetIndent(' ', 2);
+	Writer writer(jsonWriter);
 
 	serialize(&writer, props, game, level);
 
-	FileUtils::saveText(filePath, { buffer.GetString(), buffer.GetSize() });
+	return { buffer.GetString(), buffer.GetSize() };
 }
 
 void Save::serialize(void* serializeObj, Properties& props,
 	const Game& game, const Level& level)
 {
-	auto& writer = *((PrettyWriter<StringBuffer>*)serializeObj);
+	auto& writer = *((Save::Writer*)serializeObj);
 
 	// root
 	writer.StartObject();
@@ -45,6 +144,7 @@ void Save::serialize(void* serializeObj, Properties& props,
 	writer.StartObject();
 	writeKeyStringView(writer, "layers");
 	writer.StartArray();
+	std::vector<int16_t> layerData;
 	for (size_t i = 0; i < LevelCell::NumberOfLayers; i++)
 	{
 		if (level.map.isLayerUsed(i) == false)
@@ -66,15 +166,13 @@ void Save::serialize(void* serializeObj, Properties& props,
 		writeInt(writer, "width", level.map.MapSizei().x);
 		writeInt(writer, "height", level.map.MapSizei().y);
 
-		writeKeyStringView(writer, "data");
-		writer.SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
-		writer.StartArray();
+		layerData.clear();
 		for (const auto& cell : level.map)
 		{
-			writer.Int(cell.getTileIndex(i));
+			layerData.push_back(cell.getTileIndex(i));
 		}
-		writer.EndArray();
-		writer.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+		writeKeyStringView(writer, "data");
+		writer.Int16Array(layerData);
 
 		// layer
 		writer.EndObject();
@@ -105,7 +203,7 @@ void Save::serialize(void* serializeObj, Properties& props,
 	writer.StartArray();
 	for (const auto& obj : level.levelObjects)
 	{
-		auto item = dynamic_cast<Item*>(obj.get());
+		auto item = obj->as<Item>();
 		if (item != nullptr)
 		{
 			serialize(serializeObj, props, game, level, *item);
@@ -117,7 +215,7 @@ void Save::serialize(void* serializeObj, Properties& props,
 	writer.StartArray();
 	for (const auto& obj : level.levelObjects)
 	{
-		auto levelObj = dynamic_cast<SimpleLevelObject*>(obj.get());
+		auto levelObj = obj->as<SimpleLevelObject>();
 		if (levelObj != nullptr)
 		{
 			serialize(serializeObj, props, game, level, *levelObj);
@@ -129,7 +227,7 @@ void Save::serialize(void* serializeObj, Properties& props,
 	writer.StartArray();
 	for (const auto& obj : level.levelObjects)
 	{
-		auto player = dynamic_cast<Player*>(obj.get());
+		auto player = obj->as<Player>();
 		if (player != nullptr)
 		{
 			if (props.saveCurrentPlayer == false &&
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include "SaveProperties.h"
+#include <string>
 #include <string_view>
 
 class Game;
@@ -9,7 +11,17 @@ class LevelObject;
 
 namespace Save
 {
-	void save(const std::string_view filePath, Properties& props,
+	bool save(const std::string_view filePath, Properties& props,
+		const Game& game, const Level& level);
+
+	// serializes a snapshot of the level (in the binary format) on the calling thread
+	// and formats and writes it on a worker (see FileUtils::saveTextAtomic).
+	// saves are written in order. onComplete(success) runs on the main thread.
+	void saveAsync(const std::string_view filePath, Properties& props,
+		Game& game, const Level& level, std::function<void(bool)> onComplete);
+
+	// the save file's data (json or binary).
+	std::string serializeToString(Properties& props,
 		const Game& game, const Level& level);
 
 	void serialize(void* serializeObj, Properties& props,
@@ -12,7 +12,7 @@ using namespace SaveUtils;
 void Save::serialize(void* serializeObj, Properties& props,
 	const Game& game, const Level& level, const Player& player)
 {
-	auto& writer = *((PrettyWriter<StringBuffer>*)serializeObj);
+	auto& writer = *((Save::Writer*)serializeObj);
 	const auto& playerClass = *player.Class();
 
 	writer.StartObject();
@@ -7,6 +7,10 @@ namespace Save
 		bool saveDefaults{ false };
 		bool saveCurrentPlayer{ false };
 		bool saveQuests{ false };
+		// compact binary format (JsonBinary) instead of json.
+		bool saveBinary{ false };
+		// LZ4 compresses binary saves.
+		bool compress{ false };
 		void* customProperty{ nullptr };
 	};
 }
@@ -11,7 +11,7 @@ using namespace SaveUtils;
 void Save::serialize(void* serializeObj, Properties& props,
 	const Game& game, const Level& level, const SimpleLevelObject& obj)
 {
-	auto& writer = *((PrettyWriter<StringBuffer>*)serializeObj);
+	auto& writer = *((Save::Writer*)serializeObj);
 	const auto& objClass = *obj.Class();
 
 	writer.StartObject();
@@ -4,28 +4,28 @@ namespace SaveUtils
 {
 	using namespace rapidjson;
 
-	void writeBool(PrettyWriter<StringBuffer>& writer,
+	void writeBool(Save::Writer& writer,
 		const std::string_view key, bool val)
 	{
 		writer.Key(key.data(), key.size());
 		writer.Bool(val);
 	}
 
-	void writeInt(PrettyWriter<StringBuffer>& writer,
+	void writeInt(Save::Writer& writer,
 		const std::string_view key, int val)
 	{
 		writer.Key(key.data(), key.size());
 		writer.Int(val);
 	}
 
-	void writeUInt(PrettyWriter<StringBuffer>& writer,
+	void writeUInt(Save::Writer& writer,
 		const std::string_view key, unsigned val)
 	{
 		writer.Key(key.data(), key.size());
 		writer.Uint(val);
 	}
 
-	void writeNumber32(PrettyWriter<StringBuffer>& writer,
+	void writeNumber32(Save::Writer& writer,
 		const std::string_view key, const Number32& val)
 	{
 		writer.Key(key.data(), key.size());
@@ -43,39 +43,39 @@ namespace SaveUtils
 		}
 	}
 
-	void writeKey(PrettyWriter<StringBuffer>& writer,
+	void writeKey(Save::Writer& writer,
 		const std::string& key)
 	{
 		writer.Key(key);
 	}
 
-	void writeKeyStringView(PrettyWriter<StringBuffer>& writer,
+	void writeKeyStringView(Save::Writer& writer,
 		const std::string_view key)
 	{
 		writer.Key(key.data(), key.size());
 	}
 
-	void writeString(PrettyWriter<StringBuffer>& writer,
+	void writeString(Save::Writer& writer,
 		const std::string_view key, const std::string& val)
 	{
 		writer.Key(key.data(), key.size());
 		writer.String(val);
 	}
 
-	void writeStringView(PrettyWriter<StringBuffer>& writer,
+	void writeStringView(Save::Writer& writer,
 		const std::string_view key, const std::string_view val)
 	{
 		writer.Key(key.data(), key.size());
 		writer.String(val.data(), val.size());
 	}
 
-	void writeString(PrettyWriter<StringBuffer>& writer,
+	void writeString(Save::Writer& writer,
 		const std::string& val)
 	{
 		writer.String(val);
 	}
 
-	void writeStringView(PrettyWriter<StringBuffer>& writer,
+	void writeStringView(Save::Writer& writer,
 		const std::string_view val)
 	{
 		writer.String(val.data(), val.size());
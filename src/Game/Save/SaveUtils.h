@@ -3,27 +3,27 @@
 #include <cmath>
 #include "Game/Number.h"
 #include "Game/PairXY.h"
-#include "Json/JsonParser.h"
+#include "SaveWriter.h"
 #include <string>
 #include <string_view>
 
 namespace SaveUtils
 {
-	void writeBool(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeBool(Save::Writer& writer,
 		const std::string_view key, bool val);
 
-	void writeInt(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeInt(Save::Writer& writer,
 		const std::string_view key, int val);
 
-	void writeUInt(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeUInt(Save::Writer& writer,
 		const std::string_view key, unsigned val);
 
-	void writeNumber32(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeNumber32(Save::Writer& writer,
 		const std::string_view key, const Number32& val);
 
 	// same line formatted.
 	template <class T, class NumType>
-	void writeVector2Number(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeVector2Number(Save::Writer& writer,
 		const std::string_view key, const T& val)
 	{
 		writer.SetFormatOptions(rapidjson::PrettyFormatOptions::kFormatSingleLineArray);
@@ -53,7 +53,7 @@ namespace SaveUtils
 
 	// same line formatted.
 	template <class T>
-	void writeVector2i(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeVector2i(Save::Writer& writer,
 		const std::string_view key, const T& val)
 	{
 		writeVector2Number<T, decltype(val.x)>(writer, key, val);
@@ -61,7 +61,7 @@ namespace SaveUtils
 
 	// same line formatted.
 	template <class T>
-	void writeVector2f(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeVector2f(Save::Writer& writer,
 		const std::string_view key, const T& val)
 	{
 		writeVector2Number<T, decltype(val.x)>(writer, key, val);
@@ -70,7 +70,7 @@ namespace SaveUtils
 	// writes floats. if the float has no decimal part, writes ints
 	// same line formatted.
 	template <class T>
-	void writeVector2fi(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeVector2fi(Save::Writer& writer,
 		const std::string_view key, const T& val)
 	{
 		writer.SetFormatOptions(rapidjson::PrettyFormatOptions::kFormatSingleLineArray);
@@ -137,24 +137,24 @@ namespace SaveUtils
 	}
 
 	// write just the key
-	void writeKey(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeKey(Save::Writer& writer,
 		const std::string& key);
 
 	// write just the key
-	void writeKeyStringView(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeKeyStringView(Save::Writer& writer,
 		const std::string_view key);
 
-	void writeString(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeString(Save::Writer& writer,
 		const std::string_view key, const std::string& val);
 
-	void writeStringView(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeStringView(Save::Writer& writer,
 		const std::string_view key, const std::string_view val);
 
 	// write just the value (no key)
-	void writeString(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeString(Save::Writer& writer,
 		const std::string& val);
 
 	// write just the value (no key)
-	void writeStringView(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+	void writeStringView(Save::Writer& writer,
 		const std::string_view val);
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include "Json/JsonBinary.h"
+#include "Json/JsonParser.h"
+#include <string>
+#include <vector>
+
+namespace Save
+{
+	// the writer passed as serializeObj to the serialize functions.
+	// writes json (PrettyWriter) or the binary format (JsonBinary::Writer).
+	class Writer
+	{
+	private:
+		rapidjson::PrettyWriter<rapidjson::StringBuffer>* json{ nullptr };
+		JsonBinary::Writer* binary{ nullptr };
+
+	public:
+		Writer(rapidjson::PrettyWriter<rapidjson::StringBuffer>& json_) noexcept : json(&json_) {}
+		Writer(JsonBinary::Writer& binary_) noexcept : binary(&binary_) {}
+
+		bool isBinary() const noexcept { return binary != nullptr; }
+
+		void SetFormatOptions(rapidjson::PrettyFormatOptions options)
+		{
+			if (json != nullptr)
+			{
+				json->SetFormatOptions(options);
+			}
+			else
+			{
+				binary->SetFormatOptions(options);
+			}
+		}
+
+		bool Bool(bool b) { return json != nullptr ? json->Bool(b) : binary->Bool(b); }
+		bool Int(int i) { return json != nullptr ? json->Int(i) : binary->Int(i); }
+		bool Uint(unsigned u) { return json != nullptr ? json->Uint(u) : binary->Uint(u); }
+		bool Int64(int64_t i) { return json != nullptr ? json->Int64(i) : binary->Int64(i); }
+		bool Double(double d) { return json != nullptr ? json->Double(d) : binary->Double(d); }
+
+		bool String(const char* str, rapidjson::SizeType length)
+		{
+			return json != nullptr ? json->String(str, length) : binary->String(str, length);
+		}
+		bool String(const std::string& str) { return json != nullptr ? json->String(str) : binary->String(str); }
+
+		bool Key(const char* str, rapidjson::SizeType length)
+		{
+			return json != nullptr ? json->Key(str, length) : binary->Key(str, length);
+		}
+		bool Key(const std::string& str) { return json != nullptr ? json->Key(str) : binary->Key(str); }
+
+		bool StartObject() { return json != nullptr ? json->StartObject() : binary->StartObject(); }
+		bool EndObject() { return json != nullptr ? json->EndObject() : binary->EndObject(); }
+		bool StartArray() { return json != nullptr ? json->StartArray() : binary->StartArray(); }
+		bool EndArray() { return json != nullptr ? json->EndArray() : binary->EndArray(); }
+
+		// map layer values. same line formatted in json.
+		bool Int16Array(const std::vector<int16_t>& values)
+		{
+			if (binary != nullptr)
+			{
+				return binary->Int16Array(values);
+			}
+			json->SetFormatOptions(rapidjson::PrettyFormatOptions::kFormatSingleLineArray);
+			json->StartArray();
+			for (auto val : values)
+			{
+				json->Int(val);
+			}
+			json->EndArray();
+			json->SetFormatOptions(rapidjson::PrettyFormatOptions::kFormatDefault);
+			return true;
+		}
+	};
+}
@@ -2,7 +2,8 @@
 #include "Game.h"
 #include "Game/Level.h"
 
-SimpleLevelObject::SimpleLevelObject(const SimpleLevelObjectClass* class__) : LevelObject(class__)
+SimpleLevelObject::SimpleLevelObject(const SimpleLevelObjectClass* class__)
+	: LevelObject(class__, TypeTag)
 {
 	if (class__->getTexture() != nullptr)
 	{
@@ -38,8 +39,6 @@ bool SimpleLevelObject::getTexture(uint32_t textureNumber, TextureInfo& ti) cons
 
 void SimpleLevelObject::update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr)
 {
-	updateHover(game, level, thisPtr);
-
 	const auto& rect = sprite.getTextureRect();
 	if (rect.width > 0 && rect.height > 0)
 	{
@@ -51,6 +50,14 @@ void SimpleLevelObject::update(Game& game, Level& level, std::weak_ptr<LevelObje
 	}
 }
 
+bool SimpleLevelObject::canSleep() const noexcept
+{
+	// looped animations are only updated near the view
+	return LevelObject::canSleep() == true &&
+		(animation.animType != AnimationType::PlayOnce ||
+			animation.isAnimationAtEnd() == true);
+}
+
 const std::string& SimpleLevelObject::Name() const
 {
 	updateNameAndDescriptions();
@@ -28,6 +28,8 @@ private:
 		const Game& game, const Level& level, const SimpleLevelObject& obj);
 
 public:
+	static constexpr LevelObjectType TypeTag = LevelObjectType::SimpleLevelObject;
+
 	SimpleLevelObject(const SimpleLevelObjectClass* class__);
 
 	constexpr const SimpleLevelObjectClass* Class() const noexcept
@@ -55,6 +57,8 @@ public:
 		Save::serialize(serializeObj, props, game, level, *this);
 	}
 
+	virtual bool canSleep() const noexcept;
+
 	virtual void update(Game& game, Level& level, std::weak_ptr<LevelObject> thisPtr);
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
@@ -26,12 +26,22 @@ private:
 	PairInt8 cellSize;
 
 public:
-	SimpleLevelObjectClass(const sf::Texture& texture_) : texture(&texture_) {}
+	SimpleLevelObjectClass(const sf::Texture& texture_) : texture(&texture_)
+	{
+		updateClass = UpdateClass::EventDriven;
+	}
 	SimpleLevelObjectClass(const std::shared_ptr<TexturePack>& texturePack_,
 		const std::pair<uint32_t, uint32_t>& textureIndexRange_,
 		const sf::Time& frameTime_, AnimationType animType_)
 		: texturePack(texturePack_), textureIndexRange(textureIndexRange_),
-		frameTime(frameTime_), animType(animType_) {}
+		frameTime(frameTime_), animType(animType_)
+	{
+		// static objects don't need updates after being added
+		if (textureIndexRange_.second <= textureIndexRange_.first)
+		{
+			updateClass = UpdateClass::EventDriven;
+		}
+	}
 
 	const sf::Texture* getTexture() const noexcept { return texture; }
 
@@ -85,6 +85,8 @@ public:
 		uint16_t propHash, const std::string_view prop, Variable& var) const;
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
+	virtual bool getPropertyByHash(const std::string_view prop, uint16_t propHash,
+		const std::string_view props, Variable& var) const;
 
 	virtual bool getTexture(uint32_t textureNumber, TextureInfo& ti) const;
 
@@ -166,5 +168,7 @@ struct SpellInstance : public Queryable
 
 	virtual bool getNumberProp(const std::string_view prop, Number32& value) const;
 	virtual bool getProperty(const std::string_view prop, Variable& var) const;
+	virtual bool getPropertyByHash(const std::string_view prop, uint16_t propHash,
+		const std::string_view props, Variable& var) const;
 	virtual bool getTexture(uint32_t textureNumber, TextureInfo& ti) const;
 };
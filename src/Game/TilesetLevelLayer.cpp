@@ -1,4 +1,5 @@
 #include "TilesetLevelLayer.h"
+#include "FrameProfiler.h"
 #include "Level.h"
 #include "LevelSurface.h"
 #include "Player.h"
@@ -32,10 +33,11 @@ void TilesetLevelLayer::updateVisibleArea(const LevelSurface& surface, const Lev
 	visibleEnd.y = (int32_t)mapBL.y;
 }
 
-void TilesetLevelLayer::draw(const LevelSurface& surface,
-	SpriteShaderCache& spriteCache, sf::Shader* spriteShader,
+void TilesetLevelLayer::draw(const LevelSurface& surface, sf::Shader* spriteShader,
 	const Level& level, bool drawLevelObjects, bool isAutomap) const
 {
+	PROFILE_SCOPE("TilesetLevelLayer::draw");
+
 	Sprite2 sprite;
 	TextureInfo ti;
 	sf::FloatRect tileRect;
@@ -79,7 +81,7 @@ void TilesetLevelLayer::draw(const LevelSurface& surface,
 						if (drawObj != nullptr)
 						{
 							auto objLight = std::max(drawObj->getLight(), light);
-							surface.draw(*drawObj, spriteShader, spriteCache, objLight);
+							surface.draw(*drawObj, spriteShader, objLight);
 						}
 					}
 					if (tiles == nullptr ||
@@ -104,7 +106,7 @@ void TilesetLevelLayer::draw(const LevelSurface& surface,
 				if (surface.visibleRect.intersects(tileRect) == true)
 				{
 					sprite.setTexture(ti, true);
-					surface.draw(sprite, spriteShader, spriteCache, light);
+					surface.draw(sprite, spriteShader, light);
 				}
 			}
 		}
@@ -133,7 +135,7 @@ void TilesetLevelLayer::draw(const LevelSurface& surface,
 			if (surface.visibleRect.intersects(tileRect) == true)
 			{
 				sprite.setTexture(ti, true);
-				surface.draw(sprite, spriteShader, spriteCache);
+				surface.draw(sprite, spriteShader);
 			}
 		}
 	}
@@ -26,7 +26,6 @@ struct TilesetLevelLayer
 
 	void updateVisibleArea(const LevelSurface& surface, const LevelMap& map);
 
-	void draw(const LevelSurface& surface,
-		SpriteShaderCache& spriteCache, sf::Shader* spriteShader,
+	void draw(const LevelSurface& surface, sf::Shader* spriteShader,
 		const Level& level, bool drawLevelObjects, bool isAutomap) const;
 };
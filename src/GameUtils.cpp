@@ -716,10 +716,32 @@ namespace GameUtils
 		return sf::seconds(1.f / (float)fps);
 	}
 
-	std::string replaceStringWithQueryable(const std::string_view str,
-		const Queryable& obj, char token)
+	UpdateClass getUpdateClass(const std::string_view str, UpdateClass val)
+	{
+		switch (str2int16(Utils::toLower(str)))
+		{
+		case str2int16("always"):
+			return UpdateClass::Always;
+		case str2int16("nearview"):
+			return UpdateClass::NearView;
+		case str2int16("eventdriven"):
+			return UpdateClass::EventDriven;
+		case str2int16("never"):
+			return UpdateClass::Never;
+		default:
+			return val;
+		}
+	}
+
+	// builds the result in a single pass instead of copying the string
+	// and replacing each token in place.
+	template <class GetVar>
+	static std::string replaceStringTokens(const std::string_view str,
+		char token, const GetVar& getVar)
 	{
-		std::string str2(str);
+		std::string str2;
+		str2.reserve(str.size());
+		size_t copyStart = 0;
 		size_t firstTokenStart = 0;
 		while (true)
 		{
@@ -738,45 +760,40 @@ namespace GameUtils
 
 			std::string_view strProp(str.data() + firstTokenStop, secondTokenStart - firstTokenStop);
 			Variable var;
-			if (obj.getProperty(strProp, var) == true)
+			if (getVar(strProp, var) == true)
 			{
-				std::string_view strProp2(str.data() + firstTokenStart, secondTokenStop - firstTokenStart);
-				Utils::replaceStringInPlace(str2, strProp2, VarUtils::toString(var));
+				str2.append(str.data() + copyStart, firstTokenStart - copyStart);
+				str2.append(VarUtils::toString(var));
+				copyStart = secondTokenStop;
+				firstTokenStart = secondTokenStop;
+			}
+			else
+			{
+				// the closing token can open the next one
+				firstTokenStart = secondTokenStart;
 			}
-			firstTokenStart = secondTokenStart;
 		}
+		str2.append(str.data() + copyStart, str.size() - copyStart);
 		return str2;
 	}
 
-	std::string replaceStringWithVarOrProp(const std::string_view str,
-		const Game& obj, char token)
+	std::string replaceStringWithQueryable(const std::string_view str,
+		const Queryable& obj, char token)
 	{
-		std::string str2(str);
-		size_t firstTokenStart = 0;
-		while (true)
-		{
-			firstTokenStart = str.find(token, firstTokenStart);
-			if (firstTokenStart == std::string_view::npos)
-			{
-				break;
-			}
-			size_t firstTokenStop = firstTokenStart + 1;
-			size_t secondTokenStart = str.find_first_of(token, firstTokenStop);
-			if (secondTokenStart == std::string_view::npos)
+		return replaceStringTokens(str, token,
+			[&obj](const std::string_view prop, Variable& var)
 			{
-				break;
-			}
-			size_t secondTokenStop = secondTokenStart + 1;
+				return obj.getProperty(prop, var);
+			});
+	}
 
-			std::string_view strProp(str.data() + firstTokenStop, secondTokenStart - firstTokenStop);
-			Variable var;
-			if (obj.getVarOrPropNoToken(strProp, var) == true)
+	std::string replaceStringWithVarOrProp(const std::string_view str,
+		const Game& obj, char token)
+	{
+		return replaceStringTokens(str, token,
+			[&obj](const std::string_view prop, Variable& var)
 			{
-				std::string_view strProp2(str.data() + firstTokenStart, secondTokenStop - firstTokenStart);
-				Utils::replaceStringInPlace(str2, strProp2, VarUtils::toString(var));
-			}
-			firstTokenStart = secondTokenStart;
-		}
-		return str2;
+				return obj.getVarOrPropNoToken(prop, var);
+			});
 	}
 }
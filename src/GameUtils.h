@@ -80,6 +80,8 @@ namespace GameUtils
 
 	sf::Time getTime(int fps);
 
+	UpdateClass getUpdateClass(const std::string_view str, UpdateClass val);
+
 	// replaces "%str%" with obj.getProperty("str")
 	std::string replaceStringWithQueryable(const std::string_view str,
 		const Queryable& obj, char token = '%');
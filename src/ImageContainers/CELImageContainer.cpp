@@ -1,7 +1,6 @@
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include "CELImageContainer.h"
 #include "gsl/gsl"
-#include "PhysFSStream.h"
 #include "StreamReader.h"
 
 namespace
@@ -677,14 +676,9 @@ CELImageContainer::CELImageContainer(const std::string_view fileName)
 	uint32_t celFrameEndOffset = 0;
 	uint32_t celFrameSize = 0;
 
+	if (fileData.load(fileName.data()) == false)
 	{
-		sf::PhysFSStream file(fileName.data());
-		if (file.hasError() == true)
-		{
-			return;
-		}
-		fileData.resize((size_t)file.getSize());
-		file.read(fileData.data(), file.getSize());
+		return;
 	}
 
 	LittleEndianStreamReader fileStream(fileData.data(), fileData.size());
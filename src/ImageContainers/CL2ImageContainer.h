@@ -2,6 +2,7 @@
 
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include <cstdint>
+#include "FileBytes.h"
 #include "ImageContainer.h"
 #include <string_view>
 
@@ -10,7 +11,7 @@
 class CL2ImageContainer : public ImageContainer
 {
 private:
-	std::vector<uint8_t> fileData;
+	FileBytes fileData;
 	std::vector<std::pair<uint32_t, uint32_t>> frameOffsets;
 	uint32_t directions{ 0 };
 	BlendMode blendMode{ BlendMode::Alpha };
@@ -1,7 +1,6 @@
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include "DC6ImageContainer.h"
 #include "gsl/gsl"
-#include "PhysFSStream.h"
 #include "StreamReader.h"
 
 namespace
@@ -21,7 +20,7 @@ namespace
 		uint32_t length;	// Length of the frame in chunks
 	};
 
-	bool decodeFrameHeader(uint32_t index, const std::vector<uint8_t>& fileData,
+	bool decodeFrameHeader(uint32_t index, const FileBytes& fileData,
 		DC6FrameHeader& frameHeader, gsl::span<const uint8_t>& frameData)
 	{
 		// get frame position
@@ -114,14 +113,9 @@ namespace
 DC6ImageContainer::DC6ImageContainer(const std::string_view fileName,
 	bool stitchFrames, bool useOffsets_) : useOffsets(useOffsets_)
 {
+	if (fileData.load(fileName.data()) == false)
 	{
-		sf::PhysFSStream file(fileName.data());
-		if (file.hasError() == true)
-		{
-			return;
-		}
-		fileData.resize((size_t)file.getSize());
-		file.read(fileData.data(), file.getSize());
+		return;
 	}
 
 	LittleEndianStreamReader fileStream(fileData.data(), fileData.size());
@@ -2,6 +2,7 @@
 
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include <cstdint>
+#include "FileBytes.h"
 #include "ImageContainer.h"
 #include <string_view>
 
@@ -10,7 +11,7 @@
 class DC6ImageContainer : public ImageContainer
 {
 private:
-	std::vector<uint8_t> fileData;
+	FileBytes fileData;
 	uint32_t numberOfFrames{ 0 };
 	uint32_t directions{ 0 };
 
@@ -4,7 +4,6 @@
 #include <array>
 #include <bitset>
 #include <cassert>
-#include "PhysFSStream.h"
 #include "StreamReader.h"
 
 namespace
@@ -885,7 +884,7 @@ namespace
 		}
 	}
 
-	bool readDirection(const std::vector<uint8_t>& fileData,
+	bool readDirection(const FileBytes& fileData,
 		const std::vector<uint32_t>& directionsOffsets,
 		uint32_t directions, uint32_t framesPerDir,
 		DCCDirection& outDir, uint32_t dirIndex, SimpleImageProvider& imgProvider)
@@ -937,14 +936,9 @@ namespace
 
 DCCImageContainer::DCCImageContainer(const std::string_view fileName)
 {
+	if (fileData.load(fileName.data()) == false)
 	{
-		sf::PhysFSStream file(fileName.data());
-		if (file.hasError() == true)
-		{
-			return;
-		}
-		fileData.resize((size_t)file.getSize());
-		file.read(fileData.data(), file.getSize());
+		return;
 	}
 
 	LittleEndianStreamReader fileStream(fileData.data(), fileData.size());
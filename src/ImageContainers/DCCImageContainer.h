@@ -2,6 +2,7 @@
 
 #ifndef NO_DIABLO_FORMAT_SUPPORT
 #include <cstdint>
+#include "FileBytes.h"
 #include "ImageContainer.h"
 #include <string_view>
 #include <vector>
@@ -11,7 +12,7 @@
 class DCCImageContainer : public ImageContainer
 {
 private:
-	std::vector<uint8_t> fileData;
+	FileBytes fileData;
 	uint32_t numberOfFrames{ 0 };
 	uint32_t directions{ 0 };
 	uint32_t framesPerDir{ 0 };
@@ -1,4 +1,5 @@
 #include "InputEvent.h"
+#include "InputRecorder.h"
 #include "Utils/Utils.h"
 
 size_t CompareEvent::operator()(const sf::Event& obj) const noexcept
@@ -80,6 +81,22 @@ bool CompareEvent::operator()(const sf::Event& obj1, const sf::Event& obj2) cons
 
 bool InputEvent::isActive() const
 {
+	// recordings use the recorded events, not the live state
+	if (InputRecorder::isRecording() == true ||
+		InputRecorder::isReplaying() == true)
+	{
+		switch (type)
+		{
+		case InputType::Mouse:
+			return InputRecorder::isMouseButtonPressed((sf::Mouse::Button)(value));
+		case InputType::Keyboard:
+			return InputRecorder::isKeyPressed((sf::Keyboard::Key)(value));
+		case InputType::Joystick:
+			return InputRecorder::isJoystickButtonPressed((unsigned int)(value));
+		default:
+			return false;
+		}
+	}
 	switch (type)
 	{
 	case InputType::Mouse:
@@ -0,0 +1,509 @@
+#include "InputRecorder.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <SFML/Window/Joystick.hpp>
+#include <sstream>
+#include "Utils/Utils.h"
+
+namespace InputRecorder
+{
+	constexpr std::string_view FileMagic{ "DGIR" };
+	constexpr uint8_t FileVersion = 1;
+
+	// recorded frames are written when the buffer reaches this size
+	constexpr size_t WriteBufferSize = 64 * 1024;
+
+	struct Frame
+	{
+		sf::Time frameTime;
+		std::vector<sf::Event> events;
+	};
+
+	static uint32_t seed{ 0 };
+	static uint64_t frameNumber{ 0 };
+
+	// recording
+	static std::ofstream outFile;
+	static std::vector<uint8_t> buffer;
+	static std::vector<sf::Event> frameEvents;
+
+	// replaying
+	static std::vector<Frame> frames;
+	static size_t frameIdx{ 0 };
+
+	static std::bitset<sf::Keyboard::KeyCount> keys;
+	static std::bitset<sf::Mouse::ButtonCount> mouseButtons;
+	static std::bitset<sf::Joystick::ButtonCount> joystickButtons;
+
+	static void writeVarint(std::vector<uint8_t>& out, uint64_t val)
+	{
+		while (val >= 0x80)
+		{
+			out.push_back((uint8_t)(val | 0x80));
+			val >>= 7;
+		}
+		out.push_back((uint8_t)val);
+	}
+
+	static void writeInt(std::vector<uint8_t>& out, int64_t val)
+	{
+		writeVarint(out, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+	}
+
+	static void writeFloat(std::vector<uint8_t>& out, float val)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &val, sizeof(bits));
+		for (int i = 0; i < 4; i++)
+		{
+			out.push_back((uint8_t)(bits >> (i * 8)));
+		}
+	}
+
+	class Reader
+	{
+	private:
+		const std::vector<uint8_t>& data;
+		size_t pos{ 0 };
+		bool error{ false };
+
+	public:
+		Reader(const std::vector<uint8_t>& data_, size_t pos_) : data(data_), pos(pos_) {}
+
+		bool atEnd() const noexcept { return pos >= data.size(); }
+		bool hasError() const noexcept { return error; }
+
+		uint64_t readVarint() noexcept
+		{
+			uint64_t val = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				if (pos >= data.size())
+				{
+					error = true;
+					return 0;
+				}
+				auto byte = data[pos++];
+				val |= (uint64_t)(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return val;
+				}
+			}
+			error = true;
+			return 0;
+		}
+
+		int64_t readInt() noexcept
+		{
+			auto val = readVarint();
+			return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+		}
+
+		float readFloat() noexcept
+		{
+			if (pos + 4 > data.size())
+			{
+				error = true;
+				return 0.f;
+			}
+			uint32_t bits = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				bits |= (uint32_t)data[pos++] << (i * 8);
+			}
+			float val;
+			std::memcpy(&val, &bits, sizeof(val));
+			return val;
+		}
+	};
+
+	static void writeEvent(std::vector<uint8_t>& out, const sf::Event& evt)
+	{
+		out.push_back((uint8_t)evt.type);
+		switch (evt.type)
+		{
+		case sf::Event::Resized:
+			writeVarint(out, evt.size.width);
+			writeVarint(out, evt.size.height);
+			break;
+		case sf::Event::TextEntered:
+			writeVarint(out, evt.text.unicode);
+			break;
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased:
+			writeInt(out, evt.key.code);
+			out.push_back((uint8_t)((evt.key.alt ? 1 : 0) | (evt.key.control ? 2 : 0) |
+				(evt.key.shift ? 4 : 0) | (evt.key.system ? 8 : 0)));
+			break;
+		case sf::Event::MouseWheelMoved:
+			writeInt(out, evt.mouseWheel.delta);
+			writeInt(out, evt.mouseWheel.x);
+			writeInt(out, evt.mouseWheel.y);
+			break;
+		case sf::Event::MouseWheelScrolled:
+			writeVarint(out, evt.mouseWheelScroll.wheel);
+			writeFloat(out, evt.mouseWheelScroll.delta);
+			writeInt(out, evt.mouseWheelScroll.x);
+			writeInt(out, evt.mouseWheelScroll.y);
+			break;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			writeVarint(out, evt.mouseButton.button);
+			writeInt(out, evt.mouseButton.x);
+			writeInt(out, evt.mouseButton.y);
+			break;
+		case sf::Event::MouseMoved:
+			writeInt(out, evt.mouseMove.x);
+			writeInt(out, evt.mouseMove.y);
+			break;
+		case sf::Event::JoystickButtonPressed:
+		case sf::Event::JoystickButtonReleased:
+			writeVarint(out, evt.joystickButton.joystickId);
+			writeVarint(out, evt.joystickButton.button);
+			break;
+		case sf::Event::JoystickMoved:
+			writeVarint(out, evt.joystickMove.joystickId);
+			writeVarint(out, evt.joystickMove.axis);
+			writeFloat(out, evt.joystickMove.position);
+			break;
+		case sf::Event::JoystickConnected:
+		case sf::Event::JoystickDisconnected:
+			writeVarint(out, evt.joystickConnect.joystickId);
+			break;
+		case sf::Event::TouchBegan:
+		case sf::Event::TouchMoved:
+		case sf::Event::TouchEnded:
+			writeVarint(out, evt.touch.finger);
+			writeInt(out, evt.touch.x);
+			writeInt(out, evt.touch.y);
+			break;
+		case sf::Event::SensorChanged:
+			writeVarint(out, evt.sensor.type);
+			writeFloat(out, evt.sensor.x);
+			writeFloat(out, evt.sensor.y);
+			writeFloat(out, evt.sensor.z);
+			break;
+		default:
+			break;
+		}
+	}
+
+	static bool readEvent(Reader& reader, sf::Event& evt)
+	{
+		auto type = reader.readVarint();
+		if (type >= sf::Event::Count)
+		{
+			return false;
+		}
+		evt = {};
+		evt.type = (sf::Event::EventType)type;
+		switch (evt.type)
+		{
+		case sf::Event::Resized:
+			evt.size.width = (unsigned)reader.readVarint();
+			evt.size.height = (unsigned)reader.readVarint();
+			break;
+		case sf::Event::TextEntered:
+			evt.text.unicode = (sf::Uint32)reader.readVarint();
+			break;
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased:
+		{
+			evt.key.code = (sf::Keyboard::Key)reader.readInt();
+			auto flags = reader.readVarint();
+			evt.key.alt = (flags & 1) != 0;
+			evt.key.control = (flags & 2) != 0;
+			evt.key.shift = (flags & 4) != 0;
+			evt.key.system = (flags & 8) != 0;
+			break;
+		}
+		case sf::Event::MouseWheelMoved:
+			evt.mouseWheel.delta = (int)reader.readInt();
+			evt.mouseWheel.x = (int)reader.readInt();
+			evt.mouseWheel.y = (int)reader.readInt();
+			break;
+		case sf::Event::MouseWheelScrolled:
+			evt.mouseWheelScroll.wheel = (sf::Mouse::Wheel)reader.readVarint();
+			evt.mouseWheelScroll.delta = reader.readFloat();
+			evt.mouseWheelScroll.x = (int)reader.readInt();
+			evt.mouseWheelScroll.y = (int)reader.readInt();
+			break;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			evt.mouseButton.button = (sf::Mouse::Button)reader.readVarint();
+			evt.mouseButton.x = (int)reader.readInt();
+			evt.mouseButton.y = (int)reader.readInt();
+			break;
+		case sf::Event::MouseMoved:
+			evt.mouseMove.x = (int)reader.readInt();
+			evt.mouseMove.y = (int)reader.readInt();
+			break;
+		case sf::Event::JoystickButtonPressed:
+		case sf::Event::JoystickButtonReleased:
+			evt.joystickButton.joystickId = (unsigned)reader.readVarint();
+			evt.joystickButton.button = (unsigned)reader.readVarint();
+			break;
+		case sf::Event::JoystickMoved:
+			evt.joystickMove.joystickId = (unsigned)reader.readVarint();
+			evt.joystickMove.axis = (sf::Joystick::Axis)reader.readVarint();
+			evt.joystickMove.position = reader.readFloat();
+			break;
+		case sf::Event::JoystickConnected:
+		case sf::Event::JoystickDisconnected:
+			evt.joystickConnect.joystickId = (unsigned)reader.readVarint();
+			break;
+		case sf::Event::TouchBegan:
+		case sf::Event::TouchMoved:
+		case sf::Event::TouchEnded:
+			evt.touch.finger = (unsigned)reader.readVarint();
+			evt.touch.x = (int)reader.readInt();
+			evt.touch.y = (int)reader.readInt();
+			break;
+		case sf::Event::SensorChanged:
+			evt.sensor.type = (sf::Sensor::Type)reader.readVarint();
+			evt.sensor.x = reader.readFloat();
+			evt.sensor.y = reader.readFloat();
+			evt.sensor.z = reader.readFloat();
+			break;
+		default:
+			break;
+		}
+		return reader.hasError() == false;
+	}
+
+	static void updateHeldInput(const sf::Event& evt)
+	{
+		switch (evt.type)
+		{
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased:
+			if (evt.key.code >= 0 && evt.key.code < sf::Keyboard::KeyCount)
+			{
+				keys[evt.key.code] = evt.type == sf::Event::KeyPressed;
+			}
+			break;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			if (evt.mouseButton.button < sf::Mouse::ButtonCount)
+			{
+				mouseButtons[evt.mouseButton.button] = evt.type == sf::Event::MouseButtonPressed;
+			}
+			break;
+		case sf::Event::JoystickButtonPressed:
+		case sf::Event::JoystickButtonReleased:
+			if (evt.joystickButton.joystickId == 0 &&
+				evt.joystickButton.button < sf::Joystick::ButtonCount)
+			{
+				joystickButtons[evt.joystickButton.button] = evt.type == sf::Event::JoystickButtonPressed;
+			}
+			break;
+		case sf::Event::LostFocus:
+			// releases aren't received without focus
+			keys.reset();
+			mouseButtons.reset();
+			break;
+		default:
+			break;
+		}
+	}
+
+	static void start(Impl::Mode mode, uint32_t seed_)
+	{
+		seed = seed_;
+		frameNumber = 0;
+		keys.reset();
+		mouseButtons.reset();
+		joystickButtons.reset();
+		Utils::Random::seed(seed);
+		Impl::mode = mode;
+	}
+
+	bool record(const std::string_view file)
+	{
+		stop();
+		try
+		{
+			outFile.open(std::filesystem::u8path(file), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (outFile.is_open() == false)
+			{
+				return false;
+			}
+			std::random_device rd;
+			auto newSeed = (uint32_t)rd();
+
+			buffer.clear();
+			buffer.insert(buffer.end(), FileMagic.begin(), FileMagic.end());
+			buffer.push_back(FileVersion);
+			for (int i = 0; i < 4; i++)
+			{
+				buffer.push_back((uint8_t)(newSeed >> (i * 8)));
+			}
+			frameEvents.clear();
+			start(Impl::Mode::Record, newSeed);
+			return true;
+		}
+		catch (std::exception&)
+		{
+			return false;
+		}
+	}
+
+	bool replay(const std::string_view file)
+	{
+		stop();
+		std::vector<uint8_t> data;
+		try
+		{
+			std::ifstream inFile(std::filesystem::u8path(file), std::ios::in | std::ios::binary);
+			if (inFile.is_open() == false)
+			{
+				return false;
+			}
+			std::stringstream ss;
+			ss << inFile.rdbuf();
+			auto str = ss.str();
+			data.assign(str.begin(), str.end());
+		}
+		catch (std::exception&)
+		{
+			return false;
+		}
+
+		constexpr size_t headerSize = FileMagic.size() + 1 + 4;
+		if (data.size() < headerSize ||
+			std::memcmp(data.data(), FileMagic.data(), FileMagic.size()) != 0 ||
+			data[FileMagic.size()] != FileVersion)
+		{
+			return false;
+		}
+		uint32_t fileSeed = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			fileSeed |= (uint32_t)data[FileMagic.size() + 1 + i] << (i * 8);
+		}
+
+		// a truncated last frame (game closed while writing) is ignored
+		frames.clear();
+		Reader reader(data, headerSize);
+		while (reader.atEnd() == false)
+		{
+			Frame frame;
+			frame.frameTime = sf::microseconds((sf::Int64)reader.readVarint());
+			auto numEvents = reader.readVarint();
+			for (uint64_t i = 0; i < numEvents && reader.hasError() == false; i++)
+			{
+				sf::Event evt;
+				if (readEvent(reader, evt) == false)
+				{
+					break;
+				}
+				frame.events.push_back(evt);
+			}
+			if (reader.hasError() == true ||
+				frame.events.size() != numEvents)
+			{
+				break;
+			}
+			frames.push_back(std::move(frame));
+		}
+		frameIdx = 0;
+		start(Impl::Mode::Replay, fileSeed);
+		return true;
+	}
+
+	void Impl::addEvent(const sf::Event& evt)
+	{
+		frameEvents.push_back(evt);
+		updateHeldInput(evt);
+	}
+
+	const std::vector<sf::Event>* nextFrame()
+	{
+		if (isReplaying() == false ||
+			frameIdx >= frames.size())
+		{
+			stop();
+			return nullptr;
+		}
+		const auto& frame = frames[frameIdx++];
+		for (const auto& evt : frame.events)
+		{
+			updateHeldInput(evt);
+		}
+		return &frame.events;
+	}
+
+	sf::Time endFrame(sf::Time frameTime)
+	{
+		if (Impl::mode == Impl::Mode::None)
+		{
+			return frameTime;
+		}
+		if (isRecording() == true)
+		{
+			writeVarint(buffer, (uint64_t)std::max(frameTime.asMicroseconds(), (sf::Int64)0));
+			writeVarint(buffer, frameEvents.size());
+			for (const auto& evt : frameEvents)
+			{
+				writeEvent(buffer, evt);
+			}
+			frameEvents.clear();
+			if (buffer.size() >= WriteBufferSize)
+			{
+				outFile.write((const char*)buffer.data(), buffer.size());
+				outFile.flush();
+				buffer.clear();
+			}
+		}
+		else if (frameIdx > 0)
+		{
+			frameTime = frames[frameIdx - 1].frameTime;
+		}
+
+		// the same numbers every frame, even if the previous frames used more
+		frameNumber++;
+		Utils::Random::seed(seed ^ (uint32_t)(frameNumber * 0x9E3779B9u));
+		return frameTime;
+	}
+
+	size_t getFrameCount() noexcept
+	{
+		return frames.size();
+	}
+
+	bool isKeyPressed(sf::Keyboard::Key key) noexcept
+	{
+		return key >= 0 && key < sf::Keyboard::KeyCount && keys[key];
+	}
+
+	bool isMouseButtonPressed(sf::Mouse::Button button) noexcept
+	{
+		return button >= 0 && button < sf::Mouse::ButtonCount && mouseButtons[button];
+	}
+
+	bool isJoystickButtonPressed(unsigned button) noexcept
+	{
+		return button < sf::Joystick::ButtonCount && joystickButtons[button];
+	}
+
+	void stop()
+	{
+		if (isRecording() == true)
+		{
+			try
+			{
+				outFile.write((const char*)buffer.data(), buffer.size());
+				outFile.close();
+			}
+			catch (std::exception&) {}
+			buffer.clear();
+			frameEvents.clear();
+		}
+		Impl::mode = Impl::Mode::None;
+	}
+}
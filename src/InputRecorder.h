@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <string_view>
+#include <vector>
+
+// records the input events and frame times of a game to a binary file and
+// replays them instead of the live input (--record-input / --replay-input).
+// the random generator is seeded from the file in both cases and reseeded
+// every frame, so a replay runs the same updates as the recorded game.
+// mouse and touch positions are stored in game coordinates, so replays
+// also work without a window (BenchRunner) or with a different window size.
+//
+// file (little endian):
+// "DGIR", uint8 version, uint32 seed, then for each frame:
+// varint frameTime (microseconds), varint eventCount, events.
+// events are a uint8 type followed by the used fields as varints
+// (signed values zigzag encoded) or floats.
+namespace InputRecorder
+{
+	namespace Impl
+	{
+		enum class Mode
+		{
+			None,
+			Record,
+			Replay
+		};
+
+		inline Mode mode{ Mode::None };
+
+		void addEvent(const sf::Event& evt);
+	}
+
+	// starts recording to file. returns false if the file can't be created.
+	bool record(const std::string_view file);
+
+	// loads file and starts replaying it. returns false if it can't be loaded.
+	bool replay(const std::string_view file);
+
+	inline bool isRecording() noexcept { return Impl::mode == Impl::Mode::Record; }
+	inline bool isReplaying() noexcept { return Impl::mode == Impl::Mode::Replay; }
+
+	// adds a live event (in game coordinates) to the current frame when recording.
+	inline void addEvent(const sf::Event& evt)
+	{
+		if (isRecording() == true)
+		{
+			Impl::addEvent(evt);
+		}
+	}
+
+	// the events of the next replayed frame or nullptr if the replay ended.
+	const std::vector<sf::Event>* nextFrame();
+
+	// ends the frame and reseeds the random generator. when recording, it
+	// writes the frame. returns the frame time to use (the recorded one when
+	// replaying).
+	sf::Time endFrame(sf::Time frameTime);
+
+	// number of frames in the replay.
+	size_t getFrameCount() noexcept;
+
+	// held keys and buttons, based on the recorded events.
+	bool isKeyPressed(sf::Keyboard::Key key) noexcept;
+	bool isMouseButtonPressed(sf::Mouse::Button button) noexcept;
+	bool isJoystickButtonPressed(unsigned button) noexcept;
+
+	// writes the remaining frames and stops recording/replaying.
+	void stop();
+}
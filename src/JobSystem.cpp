@@ -0,0 +1,306 @@
+#include "JobSystem.h"
+#include <cstdio>
+#include <exception>
+
+thread_local size_t JobSystem::workerIndex{ (size_t)-1 };
+
+// a job that throws is logged and counts as finished,
+// so it doesn't stop the worker (or the game) and wait() returns.
+static void runJobFunc(const std::function<void()>& func) noexcept
+{
+	try
+	{
+		func();
+	}
+	catch (std::exception& ex)
+	{
+		std::fprintf(stderr, "job failed: %s\n", ex.what());
+	}
+	catch (...)
+	{
+		std::fprintf(stderr, "job failed\n");
+	}
+}
+
+JobSystem::JobSystem() : mainThreadId(std::this_thread::get_id()),
+	numWorkers(defaultWorkerCount()) {}
+
+unsigned JobSystem::defaultWorkerCount() noexcept
+{
+	auto count = std::thread::hardware_concurrency();
+	return count > 1 ? count - 1 : 0;
+}
+
+void JobSystem::WorkerCount(unsigned count)
+{
+	stop();
+	numWorkers = count;
+}
+
+void JobSystem::startIfStopped()
+{
+	if (started.load(std::memory_order_acquire) == true)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(startMutex);
+	if (started.load(std::memory_order_relaxed) == true)
+	{
+		return;
+	}
+	stopping = false;
+	queues.clear();
+	for (unsigned i = 0; i <= numWorkers; i++)
+	{
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+	for (unsigned i = 0; i < numWorkers; i++)
+	{
+		workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+	started.store(true, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(size_t index)
+{
+	workerIndex = index;
+	Job job;
+	while (true)
+	{
+		if (pop(index, job) == true ||
+			steal(index, job) == true)
+		{
+			execute(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]()
+		{
+			return queuedJobs.load() > 0 || stopping.load() == true;
+		});
+		if (stopping.load() == true && queuedJobs.load() == 0)
+		{
+			break;
+		}
+	}
+	workerIndex = (size_t)-1;
+}
+
+void JobSystem::push(Job&& job)
+{
+	startIfStopped();
+	auto index = workerIndex < numWorkers ? workerIndex : numWorkers;
+	unfinishedJobs++;
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->jobs.push_back(std::move(job));
+	}
+	queuedJobs++;
+	{
+		// prevents a worker from missing the notification between
+		// checking queuedJobs and going to sleep
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+}
+
+bool JobSystem::pop(size_t index, Job& job)
+{
+	auto& queue = *queues[index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty() == true)
+	{
+		return false;
+	}
+	// newest first (cache friendly)
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	queuedJobs--;
+	return true;
+}
+
+bool JobSystem::steal(size_t index, Job& job)
+{
+	for (size_t i = 1; i <= queues.size(); i++)
+	{
+		auto& queue = *queues[(index + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty() == false)
+		{
+			// oldest first
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			queuedJobs--;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::tryRunJob()
+{
+	Job job;
+	if (isMainThread() == true)
+	{
+		std::unique_lock<std::mutex> lock(mainQueue.mutex);
+		if (mainQueue.jobs.empty() == false)
+		{
+			job = std::move(mainQueue.jobs.front());
+			mainQueue.jobs.pop_front();
+			lock.unlock();
+			runJobFunc(job.func);
+			finish(job.counter);
+			return true;
+		}
+	}
+	if (started.load(std::memory_order_acquire) == false)
+	{
+		return false;
+	}
+	auto index = workerIndex < numWorkers ? workerIndex : numWorkers;
+	if (pop(index, job) == true ||
+		steal(index, job) == true)
+	{
+		execute(job);
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::execute(Job& job)
+{
+	runJobFunc(job.func);
+	job.func = nullptr;
+	finish(job.counter);
+	unfinishedJobs--;
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+	if (counter == nullptr)
+	{
+		return;
+	}
+	decltype(counter->continuations) continuations;
+	{
+		// the waiting thread locks the mutex after the count reaches zero,
+		// so the counter is alive until the mutex is released
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+		continuations = std::move(counter->continuations);
+	}
+	for (auto& continuation : continuations)
+	{
+		push({ std::move(continuation.first), continuation.second });
+	}
+}
+
+void JobSystem::run(std::function<void()> func, JobCounter* counter)
+{
+	if (counter != nullptr)
+	{
+		counter->pending++;
+	}
+	push({ std::move(func), counter });
+}
+
+void JobSystem::runOnMainThread(std::function<void()> func, JobCounter* counter)
+{
+	if (counter != nullptr)
+	{
+		counter->pending++;
+	}
+	std::lock_guard<std::mutex> lock(mainQueue.mutex);
+	mainQueue.jobs.push_back({ std::move(func), counter });
+}
+
+void JobSystem::then(JobCounter& dependency, std::function<void()> func, JobCounter* counter)
+{
+	if (counter != nullptr)
+	{
+		counter->pending++;
+	}
+	{
+		std::lock_guard<std::mutex> lock(dependency.mutex);
+		if (dependency.done() == false)
+		{
+			dependency.continuations.push_back({ std::move(func), counter });
+			return;
+		}
+	}
+	push({ std::move(func), counter });
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	while (counter.done() == false)
+	{
+		if (tryRunJob() == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+	// see finish()
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::runMainThreadJobs()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(mainQueue.mutex);
+			if (mainQueue.jobs.empty() == true)
+			{
+				break;
+			}
+			job = std::move(mainQueue.jobs.front());
+			mainQueue.jobs.pop_front();
+		}
+		runJobFunc(job.func);
+		finish(job.counter);
+	}
+
+	// without workers, jobs nobody waits on run here
+	if (numWorkers == 0 &&
+		started.load(std::memory_order_acquire) == true)
+	{
+		Job job;
+		while (steal(numWorkers, job) == true)
+		{
+			execute(job);
+		}
+	}
+}
+
+void JobSystem::stop()
+{
+	if (started.load(std::memory_order_acquire) == false)
+	{
+		runMainThreadJobs();
+		return;
+	}
+	while (unfinishedJobs.load() > 0)
+	{
+		if (tryRunJob() == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+	runMainThreadJobs();
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	sleepCondition.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+	started.store(false, std::memory_order_release);
+}
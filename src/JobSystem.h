@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// counts the unfinished jobs that were started with it.
+// jobs added with JobSystem::then run when the count reaches zero.
+class JobCounter
+{
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> pending{ 0 };
+	std::mutex mutex;
+	std::vector<std::pair<std::function<void()>, JobCounter*>> continuations;
+
+public:
+	bool done() const noexcept { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// worker thread pool with one work-stealing queue per worker.
+// workers start on the first job. jobs that use OpenGL (textures, render targets)
+// must be run with runOnMainThread.
+class JobSystem
+{
+private:
+	struct Job
+	{
+		std::function<void()> func;
+		JobCounter* counter{ nullptr };
+	};
+
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	// one per worker, plus one (the last) for the jobs
+	// queued by non-worker threads.
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+	WorkQueue mainQueue;
+
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	// jobs in the worker queues
+	std::atomic<size_t> queuedJobs{ 0 };
+	// queued and running jobs (worker queues only)
+	std::atomic<size_t> unfinishedJobs{ 0 };
+	std::atomic<bool> stopping{ false };
+
+	std::mutex startMutex;
+	std::atomic<bool> started{ false };
+	std::thread::id mainThreadId;
+	unsigned numWorkers{ 0 };
+
+	static thread_local size_t workerIndex;
+
+	void startIfStopped();
+	void workerLoop(size_t index);
+
+	void push(Job&& job);
+	bool pop(size_t index, Job& job);
+	bool steal(size_t index, Job& job);
+	bool tryRunJob();
+	void execute(Job& job);
+	void finish(JobCounter* counter);
+
+public:
+	JobSystem();
+	~JobSystem() { stop(); }
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// hardware concurrency - 1 (the main thread also runs jobs while waiting).
+	static unsigned defaultWorkerCount() noexcept;
+
+	unsigned WorkerCount() const noexcept { return numWorkers; }
+
+	// waits for all jobs and restarts the workers on the next job.
+	void WorkerCount(unsigned count);
+
+	bool isMainThread() const noexcept { return std::this_thread::get_id() == mainThreadId; }
+
+	void run(std::function<void()> func, JobCounter* counter = nullptr);
+
+	// queues a job that runs on the main thread (in Game::play or while the main thread waits).
+	void runOnMainThread(std::function<void()> func, JobCounter* counter = nullptr);
+
+	// runs func (with counter) after dependency's jobs finish.
+	void then(JobCounter& dependency, std::function<void()> func, JobCounter* counter = nullptr);
+
+	// runs other jobs until counter's jobs finish.
+	void wait(JobCounter& counter);
+
+	// runs the queued main thread jobs. call from the main thread only.
+	void runMainThreadJobs();
+
+	// waits for all jobs and stops the workers.
+	void stop();
+
+	// calls func(i) for each i in [begin, end), in chunks of grainSize.
+	// returns after all the calls finish.
+	template <class Func>
+	void parallel_for(size_t begin, size_t end, size_t grainSize, Func&& func)
+	{
+		if (begin >= end)
+		{
+			return;
+		}
+		if (grainSize == 0)
+		{
+			grainSize = 1;
+		}
+		JobCounter counter;
+		for (auto chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+		{
+			auto chunkEnd = std::min(chunkBegin + grainSize, end);
+			run([chunkBegin, chunkEnd, &func]()
+			{
+				for (auto i = chunkBegin; i < chunkEnd; i++)
+				{
+					func(i);
+				}
+			}, &counter);
+		}
+		wait(counter);
+	}
+};
@@ -0,0 +1,562 @@
+#include "JsonBinary.h"
+#include <cstring>
+#include "JsonUtils.h"
+#include <limits>
+#include "Utils/LZ4.h"
+
+namespace JsonBinary
+{
+	using namespace rapidjson;
+
+	enum class Token : uint8_t
+	{
+		Null,
+		False,
+		True,
+		Int,
+		Uint,
+		Double,
+		// string or key, written the first time it's used
+		StringNew,
+		// index of a string already written
+		StringRef,
+		StartObject,
+		EndObject,
+		StartArray,
+		EndArray,
+		Int16Array,
+		// array written with kFormatSingleLineArray
+		StartSingleLineArray
+	};
+
+	// flags
+	constexpr uint8_t Compressed = 0x01;
+
+	// the header's uncompressed size is only trusted up to this
+	constexpr uint64_t MaxDataSize = 256 * 1024 * 1024;
+	// an lz4 byte never expands to more than 255 bytes
+	constexpr uint64_t MaxCompressionRatio = 255;
+
+	template <class T>
+	static void writeVarint(T& out, uint64_t val)
+	{
+		while (val >= 0x80)
+		{
+			out.push_back((uint8_t)(val | 0x80));
+			val >>= 7;
+		}
+		out.push_back((uint8_t)val);
+	}
+
+	static void writeZigzag(std::vector<uint8_t>& out, int64_t val)
+	{
+		writeVarint(out, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+	}
+
+	static void writeToken(std::vector<uint8_t>& out, Token token)
+	{
+		out.push_back((uint8_t)token);
+	}
+
+	bool isBinary(const std::string_view data) noexcept
+	{
+		return data.size() > Header.size() &&
+			data.substr(0, Header.size()) == Header;
+	}
+
+	void Writer::writeString(const std::string_view str)
+	{
+		auto it = strings.find(std::string(str));
+		if (it != strings.end())
+		{
+			writeToken(data, Token::StringRef);
+			writeVarint(data, it->second);
+			return;
+		}
+		strings.insert(std::make_pair(std::string(str), (uint32_t)strings.size()));
+		writeToken(data, Token::StringNew);
+		writeVarint(data, str.size());
+		data.insert(data.end(), str.begin(), str.end());
+	}
+
+	bool Writer::Null()
+	{
+		writeToken(data, Token::Null);
+		return true;
+	}
+
+	bool Writer::Bool(bool b)
+	{
+		writeToken(data, b == true ? Token::True : Token::False);
+		return true;
+	}
+
+	bool Writer::Int64(int64_t i)
+	{
+		writeToken(data, Token::Int);
+		writeZigzag(data, i);
+		return true;
+	}
+
+	bool Writer::Uint64(uint64_t u)
+	{
+		writeToken(data, Token::Uint);
+		writeVarint(data, u);
+		return true;
+	}
+
+	bool Writer::Double(double d)
+	{
+		writeToken(data, Token::Double);
+		uint64_t bits;
+		std::memcpy(&bits, &d, sizeof(bits));
+		for (int i = 0; i < 8; i++)
+		{
+			data.push_back((uint8_t)(bits >> (i * 8)));
+		}
+		return true;
+	}
+
+	bool Writer::String(const char* str, SizeType length, bool copy)
+	{
+		writeString({ str, length });
+		return true;
+	}
+
+	bool Writer::Key(const char* str, SizeType length, bool copy)
+	{
+		writeString({ str, length });
+		return true;
+	}
+
+	bool Writer::StartObject()
+	{
+		writeToken(data, Token::StartObject);
+		return true;
+	}
+
+	bool Writer::EndObject(SizeType memberCount)
+	{
+		writeToken(data, Token::EndObject);
+		return true;
+	}
+
+	bool Writer::StartArray()
+	{
+		writeToken(data, (formatOptions & kFormatSingleLineArray) != 0 ?
+			Token::StartSingleLineArray : Token::StartArray);
+		return true;
+	}
+
+	bool Writer::EndArray(SizeType elementCount)
+	{
+		writeToken(data, Token::EndArray);
+		return true;
+	}
+
+	bool Writer::Int16Array(const std::vector<int16_t>& values)
+	{
+		writeToken(data, Token::Int16Array);
+		writeVarint(data, values.size());
+		int16_t prevValue = 0;
+		for (size_t i = 0; i < values.size();)
+		{
+			auto value = values[i];
+			size_t run = 1;
+			while (i + run < values.size() && values[i + run] == value)
+			{
+				run++;
+			}
+			writeVarint(data, run);
+			writeZigzag(data, (int64_t)value - prevValue);
+			prevValue = value;
+			i += run;
+		}
+		return true;
+	}
+
+	std::string Writer::getFile(bool compress) const
+	{
+		std::string file(Header);
+		file.push_back((char)Version);
+
+		std::vector<uint8_t> compressed;
+		if (compress == true)
+		{
+			compressed.resize(LZ4::compressBound(data.size()));
+			auto compressedSize = LZ4::compress(data.data(), data.size(),
+				compressed.data(), compressed.size());
+			compressed.resize(compressedSize < data.size() ? compressedSize : 0);
+		}
+		file.push_back((char)(compressed.empty() == false ? Compressed : 0));
+		writeVarint(file, data.size());
+		if (compressed.empty() == false)
+		{
+			file.append((const char*)compressed.data(), compressed.size());
+		}
+		else
+		{
+			file.append((const char*)data.data(), data.size());
+		}
+		return file;
+	}
+
+	class Reader
+	{
+	private:
+		const uint8_t* data;
+		size_t size;
+		size_t pos{ 0 };
+		bool error{ false };
+
+	public:
+		Reader(const uint8_t* data_, size_t size_) : data(data_), size(size_) {}
+
+		bool atEnd() const noexcept { return pos >= size; }
+		bool hasError() const noexcept { return error; }
+		size_t position() const noexcept { return pos; }
+
+		uint8_t readByte() noexcept
+		{
+			if (pos >= size)
+			{
+				error = true;
+				return 0;
+			}
+			return data[pos++];
+		}
+
+		uint64_t readVarint() noexcept
+		{
+			uint64_t val = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				auto byte = readByte();
+				val |= (uint64_t)(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return val;
+				}
+			}
+			error = true;
+			return 0;
+		}
+
+		int64_t readZigzag() noexcept
+		{
+			auto val = readVarint();
+			return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+		}
+
+		double readDouble() noexcept
+		{
+			uint64_t bits = 0;
+			for (int i = 0; i < 8; i++)
+			{
+				bits |= (uint64_t)readByte() << (i * 8);
+			}
+			double val;
+			std::memcpy(&val, &bits, sizeof(val));
+			return val;
+		}
+
+		std::string_view readBytes(size_t numBytes) noexcept
+		{
+			if (numBytes > size - pos)
+			{
+				error = true;
+				pos = size;
+				return {};
+			}
+			std::string_view bytes((const char*)data + pos, numBytes);
+			pos += numBytes;
+			return bytes;
+		}
+	};
+
+	static bool readInt16Array(Reader& reader, std::string& packed)
+	{
+		auto count = reader.readVarint();
+		// the packed array can't be bigger than the data
+		if (reader.hasError() == true ||
+			count > MaxDataSize / sizeof(int16_t))
+		{
+			return false;
+		}
+		packed.assign(JsonUtils::PackedInt16Header);
+		int16_t value = 0;
+		uint64_t numValues = 0;
+		while (numValues < count)
+		{
+			auto run = reader.readVarint();
+			value = (int16_t)(value + reader.readZigzag());
+			if (reader.hasError() == true ||
+				run == 0 || run > count - numValues)
+			{
+				return false;
+			}
+			for (uint64_t i = 0; i < run; i++)
+			{
+				packed.append((const char*)&value, sizeof(int16_t));
+			}
+			numValues += run;
+		}
+		return true;
+	}
+
+	using JsonWriter = PrettyWriter<StringBuffer>;
+
+	static void startArray(Document& doc, bool singleLine)
+	{
+		doc.StartArray();
+	}
+
+	static void startArray(JsonWriter& writer, bool singleLine)
+	{
+		if (singleLine == true)
+		{
+			writer.SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
+		}
+		writer.StartArray();
+	}
+
+	static void endArray(Document& doc, SizeType count, bool singleLine)
+	{
+		doc.EndArray(count);
+	}
+
+	static void endArray(JsonWriter& writer, SizeType count, bool singleLine)
+	{
+		writer.EndArray(count);
+		if (singleLine == true)
+		{
+			writer.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+		}
+	}
+
+	static void writeInt16Array(Document& doc, const std::string& packed)
+	{
+		doc.String(packed.data(), (SizeType)packed.size(), true);
+	}
+
+	// same as Save::Writer::Int16Array
+	static void writeInt16Array(JsonWriter& writer, const std::string& packed)
+	{
+		writer.SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
+		writer.StartArray();
+		for (size_t i = JsonUtils::PackedInt16Header.size(); i + 1 < packed.size(); i += 2)
+		{
+			int16_t val;
+			std::memcpy(&val, packed.data() + i, sizeof(val));
+			writer.Int(val);
+		}
+		writer.EndArray();
+		writer.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+	}
+
+	// Handler is a Document (load) or a JsonWriter (Writer::getJson).
+	template <class Handler>
+	static bool readDocument(Reader& reader, Handler& doc)
+	{
+		struct Container
+		{
+			bool isObject;
+			bool singleLine;
+			SizeType count;
+		};
+		std::vector<Container> containers;
+		std::vector<std::string_view> strings;
+		std::string packed;
+		bool keyNext = false;
+		bool hasRoot = false;
+
+		while (reader.atEnd() == false)
+		{
+			if (hasRoot == true)
+			{
+				return false;
+			}
+			auto token = (Token)reader.readByte();
+			std::string_view str;
+			if (token == Token::StringNew)
+			{
+				str = reader.readBytes(reader.readVarint());
+				strings.push_back(str);
+			}
+			else if (token == Token::StringRef)
+			{
+				auto idx = reader.readVarint();
+				if (idx >= strings.size())
+				{
+					return false;
+				}
+				str = strings[idx];
+			}
+			if (reader.hasError() == true)
+			{
+				return false;
+			}
+			if (keyNext == true)
+			{
+				if (token == Token::EndObject)
+				{
+					doc.EndObject(containers.back().count);
+					containers.pop_back();
+				}
+				else if (token == Token::StringNew || token == Token::StringRef)
+				{
+					doc.Key(str.data(), (SizeType)str.size(), true);
+					keyNext = false;
+					continue;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			else
+			{
+				switch (token)
+				{
+				case Token::Null:
+					doc.Null();
+					break;
+				case Token::False:
+					doc.Bool(false);
+					break;
+				case Token::True:
+					doc.Bool(true);
+					break;
+				case Token::Int:
+					doc.Int64(reader.readZigzag());
+					break;
+				case Token::Uint:
+					doc.Uint64(reader.readVarint());
+					break;
+				case Token::Double:
+					doc.Double(reader.readDouble());
+					break;
+				case Token::StringNew:
+				case Token::StringRef:
+					doc.String(str.data(), (SizeType)str.size(), true);
+					break;
+				case Token::StartObject:
+					doc.StartObject();
+					containers.push_back({ true, false, 0 });
+					keyNext = true;
+					continue;
+				case Token::StartArray:
+				case Token::StartSingleLineArray:
+				{
+					bool singleLine = token == Token::StartSingleLineArray;
+					startArray(doc, singleLine);
+					containers.push_back({ false, singleLine, 0 });
+					continue;
+				}
+				case Token::EndArray:
+				{
+					if (containers.empty() == true ||
+						containers.back().isObject == true)
+					{
+						return false;
+					}
+					endArray(doc, containers.back().count, containers.back().singleLine);
+					containers.pop_back();
+					break;
+				}
+				case Token::Int16Array:
+				{
+					if (readInt16Array(reader, packed) == false)
+					{
+						return false;
+					}
+					writeInt16Array(doc, packed);
+					break;
+				}
+				default:
+					return false;
+				}
+			}
+			if (reader.hasError() == true)
+			{
+				return false;
+			}
+			// a value was added to the current container (or it's the root)
+			if (containers.empty() == true)
+			{
+				hasRoot = true;
+			}
+			else
+			{
+				containers.back().count++;
+				keyNext = containers.back().isObject;
+			}
+		}
+		return hasRoot;
+	}
+
+	std::string Writer::getJson() const
+	{
+		StringBuffer buffer(0, std::numeric_limits<uint16_t>::max());
+		JsonWriter writer(buffer);
+		writer.SetIndent(' ', 2);
+
+		Reader reader(data.data(), data.size());
+		if (readDocument(reader, writer) == false)
+		{
+			return {};
+		}
+		return { buffer.GetString(), buffer.GetSize() };
+	}
+
+	bool load(const std::string_view file, Document& doc)
+	{
+		if (isBinary(file) == false)
+		{
+			return false;
+		}
+		Reader header((const uint8_t*)file.data() + Header.size(),
+			file.size() - Header.size());
+		auto version = header.readByte();
+		auto flags = header.readByte();
+		auto dataSize = header.readVarint();
+		if (header.hasError() == true ||
+			version == 0 || version > Version)
+		{
+			return false;
+		}
+		auto data = (const uint8_t*)file.data() + Header.size() + header.position();
+		auto size = file.size() - Header.size() - header.position();
+
+		std::vector<uint8_t> decompressed;
+		if ((flags & Compressed) != 0)
+		{
+			if (dataSize > MaxDataSize ||
+				dataSize > (uint64_t)size * MaxCompressionRatio)
+			{
+				return false;
+			}
+			decompressed.resize((size_t)dataSize);
+			if (LZ4::decompress(data, size, decompressed.data(), decompressed.size()) == false)
+			{
+				return false;
+			}
+			data = decompressed.data();
+			size = decompressed.size();
+		}
+		else if (dataSize != size)
+		{
+			return false;
+		}
+
+		bool success = false;
+		auto parseFunc = [&](Document& doc) -> bool
+		{
+			Reader reader(data, size);
+			success = readDocument(reader, doc);
+			return success;
+		};
+		doc.Populate(parseFunc);
+		return success;
+	}
+}
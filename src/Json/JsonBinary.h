@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include "Json/JsonParser.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// compact binary encoding of json documents (binary saves).
+//
+// file (little endian):
+// "DGJB", uint8 version, uint8 flags, varint data size, data.
+// if flags has Compressed, data is stored as an LZ4 block.
+// data is a stream of uint8 tokens, each followed by its value:
+// ints as zigzag varints, uints as varints and doubles as 8 bytes.
+// strings and keys are written once (varint size + bytes) and then
+// referenced by index. int16 arrays (map layers) are a varint count and
+// runs of varint length + zigzag varint delta to the previous run's value.
+// arrays written with kFormatSingleLineArray keep it, so the data can be
+// written back as the same json.
+namespace JsonBinary
+{
+	constexpr std::string_view Header{ "DGJB" };
+	constexpr uint8_t Version = 1;
+
+	bool isBinary(const std::string_view data) noexcept;
+
+	// SAX writer with the same interface as rapidjson's writers.
+	class Writer
+	{
+	private:
+		std::vector<uint8_t> data;
+		std::unordered_map<std::string, uint32_t> strings;
+		rapidjson::PrettyFormatOptions formatOptions{ rapidjson::PrettyFormatOptions::kFormatDefault };
+
+		void writeString(const std::string_view str);
+
+	public:
+		void SetFormatOptions(rapidjson::PrettyFormatOptions options) noexcept { formatOptions = options; }
+
+		bool Null();
+		bool Bool(bool b);
+		bool Int(int i) { return Int64(i); }
+		bool Uint(unsigned u) { return Uint64(u); }
+		bool Int64(int64_t i);
+		bool Uint64(uint64_t u);
+		bool Double(double d);
+		bool String(const char* str, rapidjson::SizeType length, bool copy = false);
+		bool String(const std::string& str) { return String(str.data(), (rapidjson::SizeType)str.size()); }
+		bool Key(const char* str, rapidjson::SizeType length, bool copy = false);
+		bool Key(const std::string& str) { return Key(str.data(), (rapidjson::SizeType)str.size()); }
+		bool StartObject();
+		bool EndObject(rapidjson::SizeType memberCount = 0);
+		bool StartArray();
+		bool EndArray(rapidjson::SizeType elementCount = 0);
+
+		// writes a map layer. loaded as a packed int16 array.
+		bool Int16Array(const std::vector<int16_t>& values);
+
+		// the file (header and data). if compress is true, the data
+		// is LZ4 compressed (unless it doesn't get smaller).
+		std::string getFile(bool compress) const;
+
+		// the data as json, formatted the same as writing it with
+		// a PrettyWriter (indented with 2 spaces).
+		std::string getJson() const;
+	};
+
+	// loads a file written by Writer. int16 arrays are loaded as packed
+	// int16 arrays (see JsonUtils::loadJsonPacked).
+	bool load(const std::string_view file, rapidjson::Document& doc);
+}
@@ -1,5 +1,9 @@
 #include "JsonUtils.h"
+#include <cstring>
 #include "Game.h"
+#include "JsonBinary.h"
+#include "rapidjson/encodedstream.h"
+#include "rapidjson/memorystream.h"
 #include "Utils/Utils.h"
 
 namespace JsonUtils
@@ -113,7 +117,8 @@ namespace JsonUtils
 		const Variable& var, bool changeValueType)
 	{
 		if (elem.IsString() == false ||
-			elem.GetStringLength() == 0)
+			elem.GetStringLength() == 0 ||
+			isPackedInt16Array(elem) == true)
 		{
 			return;
 		}
@@ -138,7 +143,8 @@ namespace JsonUtils
 		const Queryable& obj, bool changeValueType)
 	{
 		if (elem.IsString() == false ||
-			elem.GetStringLength() <= 2)
+			elem.GetStringLength() <= 2 ||
+			isPackedInt16Array(elem) == true)
 		{
 			return;
 		}
@@ -193,6 +199,10 @@ namespace JsonUtils
 	{
 		if (elem.IsString() == true)
 		{
+			if (isPackedInt16Array(elem) == true)
+			{
+				return;
+			}
 			auto str1 = elem.GetStringView();
 			std::string str2(str1);
 			Utils::replaceStringInPlace(str2, oldStr, newStr);
@@ -251,8 +261,8 @@ namespace JsonUtils
 	{
 		if (elem.IsString() == true)
 		{
-			if (elem.IsString() == false ||
-				elem.GetStringLength() <= 2)
+			if (elem.GetStringLength() <= 2 ||
+				isPackedInt16Array(elem) == true)
 			{
 				return;
 			}
@@ -390,6 +400,164 @@ namespace JsonUtils
 		return (doc.Parse(json.data(), json.size()).HasParseError() == false);
 	}
 
+	// SAX handler that builds a Document, except for integer arrays with
+	// the key "data" (map layers), which are streamed into a packed int16
+	// string instead of one DOM value per element. if a "data" array holds
+	// anything other than int16 values, it falls back to a DOM array.
+	class PackedDataHandler
+	{
+	private:
+		Document& doc;
+		std::string packed;
+		bool nextIsData{ false };
+		bool packing{ false };
+
+		void packedToArray()
+		{
+			doc.StartArray();
+			auto size = (packed.size() - PackedInt16Header.size()) / sizeof(int16_t);
+			for (size_t i = 0; i < size; i++)
+			{
+				int16_t val;
+				std::memcpy(&val,
+					packed.data() + PackedInt16Header.size() + i * sizeof(int16_t),
+					sizeof(int16_t));
+				doc.Int(val);
+			}
+			packing = false;
+		}
+
+		void beginValue()
+		{
+			nextIsData = false;
+			if (packing == true)
+			{
+				packedToArray();
+			}
+		}
+
+		bool pack(int64_t val)
+		{
+			if (packing == false)
+			{
+				nextIsData = false;
+				return false;
+			}
+			if (val < std::numeric_limits<int16_t>::min() ||
+				val > std::numeric_limits<int16_t>::max())
+			{
+				packedToArray();
+				return false;
+			}
+			auto val16 = (int16_t)val;
+			packed.append((const char*)&val16, sizeof(int16_t));
+			return true;
+		}
+
+	public:
+		PackedDataHandler(Document& doc_) : doc(doc_) {}
+
+		bool Null() { beginValue(); return doc.Null(); }
+		bool Bool(bool b) { beginValue(); return doc.Bool(b); }
+		bool Int(int i) { return pack(i) == true || doc.Int(i); }
+		bool Uint(unsigned i) { return pack(i) == true || doc.Uint(i); }
+		bool Int64(int64_t i) { return pack(i) == true || doc.Int64(i); }
+		bool Uint64(uint64_t i) { beginValue(); return doc.Uint64(i); }
+		bool Double(double d) { beginValue(); return doc.Double(d); }
+		bool RawNumber(const char* str, SizeType length, bool copy)
+		{
+			beginValue();
+			return doc.RawNumber(str, length, copy);
+		}
+		bool String(const char* str, SizeType length, bool copy)
+		{
+			beginValue();
+			return doc.String(str, length, copy);
+		}
+		bool StartObject() { beginValue(); return doc.StartObject(); }
+		bool Key(const char* str, SizeType length, bool copy)
+		{
+			nextIsData = (std::string_view(str, length) == "data");
+			return doc.Key(str, length, copy);
+		}
+		bool EndObject(SizeType memberCount) { return doc.EndObject(memberCount); }
+		bool StartArray()
+		{
+			if (nextIsData == true && packing == false)
+			{
+				nextIsData = false;
+				packing = true;
+				packed.assign(PackedInt16Header);
+				return true;
+			}
+			beginValue();
+			return doc.StartArray();
+		}
+		bool EndArray(SizeType elementCount)
+		{
+			if (packing == true)
+			{
+				packing = false;
+				return doc.String(packed.data(), (SizeType)packed.size(), true);
+			}
+			return doc.EndArray(elementCount);
+		}
+	};
+
+	bool loadFilePacked(const std::string_view file, Document& doc)
+	{
+		if (file.empty() == true)
+		{
+			return false;
+		}
+		return loadJsonPacked(FileUtils::readText(file.data()), doc);
+	}
+
+	bool loadJsonPacked(const std::string_view json, Document& doc)
+	{
+		if (json.empty() == true)
+		{
+			return false;
+		}
+		if (JsonBinary::isBinary(json) == true)
+		{
+			return JsonBinary::load(json, doc);
+		}
+		bool success = false;
+		auto parseFunc = [&json, &success](Document& doc) -> bool
+		{
+			MemoryStream ms(json.data(), json.size());
+			EncodedInputStream<UTF8<>, MemoryStream> is(ms);
+			PackedDataHandler handler(doc);
+			Reader reader;
+			success = (reader.Parse(is, handler).IsError() == false);
+			return success;
+		};
+		doc.Populate(parseFunc);
+		return success;
+	}
+
+	bool isPackedInt16Array(const Value& elem)
+	{
+		return (elem.IsString() == true &&
+			elem.GetStringLength() >= PackedInt16Header.size() &&
+			elem.GetStringView().substr(0, PackedInt16Header.size()) == PackedInt16Header);
+	}
+
+	size_t getPackedInt16ArraySize(const Value& elem)
+	{
+		return (elem.GetStringLength() - PackedInt16Header.size()) / sizeof(int16_t);
+	}
+
+	int16_t getPackedInt16(const Value& elem, size_t index)
+	{
+		int16_t val;
+		std::memcpy(&val,
+			elem.GetString() + PackedInt16Header.size() + index * sizeof(int16_t),
+			sizeof(int16_t));
+		return val;
+	}
+
 	bool loadJsonAndReplaceValues(const std::string_view json, Document& doc,
 		const Game& obj, bool changeValueType, char token)
 	{
@@ -54,6 +54,29 @@ namespace JsonUtils
 	// loads json from a json string
 	bool loadJson(const std::string_view json, rapidjson::Document& doc);
 
+	// header of the string values that replace "data" integer arrays
+	// when loading with loadFilePacked/loadJsonPacked.
+	constexpr std::string_view PackedInt16Header{ "\0i16", 4 };
+
+	// loads json from a file. see loadJsonPacked.
+	bool loadFilePacked(const std::string_view file, rapidjson::Document& doc);
+
+	// loads json from a json string using a SAX reader. integer arrays with
+	// the key "data" (map layers, saves) are streamed into a packed int16
+	// string value instead of a DOM array (1 value per cell per layer).
+	// use isPackedInt16Array/getPackedInt16 to read them.
+	// the replaceValue/replaceString functions skip packed arrays.
+	// binary files (JsonBinary, binary saves) are also loaded.
+	bool loadJsonPacked(const std::string_view json, rapidjson::Document& doc);
+
+	bool isPackedInt16Array(const rapidjson::Value& elem);
+
+	// elem must be a packed int16 array.
+	size_t getPackedInt16ArraySize(const rapidjson::Value& elem);
+
+	// elem must be a packed int16 array and index < size.
+	int16_t getPackedInt16(const rapidjson::Value& elem, size_t index);
+
 	// loads json from a json string and
 	// replaces "%str%" with game.getVarOrProp("str")
 	bool loadJsonAndReplaceValues(const std::string_view json, rapidjson::Document& doc,
@@ -0,0 +1,255 @@
+#include "LoadProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include "Utils/AllocationCounter.h"
+#include <vector>
+
+namespace LoadProfiler
+{
+	struct Event
+	{
+		bool isFile{ false };
+		uint16_t nameHash16{ 0 };
+		std::string name;
+		std::string id;
+		int64_t start{ 0 };
+		int64_t duration{ 0 };
+		// time spent in nested events
+		int64_t childDuration{ 0 };
+		uint64_t bytesRead{ 0 };
+		uint64_t allocations{ 0 };
+		size_t parent{ (size_t)-1 };
+	};
+
+	static std::string traceFile;
+	static std::chrono::steady_clock::time_point startTime;
+	static std::vector<Event> events;
+	static size_t currentEvent{ (size_t)-1 };
+	static std::unordered_map<uint16_t, std::string> elemNames;
+
+	static int64_t now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void enable(const std::string_view traceFile_)
+	{
+		traceFile = traceFile_;
+		startTime = std::chrono::steady_clock::now();
+		AllocationCounter::Enabled(true);
+		Impl::enabled = true;
+	}
+
+	void setElemName(uint16_t nameHash16, const std::string_view name)
+	{
+		if (Impl::enabled == true)
+		{
+			elemNames.emplace(nameHash16, name);
+		}
+	}
+
+	static size_t begin(Event&& event)
+	{
+		event.parent = currentEvent;
+		events.push_back(std::move(event));
+		currentEvent = events.size() - 1;
+
+		// snapshot after push_back to not count the profiler's own allocations
+		auto& newEvent = events.back();
+		newEvent.bytesRead = Impl::bytesRead.load(std::memory_order_relaxed);
+		newEvent.allocations = AllocationCounter::get();
+		newEvent.start = now();
+		return currentEvent;
+	}
+
+	size_t Impl::beginFile(const std::string_view fileName)
+	{
+		Event event;
+		event.isFile = true;
+		event.name = fileName;
+		return begin(std::move(event));
+	}
+
+	size_t Impl::beginElem(uint16_t nameHash16, const rapidjson::Value& elem)
+	{
+		Event event;
+		event.nameHash16 = nameHash16;
+		if (elem.IsObject() == true)
+		{
+			for (const auto key : { "id", "file" })
+			{
+				auto it = elem.FindMember(key);
+				if (it != elem.MemberEnd() && it->value.IsString() == true)
+				{
+					event.id = it->value.GetString();
+					break;
+				}
+			}
+		}
+		return begin(std::move(event));
+	}
+
+	void Impl::end(size_t eventIdx)
+	{
+		auto& event = events[eventIdx];
+		event.duration = now() - event.start;
+		event.bytesRead = Impl::bytesRead.load(std::memory_order_relaxed) - event.bytesRead;
+		event.allocations = AllocationCounter::get() - event.allocations;
+		if (event.parent != (size_t)-1)
+		{
+			events[event.parent].childDuration += event.duration;
+		}
+		currentEvent = event.parent;
+	}
+
+	static std::string getEventName(const Event& event)
+	{
+		if (event.isFile == true)
+		{
+			return event.name;
+		}
+		auto it = elemNames.find(event.nameHash16);
+		if (it != elemNames.end())
+		{
+			return it->second;
+		}
+		return std::to_string(event.nameHash16);
+	}
+
+	static void writeTrace()
+	{
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("traceEvents");
+		writer.StartArray();
+		for (const auto& event : events)
+		{
+			writer.StartObject();
+			writer.Key("name");
+			writer.String(getEventName(event));
+			writer.Key("cat");
+			writer.String(event.isFile == true ? "file" : "elem");
+			writer.Key("ph");
+			writer.String("X");
+			writer.Key("ts");
+			writer.Int64(event.start);
+			writer.Key("dur");
+			writer.Int64(event.duration);
+			writer.Key("pid");
+			writer.Int(1);
+			writer.Key("tid");
+			writer.Int(1);
+			writer.Key("args");
+			writer.StartObject();
+			if (event.id.empty() == false)
+			{
+				writer.Key("id");
+				writer.String(event.id);
+			}
+			writer.Key("bytesRead");
+			writer.Uint64(event.bytesRead);
+			writer.Key("allocations");
+			writer.Uint64(event.allocations);
+			writer.EndObject();
+			writer.EndObject();
+		}
+		writer.EndArray();
+		writer.EndObject();
+
+		try
+		{
+			std::ofstream file(std::filesystem::u8path(traceFile), std::ios::out | std::ios::binary);
+			file.write(buffer.GetString(), buffer.GetSize());
+		}
+		catch (std::exception&) {}
+	}
+
+	static void printSummary()
+	{
+		struct Total
+		{
+			std::string name;
+			uint64_t count{ 0 };
+			int64_t duration{ 0 };
+			int64_t selfDuration{ 0 };
+			uint64_t bytesRead{ 0 };
+			uint64_t allocations{ 0 };
+		};
+
+		std::unordered_map<std::string, Total> totals;
+		for (const auto& event : events)
+		{
+			auto name = (event.isFile == true ? "file " : "") + getEventName(event);
+			auto& total = totals[name];
+			if (total.count == 0)
+			{
+				total.name = name;
+			}
+			total.count++;
+			total.duration += event.duration;
+			total.selfDuration += event.duration - event.childDuration;
+			total.bytesRead += event.bytesRead;
+			total.allocations += event.allocations;
+		}
+
+		std::vector<Total> sortedTotals;
+		for (auto& total : totals)
+		{
+			sortedTotals.push_back(std::move(total.second));
+		}
+		std::sort(sortedTotals.begin(), sortedTotals.end(),
+			[](const Total& a, const Total& b) { return a.selfDuration > b.selfDuration; });
+
+		std::printf("%-40s %8s %12s %12s %12s %12s\n",
+			"load profile", "count", "self (ms)", "total (ms)", "bytes", "allocs");
+		for (const auto& total : sortedTotals)
+		{
+			std::printf("%-40s %8llu %12.3f %12.3f %12llu %12llu\n",
+				total.name.c_str(),
+				(unsigned long long)total.count,
+				(double)total.selfDuration / 1000.0,
+				(double)total.duration / 1000.0,
+				(unsigned long long)total.bytesRead,
+				(unsigned long long)total.allocations);
+		}
+
+		// slowest resources
+		std::vector<const Event*> slowest;
+		for (const auto& event : events)
+		{
+			if (event.isFile == false && event.id.empty() == false)
+			{
+				slowest.push_back(&event);
+			}
+		}
+		auto numSlowest = std::min(slowest.size(), (size_t)20);
+		std::partial_sort(slowest.begin(), slowest.begin() + numSlowest, slowest.end(),
+			[](const Event* a, const Event* b) { return a->duration > b->duration; });
+
+		std::printf("\n%-40s %-30s %12s\n", "slowest resources", "id", "total (ms)");
+		for (size_t i = 0; i < numSlowest; i++)
+		{
+			std::printf("%-40s %-30s %12.3f\n",
+				getEventName(*slowest[i]).c_str(),
+				slowest[i]->id.c_str(),
+				(double)slowest[i]->duration / 1000.0);
+		}
+	}
+
+	void dump()
+	{
+		if (Impl::enabled == false)
+		{
+			return;
+		}
+		writeTrace();
+		printSummary();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Json/JsonParser.h"
+#include <string_view>
+
+// records the time, bytes read and allocations of each parsed file and
+// json element (by element type and resource id). allocations are only
+// counted in builds with USE_ALLOCATION_COUNTER.
+// enabled with the --profile-load[:traceFile] command line option.
+// when disabled, each scope costs a single branch.
+namespace LoadProfiler
+{
+	namespace Impl
+	{
+		inline bool enabled{ false };
+		inline std::atomic<uint64_t> bytesRead{ 0 };
+
+		size_t beginFile(const std::string_view fileName);
+		size_t beginElem(uint16_t nameHash16, const rapidjson::Value& elem);
+		void end(size_t eventIdx);
+	}
+
+	inline bool Enabled() noexcept { return Impl::enabled; }
+
+	// traceFile is a filesystem path (not in PhysFS's write dir).
+	void enable(const std::string_view traceFile);
+
+	inline void addBytesRead(uint64_t bytes) noexcept
+	{
+		if (Impl::enabled == true)
+		{
+			Impl::bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+		}
+	}
+
+	// names for the str2int16 hashes of the element types.
+	void setElemName(uint16_t nameHash16, const std::string_view name);
+
+	// writes the Chrome trace file and prints a sorted summary.
+	void dump();
+
+	class Scope
+	{
+	private:
+		size_t eventIdx{ (size_t)-1 };
+
+	public:
+		Scope(const std::string_view fileName)
+		{
+			if (Impl::enabled == true)
+			{
+				eventIdx = Impl::beginFile(fileName);
+			}
+		}
+		// arrays aren't recorded, only their elements.
+		Scope(uint16_t nameHash16, const rapidjson::Value& elem)
+		{
+			if (Impl::enabled == true && elem.IsArray() == false)
+			{
+				eventIdx = Impl::beginElem(nameHash16, elem);
+			}
+		}
+		~Scope()
+		{
+			if (eventIdx != (size_t)-1)
+			{
+				Impl::end(eventIdx);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+}
@@ -1,12 +1,20 @@
 #include <iostream>
+#include "BenchRunner.h"
 #include "CmdLineUtils.h"
 #include "FileUtils.h"
+#include "FrameProfiler.h"
 #include "Game.h"
+#include "InputRecorder.h"
+#include "LoadProfiler.h"
 
 int main(int argc, char* argv[])
 {
 	FileUtils::initPhysFS(argv[0]);
+#ifndef __ANDROID__
+	argc = CmdLineUtils::processOptions(argc, argv);
+#endif
 
+	int exitCode = 0;
 	try
 	{
 		Game game;
@@ -15,7 +23,14 @@ int main(int argc, char* argv[])
 		game.load("/sdcard/gamefiles.zip", "main.json");
 		game.play();
 #else
-		if (CmdLineUtils::processCmdLine(argc, (const char **)argv) == false)
+		if (argc == 4 && std::string_view(argv[1]) == "--bench")
+		{
+			if (BenchRunner::run(game, argv[2], argv[3]) == false)
+			{
+				exitCode = 1;
+			}
+		}
+		else if (CmdLineUtils::processCmdLine(argc, (const char **)argv, exitCode) == false)
 		{
 			if (argc == 2)
 			{
@@ -38,6 +53,9 @@ int main(int argc, char* argv[])
 		std::cerr << ex.what();
 	}
 
+	InputRecorder::stop();
+	LoadProfiler::dump();
+	FrameProfiler::dump();
 	FileUtils::deinitPhysFS();
-	return 0;
+	return exitCode;
 }
@@ -1,4 +1,5 @@
 #include "Movie2.h"
+#include "FileUtils.h"
 #include "Game.h"
 #include "GameUtils.h"
 #include "Utils/Utils.h"
@@ -10,6 +11,7 @@ bool Movie::load()
 	{
 		return false;
 	}
+	file->setBuffer(FileUtils::StreamBufferSize());
 	bool ret = movie.openFromStream(*file);
 	if (ret == true)
 	{
@@ -83,7 +85,11 @@ void Movie::update(Game& game)
 #ifndef USE_SFML_MOVIE_STUB
 	movie.update();
 
-	if (movie.getStatus() == sfe::Status::Stopped)
+	if (movie.getStatus() == sfe::Status::Playing)
+	{
+		game.invalidate();
+	}
+	else if (movie.getStatus() == sfe::Status::Stopped)
 	{
 		game.Events().addBack(actionComplete);
 	}
@@ -146,6 +146,8 @@ namespace Parser
 		{
 			itemClass->OutlineIgnore(getColorVal(elem["outlineIgnore"], sf::Color::Transparent));
 		}
+		itemClass->setUpdateClass(
+			getUpdateClassKey(elem, "updateClass", itemClass->getUpdateClass()));
 
 		if (elem.HasMember("defaults") == true)
 		{
@@ -174,8 +174,20 @@ namespace Parser
 		auto& elemData = getQueryKey(queryDoc, elem, "data");
 
 		if (dun.Width() == 0 ||
-			dun.Height() == 0 ||
-			elemData.IsArray() == false ||
+			dun.Height() == 0)
+		{
+			return dun;
+		}
+		if (JsonUtils::isPackedInt16Array(elemData) == true)
+		{
+			auto dataSize = JsonUtils::getPackedInt16ArraySize(elemData);
+			for (size_t i = 0; i < dataSize; i++)
+			{
+				dun.set(i, JsonUtils::getPackedInt16(elemData, i) + indexOffset);
+			}
+			return dun;
+		}
+		if (elemData.IsArray() == false ||
 			elemData.Size() == 0)
 		{
 			return dun;
@@ -259,7 +271,7 @@ namespace Parser
 
 		if (Utils::endsWith(Utils::toLower(file), ".json") == true)
 		{
-			if (JsonUtils::loadFile(file, mapDoc) == true)
+			if (JsonUtils::loadFilePacked(file, mapDoc) == true)
 			{
 				queryDoc = &mapDoc;
 				hasJsonFile = true;
@@ -329,7 +341,7 @@ namespace Parser
 		else if (mapElem.IsString() == true)
 		{
 			Document doc;
-			if (JsonUtils::loadFile(getStringViewVal(mapElem), doc) == true)
+			if (JsonUtils::loadFilePacked(getStringViewVal(mapElem), doc) == true)
 			{
 				parseMap(queryDoc, doc, map, currentMapPos,
 					defaultTile, false, recursionLevel + 1);
@@ -487,7 +499,7 @@ namespace Parser
 		const Value* queryObj = nullptr;
 		if (isValidString(elem, "load") == true)
 		{
-			if (JsonUtils::loadFile(getStringViewVal(elem["load"]), queryDoc) == true)
+			if (JsonUtils::loadFilePacked(getStringViewVal(elem["load"]), queryDoc) == true)
 			{
 				queryObj = &queryDoc;
 			}
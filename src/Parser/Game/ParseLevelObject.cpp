@@ -33,7 +33,7 @@ namespace Parser
 		}
 		auto& mapCell = level->Map()[mapPos];
 
-		if (mapCell.getObject<SimpleLevelObject>() != nullptr)
+		if (mapCell.hasObject<SimpleLevelObject>() == true)
 		{
 			return;
 		}
@@ -121,6 +121,8 @@ namespace Parser
 		{
 			levelObjClass->setCellSize(getVector2iVal<PairInt8>(elem["size"]));
 		}
+		levelObjClass->setUpdateClass(
+			getUpdateClassKey(elem, "updateClass", levelObjClass->getUpdateClass()));
 		if (elem.HasMember("nameClassifier") == true)
 		{
 			levelObjClass->setNameClassifier(
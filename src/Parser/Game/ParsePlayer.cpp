@@ -171,7 +171,7 @@ namespace Parser
 		}
 		auto& mapCell = level->Map()[mapPos];
 
-		if (mapCell.getObject<Player>() != nullptr)
+		if (mapCell.hasObject<Player>() == true)
 		{
 			return;
 		}
@@ -188,6 +188,8 @@ namespace Parser
 		{
 			playerClass->Type(getStringVal(elem["type"]));
 		}
+		playerClass->setUpdateClass(
+			getUpdateClassKey(elem, "updateClass", playerClass->getUpdateClass()));
 
 		if (elem.HasMember("nameClassifier") == true)
 		{
@@ -661,6 +661,10 @@ namespace Parser
 		{
 			return std::make_shared<ActGameDraw>();
 		}
+		case str2int16("game.dumpFrameProfile"):
+		{
+			return std::make_shared<ActGameDumpFrameProfile>(getStringKey(elem, "file"));
+		}
 		case str2int16("game.enableInput"):
 		{
 			return std::make_shared<ActGameEnableInput>(getBoolKey(elem, "enable", true));
@@ -886,6 +890,66 @@ namespace Parser
 				getItemLocationVal(elem),
 				str2int16(getStringViewKey(elem, "action")));
 		}
+		case str2int16("item.generate"):
+		{
+			auto action = std::make_shared<ActItemGenerate>(
+				getStringKey(elem, "level"),
+				getItemCoordInventoryVal(elem),
+				getInventoryPositionKey(elem, "position"));
+
+			auto count = getUIntKey(elem, "count", 1);
+			if (isValidString(elem, "class") == true)
+			{
+				action->addItemClass(elem["class"].GetStringStr(), count);
+			}
+			if (isValidArray(elem, "classes") == true)
+			{
+				for (const auto& val : elem["classes"])
+				{
+					if (val.IsString() == true)
+					{
+						action->addItemClass(val.GetStringStr(), count);
+					}
+					else if (isValidString(val, "class") == true)
+					{
+						action->addItemClass(val["class"].GetStringStr(),
+							getUIntKey(val, "count", count));
+					}
+				}
+			}
+			if (elem.HasMember("properties") == true &&
+				elem["properties"].IsObject() == true)
+			{
+				const auto& props = elem["properties"];
+				for (auto it = props.MemberBegin(); it != props.MemberEnd(); ++it)
+				{
+					if (it->name.GetStringLength() == 0)
+					{
+						continue;
+					}
+					// [min, max] or a fixed value
+					auto name = getStringViewVal(it->name);
+					if (it->value.IsArray() == true &&
+						it->value.Size() == 2)
+					{
+						action->setProperty(name,
+							getMinMaxIntVal<LevelObjValue>(it->value[0]),
+							getMinMaxIntVal<LevelObjValue>(it->value[1]));
+					}
+					else
+					{
+						auto val = getMinMaxIntVal<LevelObjValue>(it->value);
+						action->setProperty(name, val, val);
+					}
+				}
+			}
+			action->setPlacedVariable(getStringKey(elem, "placedVariable"));
+			if (elem.HasMember("onInventoryFull") == true)
+			{
+				action->setInventoryFullAction(parseAction(game, elem["onInventoryFull"]));
+			}
+			return action;
+		}
 		case str2int16("item.loadFromLevel"):
 		{
 			auto action = std::make_shared<ActItemLoadFromLevel>(
@@ -1050,7 +1114,12 @@ namespace Parser
 				getStringKey(elem, "file"),
 				getBoolKey(elem, "saveDefaults"),
 				getBoolKey(elem, "saveCurrentPlayer"),
-				getBoolKey(elem, "saveQuests"));
+				getBoolKey(elem, "saveQuests"),
+				getBoolKey(elem, "binary"),
+				getBoolKey(elem, "compress", true),
+				getBoolKey(elem, "async"),
+				getActionKey(game, elem, "onComplete"),
+				getActionKey(game, elem, "onError"));
 		}
 		case str2int16("level.setAutomap"):
 		{
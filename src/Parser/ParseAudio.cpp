@@ -1,4 +1,5 @@
 #include "ParseAudio.h"
+#include "FileUtils.h"
 #include "Game.h"
 #include "ParseAudioCommon.h"
 #include "SFML/MusicLoops.h"
@@ -50,6 +51,7 @@ namespace Parser
 			{
 				return nullptr;
 			}
+			stream->setBuffer(FileUtils::StreamBufferSize());
 
 			auto music = std::make_shared<sf::Music2>();
 			auto resource = getStringViewKey(elem, "resource");
@@ -65,6 +67,7 @@ namespace Parser
 		{
 			return nullptr;
 		}
+		sndFile->file.setBuffer(FileUtils::StreamBufferSize());
 
 		auto music = std::make_shared<sf::MusicLoops>();
 		auto music2 = std::dynamic_pointer_cast<sf::Music2>(music);
@@ -4,6 +4,7 @@
 #include "FileUtils.h"
 #include "GameUtils.h"
 #include "Json/JsonUtils.h"
+#include "LoadProfiler.h"
 #include "ParseAction.h"
 #include "ParseAnimation.h"
 #include "ParseAudio.h"
@@ -62,6 +63,7 @@ namespace Parser
 			return;
 		}
 
+		LoadProfiler::Scope profile(fileName);
 		parseJson(game, FileUtils::readText(fileName.data()));
 	}
 
@@ -78,6 +80,7 @@ namespace Parser
 			return;
 		}
 
+		LoadProfiler::Scope profile(fileName);
 		auto json = FileUtils::readText(fileName.c_str());
 		for (size_t i = 1; i < params.size(); i++)
 		{
@@ -106,6 +109,7 @@ namespace Parser
 			return;
 		}
 
+		LoadProfiler::Scope profile(fileName);
 		auto json = FileUtils::readText(fileName.c_str());
 		for (size_t i = 1; i < params.Size(); i++)
 		{
@@ -131,7 +135,8 @@ namespace Parser
 	{
 		Document doc;  // Default template parameter uses UTF8 and MemoryPoolAllocator.
 
-		if (JsonUtils::loadJson(json, doc) == false)
+		// map layers and saves are streamed without building DOM arrays.
+		if (JsonUtils::loadJsonPacked(json, doc) == false)
 		{
 			return;
 		}
@@ -145,14 +150,21 @@ namespace Parser
 		MemoryPoolAllocator<CrtAllocator> allocator;
 		for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it)
 		{
-			parseDocumentElemHelper(game, str2int16(getStringViewVal(it->name)),
-				it->value, replaceVars, allocator);
+			auto name = getStringViewVal(it->name);
+			auto nameHash16 = str2int16(name);
+			if (LoadProfiler::Enabled() == true)
+			{
+				LoadProfiler::setElemName(nameHash16, name);
+			}
+			parseDocumentElemHelper(game, nameHash16, it->value, replaceVars, allocator);
 		}
 	}
 
 	void parseDocumentElemHelper(Game& game, uint16_t nameHash16, const Value& elem,
 		ReplaceVars& replaceVars, MemoryPoolAllocator<CrtAllocator>& allocator)
 	{
+		LoadProfiler::Scope profile(nameHash16, elem);
+
 		auto replaceVarsInElem = replaceVars;
 		bool changeValueType = replaceVars == ReplaceVars::Value;
 		if (elem.IsObject() == true)
@@ -223,6 +235,10 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("caseInsensitivePaths"): {
+			FileUtils::CaseInsensitivePaths(getBoolVal(elem));
+			break;
+		}
 		case str2int16("circle"): {
 			if (elem.IsArray() == false) {
 				parseCircle(game, elem);
@@ -530,6 +546,10 @@ namespace Parser
 			game.RefSize(getVector2uVal<sf::Vector2u>(elem, refSize));
 			break;
 		}
+		case str2int16("renderThread"): {
+			game.UseRenderThread(getBoolVal(elem));
+			break;
+		}
 		case str2int16("replaceVars"): {
 			replaceVars = getReplaceVarsVal(elem);
 			break;
@@ -538,7 +558,7 @@ namespace Parser
 			auto saveDir = getStringVal(elem);
 			if (saveDir.size() > 0 && FileUtils::setSaveDir(saveDir.c_str()) == true)
 			{
-				PHYSFS_mount(PHYSFS_getWriteDir(), nullptr, 0);
+				FileUtils::mount(PHYSFS_getWriteDir(), "", false);
 			}
 			break;
 		}
@@ -553,6 +573,14 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("simulationRate"): {
+			game.SimulationRate(getUIntVal(elem));
+			break;
+		}
+		case str2int16("skipIdleFrames"): {
+			game.SkipIdleFrames(getBoolVal(elem));
+			break;
+		}
 		case str2int16("smoothScreen"): {
 			game.SmoothScreen(getBoolVal(elem));
 			break;
@@ -583,6 +611,10 @@ namespace Parser
 			game.StretchToFit(getBoolVal(elem));
 			break;
 		}
+		case str2int16("streamBufferSize"): {
+			FileUtils::StreamBufferSize(getUIntVal(elem));
+			break;
+		}
 		case str2int16("text"): {
 			if (elem.IsArray() == false) {
 				parseText(game, elem);
@@ -640,6 +672,10 @@ namespace Parser
 			game.WindowSize(getVector2uVal<sf::Vector2u>(elem, minSize));
 			break;
 		}
+		case str2int16("workerThreads"): {
+			game.Jobs().WorkerCount(getUIntVal(elem, JobSystem::defaultWorkerCount()));
+			break;
+		}
 		}
 	}
 }
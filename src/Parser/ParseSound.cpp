@@ -1,4 +1,5 @@
 #include "ParseSound.h"
+#include "FileUtils.h"
 #include "Game.h"
 #include "ParseAudioCommon.h"
 #include "PhysFSStream.h"
@@ -16,6 +17,7 @@ namespace Parser
 		{
 			return nullptr;
 		}
+		stream.setBuffer(FileUtils::StreamBufferSize());
 
 		auto sndBuffer = std::make_shared<sf::SoundBuffer>();
 
@@ -38,6 +40,7 @@ namespace Parser
 		{
 			return nullptr;
 		}
+		stream.setBuffer(FileUtils::StreamBufferSize());
 
 		auto sndBuffer = std::make_shared<SoundBufferLoops>();
 
@@ -179,6 +182,7 @@ namespace Parser
 			{
 				continue;
 			}
+			file.setBuffer(FileUtils::StreamBufferSize());
 			if (isValidId(id) == false)
 			{
 				getIdFromFile(fileName, id);
@@ -77,17 +77,21 @@ namespace Parser
 
 		bool useIndexedImages = pal != nullptr && game.Shaders().hasSpriteShader();
 		auto normalizeDirections = getBoolKey(elem, "normalizeDirections");
+		// per pixel hover for level objects using this texture pack
+		auto alphaMasks = getBoolKey(elem, "alphaMask");
 
 		if (imgVec.size() == 1)
 		{
 			return std::make_unique<CachedTexturePack>(
-				imgVec.front(), offset, pal, useIndexedImages, normalizeDirections
+				imgVec.front(), offset, pal, useIndexedImages,
+				normalizeDirections, alphaMasks
 			);
 		}
 		else
 		{
 			return std::make_unique<CachedMultiTexturePack>(
-				imgVec, offset, pal, useIndexedImages, normalizeDirections
+				imgVec, offset, pal, useIndexedImages,
+				normalizeDirections, alphaMasks
 			);
 		}
 	}
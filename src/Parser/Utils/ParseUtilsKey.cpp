@@ -400,6 +400,19 @@ namespace Parser
 		return val;
 	}
 
+	UpdateClass getUpdateClassKey(const Value& elem, const std::string_view key, UpdateClass val)
+	{
+		if (elem.HasMember(key) == true)
+		{
+			const auto& keyElem = elem[key];
+			if (keyElem.IsString() == true)
+			{
+				return GameUtils::getUpdateClass(keyElem.GetStringView(), val);
+			}
+		}
+		return val;
+	}
+
 	Variable getVariableKey(const Value& elem, const std::string_view key)
 	{
 		if (elem.HasMember(key) == true)
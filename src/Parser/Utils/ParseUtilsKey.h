@@ -3,6 +3,7 @@
 #include "Anchor.h"
 #include "AnimationType.h"
 #include "Game/GameProperties.h"
+#include "Game/LevelObjectClass.h"
 #include "Json/JsonParser.h"
 #include "Parser/ParserProperties.h"
 #include "ParseUtilsVal.h"
@@ -224,6 +225,9 @@ namespace Parser
 	ReplaceVars getReplaceVarsKey(const rapidjson::Value& elem,
 		const std::string_view key, ReplaceVars val = ReplaceVars::None);
 
+	UpdateClass getUpdateClassKey(const rapidjson::Value& elem,
+		const std::string_view key, UpdateClass val);
+
 	Variable getVariableKey(const rapidjson::Value& elem, const std::string_view key);
 
 	VarOrPredicate getVarOrPredicateKey(Game& game,
@@ -0,0 +1,77 @@
+#include "PerfCounters.h"
+#include <algorithm>
+#include "Utils/AllocationCounter.h"
+#include <vector>
+
+namespace PerfCounters
+{
+	static std::array<uint64_t, (size_t)Counter::Count> lastFrame{};
+	static std::array<int64_t, FrameHistorySize> frameTimes{};
+	static size_t frameTimeIdx{ 0 };
+	static size_t numFrameTimes{ 0 };
+	static bool countAllocations{ false };
+	static uint64_t frameStartAllocations{ 0 };
+	static uint64_t lastFrameAllocations{ 0 };
+
+	void endFrame(int64_t frameTime)
+	{
+		for (size_t i = 0; i < lastFrame.size(); i++)
+		{
+			lastFrame[i] = Impl::counters[i].exchange(0, std::memory_order_relaxed);
+		}
+
+		frameTimes[frameTimeIdx] = frameTime;
+		frameTimeIdx = (frameTimeIdx + 1) % frameTimes.size();
+		numFrameTimes = std::min(numFrameTimes + 1, frameTimes.size());
+
+		if (countAllocations == true)
+		{
+			auto allocations = AllocationCounter::get();
+			lastFrameAllocations = allocations - frameStartAllocations;
+			frameStartAllocations = allocations;
+		}
+	}
+
+	uint64_t get(Counter counter) noexcept
+	{
+		return lastFrame[(size_t)counter];
+	}
+
+	uint64_t getAllocations() noexcept
+	{
+		if (countAllocations == false)
+		{
+			countAllocations = true;
+			AllocationCounter::Enabled(true);
+			frameStartAllocations = AllocationCounter::get();
+		}
+		return lastFrameAllocations;
+	}
+
+	double getFPS() noexcept
+	{
+		int64_t totalTime = 0;
+		for (size_t i = 0; i < numFrameTimes; i++)
+		{
+			totalTime += frameTimes[i];
+		}
+		if (totalTime <= 0)
+		{
+			return 0.0;
+		}
+		return (double)numFrameTimes * 1000000.0 / (double)totalTime;
+	}
+
+	double getFrameTime(double percentile)
+	{
+		if (numFrameTimes == 0)
+		{
+			return 0.0;
+		}
+		std::vector<int64_t> sorted(frameTimes.begin(), frameTimes.begin() + numFrameTimes);
+		std::sort(sorted.begin(), sorted.end());
+		percentile = std::clamp(percentile, 0.0, 100.0);
+		auto idx = (size_t)(percentile / 100.0 * (double)(sorted.size() - 1) + 0.5);
+		return (double)sorted[idx] / 1000.0;
+	}
+}
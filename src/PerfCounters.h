@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// per frame performance counters, readable with the game.perf.* properties.
+// counters are added to during a frame and stored by endFrame.
+// can be added to from any thread (the render thread draws too).
+namespace PerfCounters
+{
+	enum class Counter : size_t
+	{
+		DrawCalls,
+		TextureBinds,
+		UniformUpdates,
+		PathSearches,
+		// level objects updated (see Level::updateLevelObjects)
+		LevelObjectUpdates,
+		Count
+	};
+
+	namespace Impl
+	{
+		inline std::array<std::atomic<uint64_t>, (size_t)Counter::Count> counters{};
+		// last texture drawn by this thread
+		inline thread_local const void* lastTexture{ nullptr };
+	}
+
+	inline void add(Counter counter, uint64_t value = 1) noexcept
+	{
+		Impl::counters[(size_t)counter].fetch_add(value, std::memory_order_relaxed);
+	}
+
+	// counts a draw call and a texture bind if the texture changed.
+	inline void addDraw(const void* texture) noexcept
+	{
+		add(Counter::DrawCalls);
+		if (texture != Impl::lastTexture)
+		{
+			Impl::lastTexture = texture;
+			add(Counter::TextureBinds);
+		}
+	}
+
+	// number of frames used for the fps and the frame time percentiles.
+	constexpr size_t FrameHistorySize = 120;
+
+	// stores the counters of the frame that ended and resets them.
+	// frameTime is in microseconds.
+	void endFrame(int64_t frameTime);
+
+	// value of the last finished frame.
+	uint64_t get(Counter counter) noexcept;
+
+	// allocations of the last finished frame. allocations are counted
+	// after the first call (counting has a cost), so it starts with 0.
+	// always 0 without USE_ALLOCATION_COUNTER (see AllocationCounter).
+	uint64_t getAllocations() noexcept;
+
+	double getFPS() noexcept;
+
+	// frame time percentile (0-100) of the last frames in milliseconds.
+	double getFrameTime(double percentile);
+}
@@ -20,10 +20,12 @@
 //distribution.
 
 #include "PhysFSStream.h"
+#include "FileUtils.h"
+#include "LoadProfiler.h"
 
 sf::PhysFSStream::PhysFSStream(const char* fileName)
 {
-	file = PHYSFS_openRead(fileName);
+	file = FileUtils::openRead(fileName);
 }
 
 sf::PhysFSStream::~PhysFSStream()
@@ -38,14 +40,28 @@ bool sf::PhysFSStream::load(const char* fileName)
 {
 	if (file == nullptr)
 	{
-		file = PHYSFS_openRead(fileName);
+		file = FileUtils::openRead(fileName);
 	}
 	return (file != nullptr);
 }
 
+bool sf::PhysFSStream::setBuffer(size_t bufferSize) noexcept
+{
+	if (file == nullptr)
+	{
+		return false;
+	}
+	return PHYSFS_setBuffer(file, (PHYSFS_uint64)bufferSize) != 0;
+}
+
 sf::Int64 sf::PhysFSStream::read(void* data, sf::Int64 size) noexcept
 {
-	return PHYSFS_readBytes(file, data, (PHYSFS_uint64)size);
+	auto bytesRead = PHYSFS_readBytes(file, data, (PHYSFS_uint64)size);
+	if (bytesRead > 0)
+	{
+		LoadProfiler::addBytesRead((uint64_t)bytesRead);
+	}
+	return bytesRead;
 }
 
 sf::Int64 sf::PhysFSStream::seek(sf::Int64 position) noexcept
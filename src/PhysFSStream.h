@@ -40,6 +40,10 @@ namespace sf
 		bool load(const std::string& fileName) { return load(fileName.c_str()); }
 		bool load(const char* fileName);
 
+		// enables PhysFS read-ahead buffering. use for sequential readers
+		// (music, movies) that issue many small reads.
+		bool setBuffer(size_t bufferSize) noexcept;
+
 		virtual sf::Int64 read(void* data, sf::Int64 size) noexcept;
 		virtual sf::Int64 seek(sf::Int64 position) noexcept;
 		virtual sf::Int64 tell() noexcept;
@@ -37,6 +37,15 @@ public:
 
 	virtual bool getProperty(const std::string_view prop, Variable& var) const = 0;
 
+	// same as getProperty, with the part of prop before the first '.' already hashed
+	// (str2int16) and props set to the part after it. for callers that query the
+	// same property many times (classifiers).
+	virtual bool getPropertyByHash(const std::string_view prop, uint16_t propHash,
+		const std::string_view props, Variable& var) const
+	{
+		return getProperty(prop, var);
+	}
+
 	virtual const Queryable* getQueryable(const std::string_view prop) const { return nullptr; }
 
 	virtual bool getTexture(uint32_t textureNumber, TextureInfo& ti) const { return false; }
@@ -0,0 +1,80 @@
+#include "RenderThread.h"
+#include <SFML/OpenGL.hpp>
+#include <SFML/Window/Context.hpp>
+
+void RenderThread::threadLoop()
+{
+	// the context shares textures and shaders with the main thread's contexts
+	sf::Context context;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		jobAdded.wait(lock, [this]() { return jobs.empty() == false || stopping == true; });
+		if (jobs.empty() == true)
+		{
+			break;
+		}
+		auto& job = jobs.front();
+		lock.unlock();
+
+		job.commands.submit(*job.target);
+		job.target->display();
+		// the main thread draws the texture using its own context
+		glFinish();
+		job.target->setActive(false);
+		job.commands.clear();
+
+		lock.lock();
+		freeLists.push_back(std::move(job.commands));
+		finishedTicket = job.ticket;
+		jobs.pop_front();
+		jobFinished.notify_all();
+	}
+}
+
+uint64_t RenderThread::submit(DrawCommandList& commands, sf::RenderTexture& target)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (running == false)
+	{
+		stopping = false;
+		running = true;
+		thread = std::thread(&RenderThread::threadLoop, this);
+	}
+	Job job;
+	std::swap(job.commands, commands);
+	if (freeLists.empty() == false)
+	{
+		std::swap(commands, freeLists.back());
+		freeLists.pop_back();
+	}
+	job.target = &target;
+	job.ticket = ++lastTicket;
+	jobs.push_back(std::move(job));
+	jobAdded.notify_one();
+	return lastTicket;
+}
+
+void RenderThread::wait(uint64_t ticket)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	jobFinished.wait(lock, [this, ticket]() { return finishedTicket >= ticket; });
+}
+
+void RenderThread::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (running == false)
+		{
+			return;
+		}
+		stopping = true;
+		jobAdded.notify_one();
+	}
+	thread.join();
+	std::lock_guard<std::mutex> lock(mutex);
+	running = false;
+	freeLists.clear();
+}
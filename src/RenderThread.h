@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include "SFML/DrawCommandList.h"
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <thread>
+#include <vector>
+
+// draws recorded command lists into render textures on a separate thread,
+// so the main thread can record and draw the rest of the frame meanwhile.
+// the thread starts on the first submit.
+class RenderThread
+{
+private:
+	struct Job
+	{
+		DrawCommandList commands;
+		sf::RenderTexture* target{ nullptr };
+		uint64_t ticket{ 0 };
+	};
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable jobAdded;
+	std::condition_variable jobFinished;
+	std::deque<Job> jobs;
+	// lists of finished jobs, reused to avoid reallocations
+	std::vector<DrawCommandList> freeLists;
+	uint64_t lastTicket{ 0 };
+	uint64_t finishedTicket{ 0 };
+	bool running{ false };
+	bool stopping{ false };
+
+	void threadLoop();
+
+public:
+	RenderThread() = default;
+	~RenderThread() { stop(); }
+
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	// queues commands to be drawn into target (and displayed) and returns
+	// a ticket for wait. commands is swapped with an empty list.
+	// target must not be used by the caller until the job finishes.
+	uint64_t submit(DrawCommandList& commands, sf::RenderTexture& target);
+
+	// waits until the job with the given ticket (and all before it) finishes.
+	void wait(uint64_t ticket);
+
+	// waits for all jobs.
+	void wait() { wait(lastTicket); }
+
+	// waits for all jobs and stops the thread.
+	void stop();
+};
@@ -100,6 +100,32 @@ bool ResourceManager::resourceExists(const std::string_view id) const noexcept
 	return false;
 }
 
+uint64_t ResourceManager::getTextureMemory(const std::string_view id) const
+{
+	uint64_t memory = 0;
+	for (const auto& res : resources)
+	{
+		if (id.empty() == false && res.id != id)
+		{
+			continue;
+		}
+		for (const auto& resource : res.resources)
+		{
+			if (std::holds_alternative<std::shared_ptr<sf::Texture>>(resource.second) == false)
+			{
+				continue;
+			}
+			const auto& texture = std::get<std::shared_ptr<sf::Texture>>(resource.second);
+			if (texture != nullptr)
+			{
+				auto size = texture->getSize();
+				memory += (uint64_t)size.x * (uint64_t)size.y * 4;
+			}
+		}
+	}
+	return memory;
+}
+
 void ResourceManager::bringResourceToFront(const std::string& id)
 {
 	auto it = std::find_if(resources.begin(), resources.end(),
@@ -212,6 +212,10 @@ public:
 	void ignoreResources(const std::string& id, IgnoreResource ignore) noexcept;
 	void ignoreTopResource(IgnoreResource ignore);
 	bool resourceExists(const std::string_view id) const noexcept;
+
+	// estimated texture memory (4 bytes per pixel) of the resource with the
+	// given id or of all resources if id is empty.
+	uint64_t getTextureMemory(const std::string_view id) const;
 	void bringResourceToFront(const std::string& id);
 
 	Image* getCursor() const;
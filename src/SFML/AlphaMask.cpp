@@ -0,0 +1,21 @@
+#include "AlphaMask.h"
+
+AlphaMask::AlphaMask(const sf::Image& img) : width(img.getSize().x), height(img.getSize().y)
+{
+	auto numPixels = (size_t)width * height;
+	if (numPixels == 0)
+	{
+		width = height = 0;
+		return;
+	}
+	bits.resize((numPixels + 63) / 64);
+	auto pixels = img.getPixelsPtr();
+	for (size_t i = 0; i < numPixels; i++)
+	{
+		// RGBA, alpha is the 4th byte
+		if (pixels[i * 4 + 3] != 0)
+		{
+			bits[i / 64] |= ((uint64_t)1 << (i % 64));
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/Graphics/Image.hpp>
+#include <vector>
+
+// one bit per pixel of an image, set if the pixel isn't fully transparent.
+// texture packs that upload images can keep one per texture, so sprites
+// can be hit tested per pixel without reading textures back.
+class AlphaMask
+{
+private:
+	std::vector<uint64_t> bits;
+	unsigned width{ 0 };
+	unsigned height{ 0 };
+
+public:
+	AlphaMask() = default;
+	AlphaMask(const sf::Image& img);
+
+	bool empty() const noexcept { return bits.empty(); }
+	unsigned Width() const noexcept { return width; }
+	unsigned Height() const noexcept { return height; }
+
+	// false if x or y are outside the mask.
+	bool isOpaque(int32_t x, int32_t y) const noexcept
+	{
+		if (x < 0 || y < 0 || (unsigned)x >= width || (unsigned)y >= height)
+		{
+			return false;
+		}
+		auto idx = (size_t)y * width + (size_t)x;
+		return (bits[idx / 64] & ((uint64_t)1 << (idx % 64))) != 0;
+	}
+};
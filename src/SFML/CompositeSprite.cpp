@@ -26,6 +26,26 @@ void CompositeSprite::setOffset(const sf::Vector2f& offset_)
 	}
 }
 
+bool CompositeSprite::contains(const sf::Vector2f& point) const
+{
+	if (sprite.contains(point) == true)
+	{
+		return true;
+	}
+	if (sprite.getGlobalBounds().contains(point) == false)
+	{
+		return false;
+	}
+	for (const auto& s : extraSprites)
+	{
+		if (s.contains(point) == true)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void CompositeSprite::setColor(const sf::Color& color)
 {
 	sprite.setColor(color);
@@ -67,7 +87,7 @@ void CompositeSprite::setTexture(const TextureInfo& ti)
 	extraSprites.clear();
 }
 
-void CompositeSprite::setTexture(const std::vector<TextureInfo>& ti)
+void CompositeSprite::setTexture(const FrameVector<TextureInfo>& ti)
 {
 	if (ti.empty() == false)
 	{
@@ -95,12 +115,11 @@ void CompositeSprite::draw(sf::RenderTarget& target, sf::Shader* spriteShader) c
 	}
 }
 
-void CompositeSprite::draw(sf::RenderTarget& target, sf::Shader* spriteShader,
-	SpriteShaderCache& cache, uint8_t light) const
+void CompositeSprite::record(DrawCommandList& commands, sf::Shader* spriteShader, uint8_t light) const
 {
-	sprite.draw(target, spriteShader, cache, light);
+	sprite.record(commands, spriteShader, light);
 	for (const auto& s : extraSprites)
 	{
-		s.draw(target, spriteShader, cache, light);
+		s.record(commands, spriteShader, light);
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Sprite2.h"
+#include "Utils/FrameArena.h"
 #include <vector>
 
 class CompositeSprite
@@ -31,6 +32,10 @@ public:
 	sf::FloatRect getLocalBounds() const { return sprite.getLocalBounds(); }
 	sf::FloatRect getGlobalBounds() const { return sprite.getGlobalBounds(); }
 
+	// true if point is inside the global bounds (first layer) and over
+	// a pixel of any layer (see Sprite2::contains).
+	bool contains(const sf::Vector2f& point) const;
+
 	const sf::IntRect& getTextureRect() const { return sprite.getTextureRect(); }
 	void setTextureRect(const sf::IntRect& rect) { sprite.setTextureRect(rect); }
 
@@ -53,10 +58,9 @@ public:
 	const sf::Texture* getTexture() const { return sprite.getTexture(); }
 	void setTexture(const sf::Texture& texture, bool resetRect = false);
 	void setTexture(const TextureInfo& ti);
-	void setTexture(const std::vector<TextureInfo>& ti);
+	void setTexture(const FrameVector<TextureInfo>& ti);
 
 	void draw(sf::RenderTarget& target, sf::Shader* spriteShader) const;
 
-	void draw(sf::RenderTarget& target, sf::Shader* spriteShader,
-		SpriteShaderCache& cache, uint8_t light) const;
+	void record(DrawCommandList& commands, sf::Shader* spriteShader, uint8_t light) const;
 };
@@ -0,0 +1,165 @@
+#include "DrawCommandList.h"
+#include <cmath>
+#include "PerfCounters.h"
+#include <SFML/Graphics/Shader.hpp>
+
+void DrawCommandList::clear() noexcept
+{
+	commands.clear();
+	vertices.clear();
+	views.clear();
+	uniforms.clear();
+}
+
+void DrawCommandList::addClear(const sf::Color& color)
+{
+	Command cmd;
+	cmd.type = CommandType::Clear;
+	cmd.clearColor = color;
+	commands.push_back(cmd);
+}
+
+void DrawCommandList::addView(const sf::View& view)
+{
+	Command cmd;
+	cmd.type = CommandType::SetView;
+	cmd.viewIdx = views.size();
+	views.push_back(view);
+	commands.push_back(cmd);
+}
+
+void DrawCommandList::addQuad(const sf::Vertex (&quad)[4], const sf::Texture* texture,
+	const sf::BlendMode& blendMode, sf::Shader* shader,
+	const SpriteShaderUniforms* shaderUniforms)
+{
+	bool newBatch = true;
+	if (commands.empty() == false)
+	{
+		const auto& last = commands.back();
+		if (last.type == CommandType::Draw &&
+			last.texture == texture &&
+			last.blendMode == blendMode &&
+			last.shader == shader)
+		{
+			newBatch = (shader != nullptr &&
+				(shaderUniforms == nullptr || uniforms[last.uniformsIdx] != *shaderUniforms));
+		}
+	}
+	if (newBatch == true)
+	{
+		Command cmd;
+		cmd.texture = texture;
+		cmd.blendMode = blendMode;
+		cmd.shader = shader;
+		if (shader != nullptr)
+		{
+			cmd.uniformsIdx = uniforms.size();
+			uniforms.push_back(shaderUniforms != nullptr ? *shaderUniforms : SpriteShaderUniforms());
+		}
+		cmd.vertexStart = vertices.size();
+		commands.push_back(cmd);
+	}
+
+	// two triangles
+	vertices.push_back(quad[0]);
+	vertices.push_back(quad[1]);
+	vertices.push_back(quad[2]);
+	vertices.push_back(quad[2]);
+	vertices.push_back(quad[1]);
+	vertices.push_back(quad[3]);
+	commands.back().vertexCount += 6;
+}
+
+void DrawCommandList::addSprite(const sf::Sprite& sprite, const sf::BlendMode& blendMode,
+	sf::Shader* shader, const SpriteShaderUniforms* shaderUniforms)
+{
+	const auto& rect = sprite.getTextureRect();
+	auto width = (float)std::abs(rect.width);
+	auto height = (float)std::abs(rect.height);
+	auto left = (float)rect.left;
+	auto right = left + (float)rect.width;
+	auto top = (float)rect.top;
+	auto bottom = top + (float)rect.height;
+
+	const auto& transform = sprite.getTransform();
+	auto color = sprite.getColor();
+
+	// same vertex order as sf::Sprite (triangle strip)
+	sf::Vertex quad[4] = {
+		sf::Vertex(transform.transformPoint(0.f, 0.f), color, { left, top }),
+		sf::Vertex(transform.transformPoint(0.f, height), color, { left, bottom }),
+		sf::Vertex(transform.transformPoint(width, 0.f), color, { right, top }),
+		sf::Vertex(transform.transformPoint(width, height), color, { right, bottom })
+	};
+	addQuad(quad, sprite.getTexture(), blendMode, shader, shaderUniforms);
+}
+
+void DrawCommandList::addRectangle(const sf::FloatRect& rect, const sf::Color& color)
+{
+	auto right = rect.left + rect.width;
+	auto bottom = rect.top + rect.height;
+	sf::Vertex quad[4] = {
+		sf::Vertex({ rect.left, rect.top }, color),
+		sf::Vertex({ rect.left, bottom }, color),
+		sf::Vertex({ right, rect.top }, color),
+		sf::Vertex({ right, bottom }, color)
+	};
+	addQuad(quad, nullptr, sf::BlendAlpha, nullptr, nullptr);
+}
+
+static void setShaderUniforms(sf::Shader& shader, const SpriteShaderUniforms& shaderUniforms)
+{
+	PerfCounters::add(PerfCounters::Counter::UniformUpdates,
+		shaderUniforms.palette != nullptr ? 6 : 5);
+	shader.setUniform("pixelSize", shaderUniforms.pixelSize);
+	shader.setUniform("outline", sf::Glsl::Vec4(shaderUniforms.outline));
+	shader.setUniform("ignore", sf::Glsl::Vec4(shaderUniforms.ignore));
+	auto light = shaderUniforms.light;
+	sf::Color lightColor(0xFF - light, 0xFF - light, 0xFF - light, 0);
+	shader.setUniform("light", sf::Glsl::Vec4(lightColor));
+	shader.setUniform("hasPalette", shaderUniforms.palette != nullptr);
+	if (shaderUniforms.palette != nullptr)
+	{
+		shader.setUniform("palette", *shaderUniforms.palette);
+	}
+}
+
+void DrawCommandList::submit(sf::RenderTarget& target) const
+{
+	sf::Shader* lastShader = nullptr;
+	const SpriteShaderUniforms* lastUniforms = nullptr;
+
+	for (const auto& cmd : commands)
+	{
+		switch (cmd.type)
+		{
+		case CommandType::Clear:
+			target.clear(cmd.clearColor);
+			break;
+		case CommandType::SetView:
+			target.setView(views[cmd.viewIdx]);
+			break;
+		case CommandType::Draw:
+		{
+			sf::RenderStates states(cmd.blendMode);
+			states.texture = cmd.texture;
+			if (cmd.shader != nullptr)
+			{
+				states.shader = cmd.shader;
+				const auto& shaderUniforms = uniforms[cmd.uniformsIdx];
+				if (cmd.shader != lastShader ||
+					lastUniforms == nullptr ||
+					*lastUniforms != shaderUniforms)
+				{
+					setShaderUniforms(*cmd.shader, shaderUniforms);
+					lastShader = cmd.shader;
+					lastUniforms = &shaderUniforms;
+				}
+			}
+			target.draw(&vertices[cmd.vertexStart], cmd.vertexCount, sf::Triangles, states);
+			PerfCounters::addDraw(cmd.texture);
+			break;
+		}
+		}
+	}
+}
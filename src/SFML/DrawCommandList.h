@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Glsl.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <vector>
+
+// uniforms of the sprite shader (see Sprite2::draw).
+struct SpriteShaderUniforms
+{
+	sf::Glsl::Vec2 pixelSize;
+	sf::Color outline{ sf::Color::Transparent };
+	sf::Color ignore{ sf::Color::Transparent };
+	uint8_t light{ 255 };
+	const sf::Texture* palette{ nullptr };
+
+	bool operator==(const SpriteShaderUniforms& other) const noexcept
+	{
+		return pixelSize.x == other.pixelSize.x &&
+			pixelSize.y == other.pixelSize.y &&
+			outline == other.outline &&
+			ignore == other.ignore &&
+			light == other.light &&
+			palette == other.palette;
+	}
+	bool operator!=(const SpriteShaderUniforms& other) const noexcept { return !(*this == other); }
+};
+
+// recorded draw commands for one render target.
+// sprites are stored as quads and consecutive quads with the same texture,
+// blend mode, shader and uniforms are drawn with a single draw call.
+// commands hold copies of everything except textures and shaders, so a list
+// can be recorded while the previous one is drawn by another thread.
+// shader uniforms are stored in the commands and set when the list is submitted,
+// so shaders used here can't also be used to draw directly (see GameShaders).
+class DrawCommandList
+{
+private:
+	enum class CommandType : uint8_t
+	{
+		Clear,
+		SetView,
+		Draw
+	};
+
+	struct Command
+	{
+		CommandType type{ CommandType::Draw };
+		sf::Color clearColor;
+		size_t viewIdx{ 0 };
+		const sf::Texture* texture{ nullptr };
+		sf::BlendMode blendMode;
+		sf::Shader* shader{ nullptr };
+		size_t uniformsIdx{ 0 };
+		size_t vertexStart{ 0 };
+		size_t vertexCount{ 0 };
+	};
+
+	std::vector<Command> commands;
+	std::vector<sf::Vertex> vertices;
+	std::vector<sf::View> views;
+	std::vector<SpriteShaderUniforms> uniforms;
+
+	void addQuad(const sf::Vertex (&quad)[4], const sf::Texture* texture,
+		const sf::BlendMode& blendMode, sf::Shader* shader,
+		const SpriteShaderUniforms* shaderUniforms);
+
+public:
+	bool empty() const noexcept { return commands.empty(); }
+	size_t size() const noexcept { return commands.size(); }
+
+	// removes all commands and keeps the allocated memory.
+	void clear() noexcept;
+
+	void addClear(const sf::Color& color);
+	void addView(const sf::View& view);
+
+	// shader and shaderUniforms are optional.
+	void addSprite(const sf::Sprite& sprite, const sf::BlendMode& blendMode,
+		sf::Shader* shader = nullptr, const SpriteShaderUniforms* shaderUniforms = nullptr);
+
+	void addRectangle(const sf::FloatRect& rect, const sf::Color& color);
+
+	// draws the commands to target. the calling thread needs an active
+	// OpenGL context (the main thread or the render thread).
+	void submit(sf::RenderTarget& target) const;
+};
@@ -1,7 +1,15 @@
 #include "Sprite2.h"
+#include "PerfCounters.h"
 #include "SFMLUtils.h"
 #include "ShaderManager.h"
 
+template <class T>
+static void setUniform(sf::Shader& shader, const char* name, const T& value)
+{
+	shader.setUniform(name, value);
+	PerfCounters::add(PerfCounters::Counter::UniformUpdates);
+}
+
 void Sprite2::setPosition(const sf::Vector2f& position_)
 {
 	position = position_;
@@ -44,6 +52,7 @@ void Sprite2::setTexture(const sf::Texture& texture, bool resetRect)
 {
 	sf::Sprite::setTexture(texture, resetRect);
 	blendMode = BlendMode::Alpha;
+	alphaMask = nullptr;
 }
 
 void Sprite2::setTexture(const TextureInfo& ti, bool resetRect)
@@ -61,9 +70,28 @@ void Sprite2::setTexture(const TextureInfo& ti, bool resetRect)
 		setTextureRect(oldRect);
 	}
 	blendMode = ti.blendMode;
+	alphaMask = ti.alphaMask;
 	setPalette(ti.palette);
 }
 
+bool Sprite2::contains(const sf::Vector2f& point) const
+{
+	auto bounds = getGlobalBounds();
+	if (bounds.contains(point) == false)
+	{
+		return false;
+	}
+	if (alphaMask == nullptr)
+	{
+		return true;
+	}
+	// the mask covers the whole texture. scaled/flipped sprites map back to the rect
+	const auto& rect = getTextureRect();
+	auto x = rect.left + (int32_t)((point.x - bounds.left) * (float)rect.width / bounds.width);
+	auto y = rect.top + (int32_t)((point.y - bounds.top) * (float)rect.height / bounds.height);
+	return alphaMask->isOpaque(x, y);
+}
+
 bool Sprite2::needsSpriteShader(uint8_t light) const noexcept
 {
 	if (hasPalette() == false &&
@@ -84,29 +112,30 @@ void Sprite2::draw(sf::RenderTarget& target, sf::Shader* spriteShader, uint8_t l
 	{
 		states.shader = spriteShader;
 
-		spriteShader->setUniform("pixelSize", sf::Glsl::Vec2(
+		setUniform(*spriteShader, "pixelSize", sf::Glsl::Vec2(
 			1.0f / (float)getTextureRect().width,
 			1.0f / (float)getTextureRect().height
 		));
 		if (outlineEnabled == true)
 		{
-			spriteShader->setUniform("outline", sf::Glsl::Vec4(outline));
-			spriteShader->setUniform("ignore", sf::Glsl::Vec4(ignore));
+			setUniform(*spriteShader, "outline", sf::Glsl::Vec4(outline));
+			setUniform(*spriteShader, "ignore", sf::Glsl::Vec4(ignore));
 		}
 		else
 		{
-			spriteShader->setUniform("outline", sf::Glsl::Vec4(sf::Color::Transparent));
-			spriteShader->setUniform("ignore", sf::Glsl::Vec4(sf::Color::Transparent));
+			setUniform(*spriteShader, "outline", sf::Glsl::Vec4(sf::Color::Transparent));
+			setUniform(*spriteShader, "ignore", sf::Glsl::Vec4(sf::Color::Transparent));
 		}
 		sf::Color lightColor(0xFF - light, 0xFF - light, 0xFF - light, 0);
-		spriteShader->setUniform("light", sf::Glsl::Vec4(lightColor));
-		spriteShader->setUniform("hasPalette", hasPalette());
+		setUniform(*spriteShader, "light", sf::Glsl::Vec4(lightColor));
+		setUniform(*spriteShader, "hasPalette", hasPalette());
 		if (hasPalette() == true)
 		{
-			spriteShader->setUniform("palette", palette->texture);
+			setUniform(*spriteShader, "palette", palette->texture);
 		}
 	}
 	target.draw(static_cast<sf::Sprite>(*this), states);
+	PerfCounters::addDraw(getTexture());
 }
 
 void Sprite2::draw(sf::RenderTarget& target, sf::Shader* spriteShader,
@@ -132,7 +161,7 @@ void Sprite2::draw(sf::RenderTarget& target, sf::Shader* spriteShader,
 		{
 			cache.textureSize.x = getTextureRect().width;
 			cache.textureSize.y = getTextureRect().height;
-			spriteShader->setUniform("pixelSize", sf::Glsl::Vec2(
+			setUniform(*spriteShader, "pixelSize", sf::Glsl::Vec2(
 				1.0f / (float)getTextureRect().width,
 				1.0f / (float)getTextureRect().height
 			));
@@ -150,14 +179,14 @@ void Sprite2::draw(sf::RenderTarget& target, sf::Shader* spriteShader,
 			outline2 != cache.outline)
 		{
 			cache.outline = outline2;
-			spriteShader->setUniform("outline", sf::Glsl::Vec4(outline2));
+			setUniform(*spriteShader, "outline", sf::Glsl::Vec4(outline2));
 		}
 
 		if (updateAll == true ||
 			ignore2 != cache.outline)
 		{
 			cache.ignore = ignore2;
-			spriteShader->setUniform("ignore", sf::Glsl::Vec4(ignore2));
+			setUniform(*spriteShader, "ignore", sf::Glsl::Vec4(ignore2));
 		}
 
 		if (updateAll == true ||
@@ -165,19 +194,49 @@ void Sprite2::draw(sf::RenderTarget& target, sf::Shader* spriteShader,
 		{
 			cache.light = light;
 			sf::Color lightColor(0xFF - light, 0xFF - light, 0xFF - light, 0);
-			spriteShader->setUniform("light", sf::Glsl::Vec4(lightColor));
+			setUniform(*spriteShader, "light", sf::Glsl::Vec4(lightColor));
 		}
 
 		if (updateAll == true ||
 			palette.get() != cache.palette)
 		{
 			cache.palette = palette.get();
-			spriteShader->setUniform("hasPalette", hasPalette());
+			setUniform(*spriteShader, "hasPalette", hasPalette());
 			if (hasPalette() == true)
 			{
-				spriteShader->setUniform("palette", palette->texture);
+				setUniform(*spriteShader, "palette", palette->texture);
 			}
 		}
 	}
 	target.draw(static_cast<sf::Sprite>(*this), states);
+	PerfCounters::addDraw(getTexture());
+}
+
+void Sprite2::record(DrawCommandList& commands, sf::Shader* spriteShader, uint8_t light) const
+{
+	auto blend = SFMLUtils::getBlendMode(blendMode);
+
+	if (spriteShader == nullptr ||
+		needsSpriteShader(light) == false)
+	{
+		commands.addSprite(*this, blend);
+		return;
+	}
+
+	SpriteShaderUniforms uniforms;
+	uniforms.pixelSize = sf::Glsl::Vec2(
+		1.0f / (float)getTextureRect().width,
+		1.0f / (float)getTextureRect().height
+	);
+	if (outlineEnabled == true)
+	{
+		uniforms.outline = outline;
+		uniforms.ignore = ignore;
+	}
+	uniforms.light = light;
+	if (hasPalette() == true)
+	{
+		uniforms.palette = &palette->texture;
+	}
+	commands.addSprite(*this, blend, spriteShader, &uniforms);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "AlphaMask.h"
+#include "DrawCommandList.h"
 #include <memory>
 #include "Palette.h"
 #include <SFML/Graphics/RenderTarget.hpp>
@@ -28,6 +30,7 @@ private:
 	sf::Color ignore{ sf::Color::Transparent };
 	bool outlineEnabled{ false };
 	BlendMode blendMode{ BlendMode::Alpha };
+	const AlphaMask* alphaMask{ nullptr };
 
 	// returns false if shader can be skipped (no palette used, no outline, max light)
 	bool needsSpriteShader(uint8_t light) const noexcept;
@@ -62,6 +65,10 @@ public:
 	void setTexture(const sf::Texture& texture, bool resetRect = false);
 	void setTexture(const TextureInfo& ti, bool resetRect);
 
+	// true if point is inside the global bounds and, if the texture
+	// has an alpha mask, over a pixel that isn't transparent.
+	bool contains(const sf::Vector2f& point) const;
+
 	using sf::Sprite::getLocalBounds;
 	using sf::Sprite::getGlobalBounds;
 	using sf::Sprite::getTexture;
@@ -74,4 +81,7 @@ public:
 
 	void draw(sf::RenderTarget& target, sf::Shader* spriteShader,
 		SpriteShaderCache& cache, uint8_t light = 255) const;
+
+	// adds the sprite to a command list instead of drawing it.
+	void record(DrawCommandList& commands, sf::Shader* spriteShader, uint8_t light = 255) const;
 };
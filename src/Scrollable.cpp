@@ -82,6 +82,7 @@ void Scrollable::update(Game& game)
 				game.Events().addBack(completeAction);
 			}
 			view.setCenter(rect);
+			game.invalidate();
 		}
 	});
 }
@@ -135,10 +135,12 @@ void ShaderManager::init()
 {
 	add("game", gameText);
 	add("sprite", spriteText);
+	add("commandListSprite", spriteText);
 }
 
 void ShaderManager::init(GameShaders& gameShaders) const
 {
 	gameShaders.Game = get("game");
 	gameShaders.Sprite = get("sprite");
+	gameShaders.CommandListSprite = get("commandListSprite");
 }
@@ -9,6 +9,10 @@ struct GameShaders
 {
 	sf::Shader* Game{ nullptr };
 	sf::Shader* Sprite{ nullptr };
+	// a second sprite shader (same source) for recorded draw commands.
+	// command lists set its uniforms on the thread that submits them
+	// (the render thread), so it must not be used to draw directly.
+	sf::Shader* CommandListSprite{ nullptr };
 
 	bool hasGameShader() const noexcept { return Game != nullptr; }
 	bool hasSpriteShader() const noexcept { return Sprite != nullptr; }
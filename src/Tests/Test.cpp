@@ -0,0 +1,55 @@
+#include "Test.h"
+#include <cstdio>
+#include <exception>
+#include <mutex>
+
+namespace Test
+{
+	// CHECK can fail on any thread (inside jobs).
+	static std::mutex failMutex;
+	static size_t failures{ 0 };
+
+	void fail(const char* expr, const char* file, int line)
+	{
+		std::lock_guard<std::mutex> lock(failMutex);
+		std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+		failures++;
+	}
+
+	static size_t getFailures()
+	{
+		std::lock_guard<std::mutex> lock(failMutex);
+		return failures;
+	}
+
+	size_t run(const std::string_view filter)
+	{
+		size_t numFailed = 0;
+		auto numRun = Tests::forEach(filter, [&numFailed](const Tests::Entry& test)
+		{
+			auto failuresBefore = getFailures();
+			try
+			{
+				test.func();
+			}
+			catch (std::exception& ex)
+			{
+				std::fprintf(stderr, "%s: exception: %s\n", test.name.c_str(), ex.what());
+				fail("no exception", __FILE__, __LINE__);
+			}
+			catch (...)
+			{
+				std::fprintf(stderr, "%s: unknown exception\n", test.name.c_str());
+				fail("no exception", __FILE__, __LINE__);
+			}
+			bool passed = getFailures() == failuresBefore;
+			if (passed == false)
+			{
+				numFailed++;
+			}
+			std::printf("%s %s\n", (passed == true ? "[ OK ]" : "[FAIL]"), test.name.c_str());
+		});
+		std::printf("%zu tests, %zu failed\n", numRun, numFailed);
+		return numFailed;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include "Utils/Registry.h"
+
+// small harness for the DGEngineTests unit tests (run by ctest).
+//
+// TEST(formulaEval)
+// {
+//   CHECK(Formula("2 + 2").eval() == 4);
+// }
+//
+// a failed CHECK is reported and the test keeps running.
+// a test that throws fails.
+namespace Test
+{
+	typedef std::function<void()> Function;
+	typedef Registry<Function> Tests;
+
+	void fail(const char* expr, const char* file, int line);
+
+	// runs the tests whose name contains filter. returns the number of failed tests.
+	size_t run(const std::string_view filter);
+}
+
+#define TEST(name) REGISTER_FUNCTION(Test::Tests, name, ())
+
+#define CHECK(expr) \
+	do { if (!(expr)) { Test::fail(#expr, __FILE__, __LINE__); } } while (false)
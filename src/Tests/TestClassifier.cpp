@@ -0,0 +1,208 @@
+#include "Test.h"
+#include "Game/Classifier.h"
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+class TestObject : public Queryable
+{
+public:
+	std::vector<std::pair<std::string, Variable>> properties;
+
+	bool getProperty(const std::string_view prop, Variable& var) const override
+	{
+		for (const auto& property : properties)
+		{
+			if (property.first == prop)
+			{
+				var = property.second;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+// the lookup before classifiers were compiled: the first value of each
+// interval that matches, skipping skipFirst matches (one per interval).
+// the linear scan threw bad_variant_access when comparing a non-text value
+// with a text, the compiled lookup doesn't match, so that's what's expected.
+static Variable linearScan(const std::vector<ClassifierValueInterval>& intervals,
+	const Queryable& obj, uint16_t skipFirst)
+{
+	for (const auto& interval : intervals)
+	{
+		Variable value;
+		if (interval.property.empty() == false &&
+			obj.getProperty(interval.property, value) == false)
+		{
+			continue;
+		}
+		for (const auto& classVal : interval.values)
+		{
+			bool matches = false;
+			if (std::holds_alternative<ClassifierValue::ValuePair>(classVal.compare) == true)
+			{
+				const auto& minMax = std::get<ClassifierValue::ValuePair>(classVal.compare);
+				// text (and double) values compare as 0
+				LevelObjValue intVal = 0;
+				if (std::holds_alternative<int64_t>(value) == true)
+				{
+					intVal = (LevelObjValue)std::get<int64_t>(value);
+				}
+				else if (std::holds_alternative<bool>(value) == true)
+				{
+					intVal = (LevelObjValue)std::get<bool>(value);
+				}
+				matches = intVal >= minMax.first && intVal <= minMax.second;
+			}
+			else
+			{
+				matches = std::holds_alternative<std::string>(value) == true &&
+					std::get<std::string>(value) == std::get<std::string>(classVal.compare);
+			}
+			if (matches == true)
+			{
+				if (skipFirst > 0)
+				{
+					skipFirst--;
+					break;
+				}
+				return classVal.value;
+			}
+		}
+	}
+	return {};
+}
+
+static const std::vector<std::string> Properties{ "a", "b", "c.d" };
+static const std::vector<std::string> Texts{ "", "x", "y", "zz" };
+
+static Variable getRandomValue(std::mt19937& rng, int64_t maxInt)
+{
+	switch (rng() % 8)
+	{
+	case 0:
+		return Variable(Texts[rng() % Texts.size()]);
+	case 1:
+		return Variable(rng() % 2 == 0);
+	case 2:
+		return Variable(0.5);
+	case 3:
+		// doesn't fit in a LevelObjValue
+		return Variable((int64_t)(rng() % 4) << 32);
+	default:
+		return Variable((int64_t)(rng() % (2 * maxInt + 1)) - maxInt);
+	}
+}
+
+static ClassifierValueInterval getRandomInterval(std::mt19937& rng,
+	int64_t maxInt, uint32_t maxValues)
+{
+	ClassifierValueInterval interval;
+	auto propIdx = rng() % (Properties.size() + 1);
+	if (propIdx < Properties.size())
+	{
+		interval.property = Properties[propIdx];
+	}
+	auto numValues = 1 + rng() % maxValues;
+	for (uint32_t i = 0; i < numValues; i++)
+	{
+		ClassifierValue classVal;
+		switch (rng() % 6)
+		{
+		case 0:
+			// duplicate texts
+			classVal.compare = Texts[rng() % Texts.size()];
+			break;
+		case 1:
+			// the whole range
+			classVal.compare = std::make_pair(std::numeric_limits<LevelObjValue>::min(),
+				std::numeric_limits<LevelObjValue>::max());
+			break;
+		default:
+		{
+			// overlapping ranges (some empty, with min > max)
+			auto min = (LevelObjValue)((int64_t)(rng() % (2 * maxInt + 1)) - maxInt);
+			auto max = (LevelObjValue)(min + (int64_t)(rng() % (maxInt / 2 + 1)) - maxInt / 16);
+			classVal.compare = std::make_pair(min, max);
+			break;
+		}
+		}
+		classVal.value = Variable((int64_t)i);
+		interval.values.push_back(std::move(classVal));
+	}
+	return interval;
+}
+
+TEST(classifierMatchesLinearScan)
+{
+	std::mt19937 rng(1);
+	size_t numLookups = 0;
+	size_t numMatches = 0;
+	size_t numFailed = 0;
+	for (int n = 0; n < 400; n++)
+	{
+		// small domains are indexed directly, big ones use binary search
+		int64_t maxInt = (n % 2 == 0 ? 40 : 100000);
+		uint32_t maxValues = (n % 4 < 2 ? 12 : 128);
+
+		std::vector<ClassifierValueInterval> intervals;
+		auto numIntervals = 1 + rng() % 3;
+		for (uint32_t i = 0; i < numIntervals; i++)
+		{
+			intervals.push_back(getRandomInterval(rng, maxInt, maxValues));
+		}
+		Classifier classifier(intervals);
+
+		std::vector<TestObject> objs(250);
+		std::vector<const Queryable*> objPtrs;
+		for (auto& obj : objs)
+		{
+			for (const auto& prop : Properties)
+			{
+				if (rng() % 8 != 0)
+				{
+					// values next to the range limits are the ones that break
+					auto value = getRandomValue(rng, maxInt);
+					if (std::holds_alternative<int64_t>(value) == true && rng() % 2 == 0)
+					{
+						const auto& interval = intervals[rng() % intervals.size()];
+						const auto& compare = interval.values[rng() % interval.values.size()].compare;
+						if (std::holds_alternative<ClassifierValue::ValuePair>(compare) == true)
+						{
+							const auto& minMax = std::get<ClassifierValue::ValuePair>(compare);
+							value = (int64_t)(rng() % 2 == 0 ? minMax.first : minMax.second) +
+								(int64_t)(rng() % 3) - 1;
+						}
+					}
+					obj.properties.push_back(std::make_pair(prop, value));
+				}
+			}
+			objPtrs.push_back(&obj);
+		}
+
+		for (uint16_t skipFirst = 0; skipFirst < 4; skipFirst++)
+		{
+			std::vector<Variable> vars;
+			classifier.get(objPtrs, vars, skipFirst);
+			for (size_t i = 0; i < objs.size(); i++)
+			{
+				auto expected = linearScan(intervals, objs[i], skipFirst);
+				if (classifier.get(objs[i], skipFirst) != expected ||
+					vars[i] != expected)
+				{
+					numFailed++;
+				}
+				numMatches += expected != Variable() ? 1 : 0;
+				numLookups++;
+			}
+		}
+	}
+	CHECK(numFailed == 0);
+	CHECK(numLookups == 400000);
+	// both outcomes are checked
+	CHECK(numMatches > numLookups / 4);
+	CHECK(numMatches < numLookups * 3 / 4);
+}
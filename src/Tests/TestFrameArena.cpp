@@ -0,0 +1,45 @@
+#include "Test.h"
+#include <thread>
+#include "Utils/FrameArena.h"
+
+TEST(frameArenaReset)
+{
+	FrameArena::reset();
+	auto frame = FrameArena::getFrame();
+	CHECK(FrameArena::isOwnerThread() == true);
+	CHECK(FrameArena::getUsed() == 0);
+	{
+		FrameVector<int> values;
+		for (int i = 0; i < 100000; i++)
+		{
+			values.push_back(i);
+		}
+		CHECK(values[99999] == 99999);
+		CHECK(FrameArena::getUsed() >= 100000 * sizeof(int));
+	}
+	FrameArena::reset();
+	CHECK(FrameArena::getFrame() == frame + 1);
+	CHECK(FrameArena::getUsed() == 0);
+
+	// the blocks of the last frame are merged, so the same
+	// allocations fit in one block now
+	FrameVector<int> values;
+	values.reserve(100000);
+	CHECK(FrameArena::getUsed() == 100000 * sizeof(int));
+}
+
+TEST(frameArenaOtherThreads)
+{
+	FrameArena::reset();
+	auto used = FrameArena::getUsed();
+	bool isOwner = true;
+	std::thread thread([&isOwner]()
+	{
+		isOwner = FrameArena::isOwnerThread();
+		FrameString str(1000, 'a');
+		str += "b";
+	});
+	thread.join();
+	CHECK(isOwner == false);
+	CHECK(FrameArena::getUsed() == used);
+}
@@ -0,0 +1,329 @@
+#include "Test.h"
+#include <algorithm>
+#include "Game/GameHashes.h"
+#include "Game/Inventory.h"
+#include "Game/Item.h"
+#include "Game/ItemClass.h"
+#include <memory>
+#include <random>
+#include "TexturePacks/SimpleTexturePack.h"
+#include <vector>
+
+// item classes with an empty texture (creating one needs an OpenGL context).
+struct TestItemClasses
+{
+	std::shared_ptr<TexturePack> texturePack{ std::make_shared<SimpleTexturePack>(
+		std::make_shared<sf::Texture>(), std::make_pair(1u, 1u), sf::Vector2f(),
+		0, 0, false, AnimationType::PlayOnce, nullptr) };
+	std::vector<std::unique_ptr<ItemClass>> classes;
+
+	ItemClass* add(const std::string& id, LevelObjValue capacity = 0,
+		const PairUInt8& inventorySize = PairUInt8(1, 1))
+	{
+		classes.push_back(std::make_unique<ItemClass>(texturePack, texturePack, 0));
+		classes.back()->Id(id);
+		classes.back()->InventorySize(inventorySize);
+		if (capacity > 0)
+		{
+			classes.back()->setDefaultByHash(ItemProp::Capacity, capacity);
+		}
+		return classes.back().get();
+	}
+};
+
+// the sum of the quantities of the class' items, slot by slot.
+// returns false if no item of the class has a quantity.
+static bool sumQuantities(const Inventory& inventory, const ItemClass& itemClass,
+	uint32_t& quantity)
+{
+	bool isQuantifiable = false;
+	int64_t sum = 0;
+	for (const auto& item : inventory)
+	{
+		LevelObjValue itemQuantity;
+		if (item.Class() == &itemClass &&
+			item.getIntByHash(ItemProp::Quantity, itemQuantity) == true)
+		{
+			sum += itemQuantity;
+			isQuantifiable = true;
+		}
+	}
+	quantity = (uint32_t)std::max(sum, (int64_t)0);
+	return isQuantifiable;
+}
+
+static bool checkQuantities(const Inventory& inventory, const TestItemClasses& itemClasses)
+{
+	for (const auto& itemClass : itemClasses.classes)
+	{
+		uint32_t quantity;
+		uint32_t expected;
+		auto isQuantifiable = inventory.getQuantity(itemClass->IdHash16(), quantity);
+		if (isQuantifiable != sumQuantities(inventory, *itemClass, expected) ||
+			quantity != expected)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST(inventoryQuantities)
+{
+	TestItemClasses itemClasses;
+	itemClasses.add("sword");
+	itemClasses.add("gold", 5000);
+	itemClasses.add("arrows", 100);
+	// an item class with capacity where some items have no quantity
+	itemClasses.add("potion", 3);
+
+	std::mt19937 rng(1);
+	auto random = [&rng](int max) { return (int)(rng() % (uint32_t)max); };
+
+	for (bool enforceItemSize : { false, true })
+	{
+		Inventory inventory(PairUInt8(10, 4));
+		inventory.setEnforceItemSize(enforceItemSize);
+
+		// items taken out of the inventory. changing them must not change the totals.
+		std::vector<std::shared_ptr<Item>> removed;
+
+		for (int i = 0; i < 20000; i++)
+		{
+			auto idx = (size_t)random((int)inventory.Size());
+			const auto& itemClass = *itemClasses.classes[random((int)itemClasses.classes.size())];
+			switch (random(8))
+			{
+			case 0:
+			case 1:
+			{
+				// set or replace a slot (same class items merge quantities)
+				auto item = std::make_shared<Item>(&itemClass);
+				if (itemClass.getDefaultByHash(ItemProp::Capacity) > 0 && random(4) != 0)
+				{
+					item->setIntByHash(ItemProp::Quantity,
+						1 + random(itemClass.getDefaultByHash(ItemProp::Capacity)));
+				}
+				std::shared_ptr<Item> oldItem;
+				inventory.set(idx, item, oldItem);
+				if (oldItem != nullptr)
+				{
+					removed.push_back(std::move(oldItem));
+				}
+				break;
+			}
+			case 2:
+			{
+				std::shared_ptr<Item> nullItem;
+				std::shared_ptr<Item> oldItem;
+				inventory.set(idx, nullItem, oldItem);
+				if (oldItem != nullptr)
+				{
+					removed.push_back(std::move(oldItem));
+				}
+				break;
+			}
+			case 3:
+			{
+				// adds or removes (removing empties and clears items)
+				auto amount = (LevelObjValue)(random(12000) - 6000);
+				inventory.addQuantity(itemClass, amount,
+					(InventoryPosition)random((int)InventoryPosition::Size), nullptr);
+				break;
+			}
+			case 4:
+			{
+				auto item = inventory.get(idx);
+				if (item != nullptr)
+				{
+					LevelObjValue amount = random(200) - 100;
+					item->addQuantity(amount);
+				}
+				break;
+			}
+			case 5:
+			{
+				// merges the quantity of one item into another
+				auto item = inventory.get(idx);
+				auto item2 = inventory.get((size_t)random((int)inventory.Size()));
+				LevelObjValue transferedQuantity;
+				if (item != item2)
+				{
+					Inventory::updateQuantities(item, item2, transferedQuantity, random(2) == 0);
+				}
+				break;
+			}
+			case 6:
+			{
+				if (removed.empty() == false)
+				{
+					auto& item = removed[random((int)removed.size())];
+					item->setIntByHash(ItemProp::Quantity, random(100));
+				}
+				break;
+			}
+			case 7:
+			{
+				if (random(50) == 0)
+				{
+					// same size (rebuilds the index) or smaller (drops items)
+					inventory.init(random(2) == 0 ? PairUInt8(10, 4) : PairUInt8(8, 3));
+					inventory.setEnforceItemSize(enforceItemSize);
+				}
+				else if (random(2) == 0)
+				{
+					auto item = inventory.get(idx);
+					if (item != nullptr)
+					{
+						item->setIntByHash(ItemProp::Quantity, random(6000));
+					}
+				}
+				break;
+			}
+			}
+			auto matches = checkQuantities(inventory, itemClasses);
+			CHECK(matches == true);
+			if (matches == false)
+			{
+				break;
+			}
+			if (removed.size() > 100)
+			{
+				removed.erase(removed.begin(), removed.begin() + 50);
+			}
+		}
+	}
+}
+
+// the first position where the item fits, checking each position in the
+// order of invPos (rows first).
+static bool findFreeSlot(const Inventory& inventory, PairUInt8 itemSize,
+	InventoryPosition invPos, size_t& itemIdx)
+{
+	const auto& size = inventory.getXYSize();
+	itemSize.x = std::max(itemSize.x, (uint8_t)1);
+	itemSize.y = std::max(itemSize.y, (uint8_t)1);
+	if (inventory.Size() == 0 ||
+		itemSize.x > size.x || itemSize.y > size.y)
+	{
+		return false;
+	}
+	size_t width = 1;
+	size_t height = 1;
+	if (inventory.getEnforceItemSize() == true)
+	{
+		width = itemSize.x;
+		height = itemSize.y;
+	}
+	size_t maxX = (size_t)(size.x - itemSize.x);
+	size_t maxY = (size_t)(size.y - itemSize.y);
+	bool fromTop = (invPos == InventoryPosition::TopLeft || invPos == InventoryPosition::TopRight);
+	bool fromLeft = (invPos == InventoryPosition::TopLeft || invPos == InventoryPosition::BottomLeft);
+	for (size_t n = 0; n <= maxY; n++)
+	{
+		auto y = (fromTop == true ? n : maxY - n);
+		for (size_t m = 0; m <= maxX; m++)
+		{
+			auto x = (fromLeft == true ? m : maxX - m);
+			bool isFree = true;
+			for (size_t j = y; j < y + height && isFree == true; j++)
+			{
+				for (size_t i = x; i < x + width && isFree == true; i++)
+				{
+					isFree = inventory.get(i, j) == nullptr;
+				}
+			}
+			if (isFree == true)
+			{
+				itemIdx = inventory.getIndex(x, y);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+TEST(inventoryGetFreeSlot)
+{
+	TestItemClasses itemClasses;
+	// items placed in the inventories
+	std::vector<ItemClass*> fillClasses;
+	for (uint8_t x = 1; x <= 3; x++)
+	{
+		for (uint8_t y = 1; y <= 3; y++)
+		{
+			fillClasses.push_back(itemClasses.add("item", 0, PairUInt8(x, y)));
+		}
+	}
+	fillClasses.push_back(itemClasses.add("wide", 0, PairUInt8(70, 1)));
+
+	// items to find a slot for. widths over 64 need free runs across words.
+	std::vector<ItemClass*> findClasses;
+	for (auto itemSize : { PairUInt8(1, 1), PairUInt8(2, 3), PairUInt8(0, 0),
+		PairUInt8(63, 1), PairUInt8(64, 1), PairUInt8(65, 2), PairUInt8(100, 1),
+		PairUInt8(128, 1), PairUInt8(130, 2), PairUInt8(255, 1), PairUInt8(255, 4) })
+	{
+		findClasses.push_back(itemClasses.add("find", 0, itemSize));
+	}
+
+	std::mt19937 rng(1);
+	auto random = [&rng](size_t max) { return (size_t)(rng() % (uint32_t)max); };
+
+	size_t numFound = 0;
+	size_t numChecks = 0;
+	size_t numFailed = 0;
+	for (auto size : { PairUInt8(1, 1), PairUInt8(10, 4), PairUInt8(64, 3), PairUInt8(65, 3),
+		PairUInt8(100, 4), PairUInt8(128, 2), PairUInt8(129, 3), PairUInt8(200, 5),
+		PairUInt8(255, 1), PairUInt8(255, 4) })
+	{
+		for (auto density : { 0, 1, 4, 16, 64 })
+		{
+			for (int n = 0; n < 4; n++)
+			{
+				Inventory inventory(size);
+				inventory.setEnforceItemSize(true);
+				auto numItems = inventory.Size() * density / 64;
+				for (size_t i = 0; i < numItems; i++)
+				{
+					auto itemClass = fillClasses[random(fillClasses.size() - (random(8) == 0 ? 0 : 1))];
+					auto item = std::make_shared<Item>(itemClass);
+					PairUInt8 position((uint8_t)random(size.x), (uint8_t)random(size.y));
+					inventory.set(position, item);
+					if (random(4) == 0)
+					{
+						std::shared_ptr<Item> nullItem;
+						position = PairUInt8((uint8_t)random(size.x), (uint8_t)random(size.y));
+						inventory.set(position, nullItem);
+					}
+				}
+				for (bool enforceItemSize : { true, false })
+				{
+					inventory.setEnforceItemSize(enforceItemSize);
+					for (auto itemClass : findClasses)
+					{
+						Item item(itemClass);
+						for (int invPos = 0; invPos < (int)InventoryPosition::Size; invPos++)
+						{
+							size_t itemIdx = inventory.Size();
+							size_t expectedIdx = inventory.Size();
+							auto found = inventory.getFreeSlot(item, itemIdx, (InventoryPosition)invPos);
+							auto expected = findFreeSlot(inventory, itemClass->InventorySize(),
+								(InventoryPosition)invPos, expectedIdx);
+							if (found != expected ||
+								(found == true && itemIdx != expectedIdx))
+							{
+								numFailed++;
+							}
+							numFound += found == true ? 1 : 0;
+							numChecks++;
+						}
+					}
+				}
+			}
+		}
+	}
+	CHECK(numFailed == 0);
+	// both outcomes are checked
+	CHECK(numFound > numChecks / 4);
+	CHECK(numFound < numChecks);
+}
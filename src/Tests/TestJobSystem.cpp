@@ -0,0 +1,206 @@
+#include <atomic>
+#include <chrono>
+#include "JobSystem.h"
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include "Test.h"
+#include <thread>
+#include <vector>
+
+// the tests run with no workers (jobs run on the main thread while it waits)
+// and with a few workers.
+static const unsigned workerCounts[] = { 0, 1, 4 };
+
+TEST(jobSystemRunAndWait)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		JobCounter counter;
+		std::atomic<int> count{ 0 };
+		for (int i = 0; i < 1000; i++)
+		{
+			jobs.run([&count]() { count++; }, &counter);
+		}
+		jobs.wait(counter);
+		CHECK(counter.done() == true);
+		CHECK(count == 1000);
+	}
+}
+
+TEST(jobSystemThenOrdering)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		std::mutex orderMutex;
+		std::vector<int> order;
+		auto add = [&order, &orderMutex](int value)
+		{
+			std::lock_guard<std::mutex> lock(orderMutex);
+			order.push_back(value);
+		};
+
+		JobCounter first;
+		JobCounter second;
+		JobCounter third;
+		for (int i = 0; i < 100; i++)
+		{
+			jobs.run([&add]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(10));
+				add(1);
+			}, &first);
+		}
+		jobs.then(first, [&add]() { add(2); }, &second);
+		jobs.then(second, [&add]() { add(3); }, &third);
+		jobs.wait(third);
+
+		CHECK(first.done() == true);
+		CHECK(second.done() == true);
+		CHECK(order.size() == 102);
+		if (order.size() == 102)
+		{
+			for (size_t i = 0; i < 100; i++)
+			{
+				CHECK(order[i] == 1);
+			}
+			CHECK(order[100] == 2);
+			CHECK(order[101] == 3);
+		}
+
+		// a dependency that's already done runs the job right away
+		JobCounter fourth;
+		jobs.then(first, [&add]() { add(4); }, &fourth);
+		jobs.wait(fourth);
+		CHECK(order.back() == 4);
+	}
+}
+
+TEST(jobSystemWorkStealing)
+{
+	JobSystem jobs;
+	jobs.WorkerCount(4);
+	JobCounter spawned;
+	JobCounter counter;
+	std::mutex threadsMutex;
+	std::set<std::thread::id> threads;
+	std::atomic<int> count{ 0 };
+
+	// the jobs go to the spawning worker's queue. the other threads
+	// only run them if they steal them.
+	jobs.run([&]()
+	{
+		for (int i = 0; i < 64; i++)
+		{
+			jobs.run([&]()
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				{
+					std::lock_guard<std::mutex> lock(threadsMutex);
+					threads.insert(std::this_thread::get_id());
+				}
+				count++;
+			}, &counter);
+		}
+	}, &spawned);
+	jobs.wait(spawned);
+	jobs.wait(counter);
+
+	CHECK(count == 64);
+	CHECK(threads.size() > 1);
+}
+
+TEST(jobSystemParallelFor)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		std::vector<std::atomic<int>> calls(1000);
+		jobs.parallel_for(0, calls.size(), 7, [&calls](size_t i) { calls[i]++; });
+		bool calledOnce = true;
+		for (const auto& call : calls)
+		{
+			calledOnce = calledOnce && call == 1;
+		}
+		CHECK(calledOnce == true);
+	}
+}
+
+TEST(jobSystemMainThreadJobs)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		JobCounter spawned;
+		JobCounter counter;
+		std::atomic<bool> onMainThread{ false };
+		jobs.run([&]()
+		{
+			jobs.runOnMainThread([&]()
+			{
+				onMainThread = jobs.isMainThread();
+			}, &counter);
+		}, &spawned);
+		jobs.wait(spawned);
+		jobs.wait(counter);
+		CHECK(onMainThread == true);
+
+		// jobs nobody waits on
+		std::atomic<bool> ran{ false };
+		jobs.runOnMainThread([&]() { ran = jobs.isMainThread(); });
+		jobs.runMainThreadJobs();
+		CHECK(ran == true);
+	}
+}
+
+TEST(jobSystemStopAndRestart)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		std::atomic<int> count{ 0 };
+		for (int restart = 0; restart < 3; restart++)
+		{
+			for (int i = 0; i < 100; i++)
+			{
+				jobs.run([&count]() { count++; });
+			}
+			// stop runs the jobs nobody waits on
+			jobs.stop();
+			CHECK(count == (restart + 1) * 100);
+		}
+
+		// changing the worker count restarts the workers on the next job
+		jobs.WorkerCount(numWorkers == 0 ? 2 : 0);
+		JobCounter counter;
+		jobs.run([&count]() { count++; }, &counter);
+		jobs.wait(counter);
+		CHECK(count == 301);
+	}
+}
+
+TEST(jobSystemThrowingJob)
+{
+	for (auto numWorkers : workerCounts)
+	{
+		JobSystem jobs;
+		jobs.WorkerCount(numWorkers);
+		JobCounter counter;
+		JobCounter next;
+		std::atomic<int> count{ 0 };
+		jobs.run([]() { throw std::runtime_error("test"); }, &counter);
+		jobs.runOnMainThread([]() { throw 1; }, &counter);
+		jobs.run([&count]() { count++; }, &counter);
+		jobs.then(counter, [&count]() { count++; }, &next);
+		jobs.wait(next);
+		CHECK(counter.done() == true);
+		CHECK(count == 2);
+	}
+}
@@ -0,0 +1,211 @@
+#include "Test.h"
+#include <algorithm>
+#include <cstring>
+#include "Json/JsonBinary.h"
+#include "Json/JsonUtils.h"
+#include <limits>
+#include <random>
+
+using namespace rapidjson;
+
+static std::vector<int16_t> getLayer(size_t size, uint32_t seed)
+{
+	// runs of the same tile in rows that mostly repeat, like a map layer
+	std::mt19937 rng(seed);
+	std::vector<int16_t> row;
+	while (row.size() < 100)
+	{
+		auto value = (int16_t)((int)(rng() % 2000) - 1000);
+		row.resize(std::min<size_t>(100, row.size() + 1 + rng() % 20), value);
+	}
+	std::vector<int16_t> layer;
+	while (layer.size() < size)
+	{
+		row[rng() % row.size()] = (int16_t)(rng() % 100);
+		layer.insert(layer.end(), row.begin(), row.begin() + std::min(row.size(), size - layer.size()));
+	}
+	return layer;
+}
+
+static JsonBinary::Writer getWriter(const std::vector<int16_t>& layer)
+{
+	JsonBinary::Writer writer;
+	writer.StartObject();
+	writer.Key("name");
+	writer.String("level");
+	writer.Key("values");
+	writer.StartArray();
+	writer.Null();
+	writer.Bool(true);
+	writer.Bool(false);
+	writer.Int(-12345);
+	writer.Uint64(std::numeric_limits<uint64_t>::max());
+	writer.Int64(std::numeric_limits<int64_t>::min());
+	writer.Double(0.25);
+	writer.String("level");
+	writer.EndArray();
+	writer.Key("size");
+	writer.SetFormatOptions(kFormatSingleLineArray);
+	writer.StartArray();
+	writer.Int(64);
+	writer.Int(32);
+	writer.EndArray();
+	writer.SetFormatOptions(kFormatDefault);
+	writer.Key("layer");
+	writer.Int16Array(layer);
+	writer.Key("empty");
+	writer.Int16Array({});
+	writer.EndObject();
+	return writer;
+}
+
+static std::vector<int16_t> getPacked(const Value& elem)
+{
+	std::vector<int16_t> values;
+	if (elem.IsString() == false ||
+		elem.GetStringLength() < JsonUtils::PackedInt16Header.size())
+	{
+		return values;
+	}
+	values.resize((elem.GetStringLength() - JsonUtils::PackedInt16Header.size()) / sizeof(int16_t));
+	std::memcpy(values.data(), elem.GetString() + JsonUtils::PackedInt16Header.size(),
+		values.size() * sizeof(int16_t));
+	return values;
+}
+
+// the data of an uncompressed file
+static std::string getData(const std::string& file)
+{
+	auto pos = JsonBinary::Header.size() + 2;
+	while (((uint8_t)file[pos] & 0x80) != 0)
+	{
+		pos++;
+	}
+	return file.substr(pos + 1);
+}
+
+// an uncompressed file with the given data
+static std::string getFile(const std::string& data)
+{
+	std::string file(JsonBinary::Header);
+	file.push_back((char)JsonBinary::Version);
+	file.push_back(0);
+	for (auto size = data.size(); ; size >>= 7)
+	{
+		if (size < 0x80)
+		{
+			file.push_back((char)size);
+			break;
+		}
+		file.push_back((char)(size | 0x80));
+	}
+	return file + data;
+}
+
+static bool load(const std::string& file)
+{
+	Document doc;
+	return JsonBinary::load(file, doc);
+}
+
+TEST(jsonBinaryRoundTrip)
+{
+	auto layer = getLayer(10000, 1);
+	auto writer = getWriter(layer);
+
+	for (bool compress : { false, true })
+	{
+		auto file = writer.getFile(compress);
+		CHECK(JsonBinary::isBinary(file) == true);
+
+		Document doc;
+		CHECK(JsonBinary::load(file, doc) == true);
+		CHECK(doc.IsObject() == true);
+		if (doc.IsObject() == false)
+		{
+			continue;
+		}
+		CHECK(doc["name"] == "level");
+		const auto& values = doc["values"];
+		CHECK(values.Size() == 8);
+		CHECK(values[0].IsNull() == true);
+		CHECK(values[1].GetBool() == true);
+		CHECK(values[2].GetBool() == false);
+		CHECK(values[3].GetInt() == -12345);
+		CHECK(values[4].GetUint64() == std::numeric_limits<uint64_t>::max());
+		CHECK(values[5].GetInt64() == std::numeric_limits<int64_t>::min());
+		CHECK(values[6].GetDouble() == 0.25);
+		CHECK(values[7] == "level");
+		CHECK(doc["size"][1].GetInt() == 32);
+		CHECK(getPacked(doc["layer"]) == layer);
+		CHECK(doc["empty"] == std::string(JsonUtils::PackedInt16Header));
+	}
+	CHECK(writer.getFile(true).size() < writer.getFile(false).size());
+
+	auto json = writer.getJson();
+	CHECK(json.find("\"size\": [64, 32]") != std::string::npos);
+	CHECK(json.find("\"values\": [\n    null,") != std::string::npos);
+}
+
+TEST(jsonBinaryRejectsTruncatedFiles)
+{
+	auto writer = getWriter(getLayer(1000, 2));
+	for (bool compress : { false, true })
+	{
+		auto file = writer.getFile(compress);
+		for (size_t size = 0; size < file.size(); size++)
+		{
+			CHECK(load(file.substr(0, size)) == false);
+		}
+	}
+
+	// truncated data with a matching header
+	auto data = getData(writer.getFile(false));
+	for (size_t size = 0; size < data.size(); size++)
+	{
+		CHECK(load(getFile(data.substr(0, size))) == false);
+	}
+	CHECK(load(getFile(data)) == true);
+}
+
+TEST(jsonBinaryRejectsBadInt16Arrays)
+{
+	// Int16Array token (12), count, then runs of length + delta
+	CHECK(load(getFile({ 12, 2, 2, 2 })) == true);
+	// run longer than the array
+	CHECK(load(getFile({ 12, 2, 3, 2 })) == false);
+	// empty run
+	CHECK(load(getFile({ 12, 2, 0, 2, 2, 2 })) == false);
+	// missing runs
+	CHECK(load(getFile({ 12, 4, 2, 2 })) == false);
+	// count of 2^42 with a single run
+	CHECK(load(getFile({ 12, '\x80', '\x80', '\x80', '\x80', '\x80', '\x80', 1,
+		'\x80', '\x80', '\x80', '\x80', '\x80', '\x80', 1, 2 })) == false);
+	// count of 2^27 + 1 (an array bigger than the data size limit)
+	CHECK(load(getFile({ 12, '\x81', '\x80', '\x80', '\x40', 1, 2 })) == false);
+}
+
+TEST(jsonBinaryCorruptFiles)
+{
+	// corrupt files must fail or load, never read out of bounds or
+	// allocate without bounds (run with ASan to check)
+	auto writer = getWriter(getLayer(2000, 3));
+	auto data = getData(writer.getFile(false));
+	auto compressed = writer.getFile(true);
+	std::mt19937 rng(4);
+	for (int i = 0; i < 2000; i++)
+	{
+		auto corruptData = data;
+		auto corruptFile = compressed;
+		auto changes = 1 + rng() % 8;
+		for (uint32_t j = 0; j < changes; j++)
+		{
+			corruptData[rng() % corruptData.size()] = (char)rng();
+			corruptFile[JsonBinary::Header.size() + rng() % (corruptFile.size() - JsonBinary::Header.size())] = (char)rng();
+		}
+		load(getFile(corruptData));
+		load(corruptFile);
+	}
+	CHECK(load(getFile(data)) == true);
+	CHECK(load(compressed) == true);
+}
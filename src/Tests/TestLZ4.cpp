@@ -0,0 +1,146 @@
+#include "Test.h"
+#include <random>
+#include "Utils/LZ4.h"
+#include <vector>
+
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& data)
+{
+	std::vector<uint8_t> compressed(LZ4::compressBound(data.size()));
+	auto size = LZ4::compress(data.data(), data.size(), compressed.data(), compressed.size());
+	compressed.resize(size);
+	return compressed;
+}
+
+static bool roundTrip(const std::vector<uint8_t>& data)
+{
+	auto compressed = compress(data);
+	if (compressed.empty() == true)
+	{
+		return false;
+	}
+	std::vector<uint8_t> decompressed(data.size());
+	return LZ4::decompress(compressed.data(), compressed.size(),
+		decompressed.data(), decompressed.size()) == true &&
+		decompressed == data;
+}
+
+static std::vector<uint8_t> getTestData(size_t size, uint32_t seed, int symbols)
+{
+	std::mt19937 rng(seed);
+	std::vector<uint8_t> data(size);
+	for (auto& val : data)
+	{
+		val = (uint8_t)(rng() % symbols);
+	}
+	return data;
+}
+
+TEST(lz4RoundTrip)
+{
+	CHECK(roundTrip({}) == true);
+	CHECK(roundTrip({ 42 }) == true);
+	CHECK(roundTrip(std::vector<uint8_t>(12, 7)) == true);
+	CHECK(roundTrip(std::vector<uint8_t>(13, 7)) == true);
+	CHECK(roundTrip(std::vector<uint8_t>(100000, 0)) == true);
+
+	for (uint32_t seed = 0; seed < 20; seed++)
+	{
+		// random bytes don't compress, few symbols give short matches
+		CHECK(roundTrip(getTestData(1000 + seed * 997, seed, 256)) == true);
+		CHECK(roundTrip(getTestData(1000 + seed * 997, seed, 4)) == true);
+	}
+
+	// repeats further apart than the maximum match offset (64 KB)
+	auto block = getTestData(70000, 1, 256);
+	auto data = block;
+	data.insert(data.end(), block.begin(), block.end());
+	CHECK(roundTrip(data) == true);
+
+	// long literal runs and long matches (length bytes of 255)
+	data = getTestData(5000, 2, 256);
+	data.resize(data.size() + 5000, 'a');
+	block = getTestData(600, 3, 256);
+	data.insert(data.end(), block.begin(), block.end());
+	CHECK(roundTrip(data) == true);
+}
+
+TEST(lz4CompressesRepeats)
+{
+	std::vector<uint8_t> data(100000, 'a');
+	auto compressed = compress(data);
+	CHECK(compressed.empty() == false);
+	CHECK(compressed.size() < 1000);
+
+	// output that doesn't fit
+	std::vector<uint8_t> small(compressed.size() - 1);
+	CHECK(LZ4::compress(data.data(), data.size(), small.data(), small.size()) == 0);
+}
+
+TEST(lz4RejectsWrongSize)
+{
+	auto data = getTestData(10000, 4, 8);
+	auto compressed = compress(data);
+	std::vector<uint8_t> decompressed(data.size() + 1);
+	CHECK(LZ4::decompress(compressed.data(), compressed.size(),
+		decompressed.data(), data.size() - 1) == false);
+	CHECK(LZ4::decompress(compressed.data(), compressed.size(),
+		decompressed.data(), data.size() + 1) == false);
+}
+
+TEST(lz4RejectsTruncatedInput)
+{
+	auto data = getTestData(10000, 5, 8);
+	auto compressed = compress(data);
+	std::vector<uint8_t> decompressed(data.size());
+	for (size_t size = 0; size < compressed.size(); size += 7)
+	{
+		CHECK(LZ4::decompress(compressed.data(), size,
+			decompressed.data(), decompressed.size()) == false);
+	}
+}
+
+TEST(lz4RejectsBadOffsets)
+{
+	uint8_t out[16];
+
+	// 4 literals, then a match with offset 0
+	const uint8_t zeroOffset[] = { 0x40, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x00 };
+	CHECK(LZ4::decompress(zeroOffset, sizeof(zeroOffset), out, 8) == false);
+
+	// 4 literals, then a match before the start of the output
+	const uint8_t farOffset[] = { 0x40, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x00 };
+	CHECK(LZ4::decompress(farOffset, sizeof(farOffset), out, 8) == false);
+
+	// the same with a valid offset (overlapping copy)
+	const uint8_t validOffset[] = { 0x40, 'a', 'b', 'c', 'd', 0x01, 0x00, 0x00 };
+	CHECK(LZ4::decompress(validOffset, sizeof(validOffset), out, 8) == true);
+	CHECK(out[7] == 'd');
+
+	// literal length that runs past the end of the input
+	const uint8_t longLiterals[] = { 0xF0, 0xFF, 0xFF };
+	CHECK(LZ4::decompress(longLiterals, sizeof(longLiterals), out, 16) == false);
+}
+
+TEST(lz4CorruptInput)
+{
+	// corrupt blocks must fail or decode to the right size, never
+	// read or write out of bounds (run with ASan to check)
+	auto data = getTestData(20000, 6, 16);
+	auto compressed = compress(data);
+	std::vector<uint8_t> decompressed(data.size());
+	std::mt19937 rng(7);
+	for (int i = 0; i < 2000; i++)
+	{
+		auto corrupted = compressed;
+		auto changes = 1 + rng() % 8;
+		for (uint32_t j = 0; j < changes; j++)
+		{
+			corrupted[rng() % corrupted.size()] = (uint8_t)rng();
+		}
+		LZ4::decompress(corrupted.data(), corrupted.size(),
+			decompressed.data(), decompressed.size());
+	}
+	CHECK(LZ4::decompress(compressed.data(), compressed.size(),
+		decompressed.data(), decompressed.size()) == true);
+	CHECK(decompressed == data);
+}
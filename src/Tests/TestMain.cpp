@@ -0,0 +1,30 @@
+#include <cstdio>
+#include <string_view>
+#include "Test.h"
+
+// DGEngineTests [--filter <name>]
+int main(int argc, char* argv[])
+{
+	std::string_view filter;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg(argv[i]);
+		if (arg == "--help" || arg == "-h")
+		{
+			std::printf("usage: DGEngineTests [--filter <name>]\n");
+			return 0;
+		}
+		if (arg == "--filter" && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	return Test::run(filter) == 0 ? 0 : 1;
+}
@@ -1,4 +1,5 @@
 #include "Text.h"
+#include "Game.h"
 #include "Utils/Utils.h"
 
 std::shared_ptr<Action> Text::getAction(uint16_t nameHash16) const noexcept
@@ -29,6 +30,7 @@ void Text::update(Game& game)
 {
 	if (triggerOnChange == true)
 	{
+		game.invalidate();
 		triggerOnChange = false;
 		if (changeAction != nullptr)
 		{
@@ -5,6 +5,8 @@
 #include "Palette.h"
 #include <SFML/Graphics/Texture.hpp>
 
+class AlphaMask;
+
 struct TextureInfo
 {
 	const sf::Texture* texture{ nullptr };
@@ -13,4 +15,6 @@ struct TextureInfo
 	bool absoluteOffset{ false };
 	BlendMode blendMode{ BlendMode::Alpha };
 	std::shared_ptr<Palette> palette;
+	// covers the whole texture, if the texture pack keeps one (picking)
+	const AlphaMask* alphaMask{ nullptr };
 };
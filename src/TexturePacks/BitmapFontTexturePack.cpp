@@ -274,6 +274,7 @@ bool BitmapFontTexturePack::get(uint32_t index, TextureInfo& ti) const
 		ti.absoluteOffset = false;
 		ti.blendMode = BlendMode::Alpha;
 		ti.palette = palette;
+		ti.alphaMask = nullptr;
 		return true;
 	}
 	return false;
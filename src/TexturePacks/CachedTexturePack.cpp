@@ -33,10 +33,15 @@ static uint32_t getNormalizedDirection(uint32_t direction, uint32_t numberOfDire
 
 CachedTexturePack::CachedTexturePack(const std::shared_ptr<ImageContainer>& imgPack_,
 	const sf::Vector2f& offset_, const std::shared_ptr<Palette>& palette_,
-	bool isIndexed_, bool normalizeDirections_) : imgPack(imgPack_), offset(offset_),
-	palette(palette_), indexed(isIndexed_), normalizeDirections(normalizeDirections_)
+	bool isIndexed_, bool normalizeDirections_, bool alphaMasks_) : imgPack(imgPack_),
+	offset(offset_), palette(palette_), indexed(isIndexed_),
+	normalizeDirections(normalizeDirections_)
 {
 	cache.resize(imgPack_->size());
+	if (alphaMasks_ == true)
+	{
+		alphaMasks.resize(cache.size());
+	}
 }
 
 bool CachedTexturePack::get(uint32_t index, TextureInfo& ti) const
@@ -52,11 +57,16 @@ bool CachedTexturePack::get(uint32_t index, TextureInfo& ti) const
 		{
 			palArray = &palette->palette;
 		}
-		cache[index].first = imgPack->get(
+		auto img = imgPack->get(
 			index,
 			palArray,
 			cache[index].second
 		);
+		cache[index].first.loadFromImage(img);
+		if (alphaMasks.empty() == false)
+		{
+			alphaMasks[index] = AlphaMask(img);
+		}
 	}
 	ti.texture = &cache[index].first;
 	updateTextureRect(ti);
@@ -64,6 +74,7 @@ bool CachedTexturePack::get(uint32_t index, TextureInfo& ti) const
 	ti.absoluteOffset = cache[index].second.absoluteOffset;
 	ti.blendMode = cache[index].second.blendMode;
 	ti.palette = palette;
+	ti.alphaMask = (alphaMasks.empty() == false ? &alphaMasks[index] : nullptr);
 	return true;
 }
 
@@ -118,14 +129,19 @@ std::pair<uint32_t, uint32_t> CachedTexturePack::getRange(
 CachedMultiTexturePack::CachedMultiTexturePack(
 	const std::vector<std::shared_ptr<ImageContainer>>& imgVec_,
 	const sf::Vector2f& offset_, const std::shared_ptr<Palette>& palette_,
-	bool isIndexed_, bool normalizeDirections_) : imgVec(imgVec_), offset(offset_),
-	palette(palette_), indexed(isIndexed_), normalizeDirections(normalizeDirections_)
+	bool isIndexed_, bool normalizeDirections_, bool alphaMasks_) : imgVec(imgVec_),
+	offset(offset_), palette(palette_), indexed(isIndexed_),
+	normalizeDirections(normalizeDirections_)
 {
 	for (const auto& imgPack : imgVec_)
 	{
 		textureCount += imgPack->size();
 	}
 	cache.resize(textureCount);
+	if (alphaMasks_ == true)
+	{
+		alphaMasks.resize(textureCount);
+	}
 }
 
 bool CachedMultiTexturePack::get(uint32_t index, TextureInfo& ti) const
@@ -153,11 +169,16 @@ bool CachedMultiTexturePack::get(uint32_t index, TextureInfo& ti) const
 		{
 			palArray = &palette->palette;
 		}
-		cache[index].first = imgVec[indexY]->get(
+		auto img = imgVec[indexY]->get(
 			indexX,
 			palArray,
 			cache[index].second
 		);
+		cache[index].first.loadFromImage(img);
+		if (alphaMasks.empty() == false)
+		{
+			alphaMasks[index] = AlphaMask(img);
+		}
 	}
 	ti.texture = &cache[index].first;
 	updateTextureRect(ti);
@@ -165,6 +186,7 @@ bool CachedMultiTexturePack::get(uint32_t index, TextureInfo& ti) const
 	ti.absoluteOffset = cache[index].second.absoluteOffset;
 	ti.blendMode = cache[index].second.blendMode;
 	ti.palette = palette;
+	ti.alphaMask = (alphaMasks.empty() == false ? &alphaMasks[index] : nullptr);
 	return true;
 }
 
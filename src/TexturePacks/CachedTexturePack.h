@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ImageContainers/ImageContainer.h"
+#include "SFML/AlphaMask.h"
 #include "TexturePack.h"
 #include <vector>
 
@@ -14,11 +15,13 @@ private:
 	bool normalizeDirections{ false };
 
 	mutable std::vector<std::pair<sf::Texture, ImageContainer::ImageInfo>> cache;
+	// empty if alpha masks are disabled
+	mutable std::vector<AlphaMask> alphaMasks;
 
 public:
 	CachedTexturePack(const std::shared_ptr<ImageContainer>& imgPack_,
 		const sf::Vector2f& offset_, const std::shared_ptr<Palette>& palette_,
-		bool isIndexed_, bool normalizeDirections_);
+		bool isIndexed_, bool normalizeDirections_, bool alphaMasks_);
 
 	virtual bool get(uint32_t index, TextureInfo& ti) const;
 
@@ -42,11 +45,13 @@ private:
 	bool normalizeDirections{ false };
 
 	mutable std::vector<std::pair<sf::Texture, ImageContainer::ImageInfo>> cache;
+	// empty if alpha masks are disabled
+	mutable std::vector<AlphaMask> alphaMasks;
 
 public:
 	CachedMultiTexturePack(const std::vector<std::shared_ptr<ImageContainer>>& imgVec_,
 		const sf::Vector2f& offset_, const std::shared_ptr<Palette>& palette_,
-		bool isIndexed_, bool normalizeDirections_);
+		bool isIndexed_, bool normalizeDirections_, bool alphaMasks_);
 
 	virtual bool get(uint32_t index, TextureInfo& ti) const;
 
@@ -70,6 +70,7 @@ static void getTexture(const MultiTexture& t, uint32_t index, TextureInfo& ti) n
 	ti.offset = t.offset;
 	ti.absoluteOffset = false;
 	ti.blendMode = BlendMode::Alpha;
+	ti.alphaMask = nullptr;
 }
 
 static uint32_t getDirectionHelper(const MultiTexture& t, uint32_t frameIdx) noexcept
@@ -14,6 +14,7 @@ bool VectorTexturePack::get(uint32_t index, TextureInfo& ti) const
 	ti.absoluteOffset = false;
 	ti.blendMode = BlendMode::Alpha;
 	ti.palette = palette;
+	ti.alphaMask = nullptr;
 	return true;
 }
 
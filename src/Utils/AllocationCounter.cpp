@@ -0,0 +1,60 @@
+#include "AllocationCounter.h"
+
+#ifdef USE_ALLOCATION_COUNTER
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace AllocationCounter
+{
+	static std::atomic<bool> enabled{ false };
+	static std::atomic<uint64_t> count{ 0 };
+
+	bool Enabled() noexcept
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	void Enabled(bool enable) noexcept
+	{
+		enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	uint64_t get() noexcept
+	{
+		return count.load(std::memory_order_relaxed);
+	}
+}
+
+// the array, nothrow and sized variants forward to these two by default.
+void* operator new(std::size_t size)
+{
+	if (AllocationCounter::enabled.load(std::memory_order_relaxed) == true)
+	{
+		AllocationCounter::count.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (size == 0)
+	{
+		size = 1;
+	}
+	while (true)
+	{
+		auto ptr = std::malloc(size);
+		if (ptr != nullptr)
+		{
+			return ptr;
+		}
+		auto handler = std::get_new_handler();
+		if (handler == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+#endif
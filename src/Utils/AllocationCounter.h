@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// counts calls to the global operator new while enabled.
+// operator new is only replaced if USE_ALLOCATION_COUNTER is defined
+// (DGENGINE_ALLOCATION_COUNTER), otherwise nothing is counted and get returns 0.
+namespace AllocationCounter
+{
+#ifdef USE_ALLOCATION_COUNTER
+	bool Enabled() noexcept;
+	void Enabled(bool enable) noexcept;
+
+	uint64_t get() noexcept;
+#else
+	inline bool Enabled() noexcept { return false; }
+	inline void Enabled(bool enable) noexcept {}
+
+	inline uint64_t get() noexcept { return 0; }
+#endif
+}
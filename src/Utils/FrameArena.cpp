@@ -0,0 +1,116 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace FrameArena
+{
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size{ 0 };
+	};
+
+	constexpr size_t DefaultBlockSize = 64 * 1024;
+
+	// the last block is the one being used
+	static std::vector<Block> blocks;
+	static size_t offset{ 0 };
+	// bytes used in the blocks before the last one
+	static size_t usedInPreviousBlocks{ 0 };
+	static thread_local bool isOwner{ false };
+	static std::atomic<uint32_t> frame{ 0 };
+
+	static void addBlock(size_t size)
+	{
+		if (blocks.empty() == false)
+		{
+			usedInPreviousBlocks += offset;
+		}
+		Block block;
+		block.data = std::make_unique<std::byte[]>(size);
+		block.size = size;
+		blocks.push_back(std::move(block));
+		offset = 0;
+	}
+
+	static bool owns(const void* ptr) noexcept
+	{
+		auto bytePtr = static_cast<const std::byte*>(ptr);
+		for (const auto& block : blocks)
+		{
+			if (bytePtr >= block.data.get() &&
+				bytePtr < block.data.get() + block.size)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void* allocate(size_t size, size_t alignment)
+	{
+		if (isOwner == false)
+		{
+			return ::operator new(size);
+		}
+		if (blocks.empty() == false)
+		{
+			auto alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+			auto& block = blocks.back();
+			if (alignedOffset + size <= block.size)
+			{
+				offset = alignedOffset + size;
+				return block.data.get() + alignedOffset;
+			}
+		}
+		// new blocks are aligned for any type
+		addBlock(std::max(DefaultBlockSize, size));
+		offset = size;
+		return blocks.back().data.get();
+	}
+
+	void deallocate(void* ptr) noexcept
+	{
+		// arena memory is released by reset
+		if (isOwner == true && owns(ptr) == true)
+		{
+			return;
+		}
+		::operator delete(ptr);
+	}
+
+	void reset()
+	{
+		isOwner = true;
+		frame.fetch_add(1, std::memory_order_relaxed);
+		if (blocks.size() > 1)
+		{
+			size_t totalSize = 0;
+			for (const auto& block : blocks)
+			{
+				totalSize += block.size;
+			}
+			blocks.clear();
+			addBlock(totalSize);
+		}
+		offset = 0;
+		usedInPreviousBlocks = 0;
+	}
+
+	size_t getUsed() noexcept
+	{
+		return usedInPreviousBlocks + offset;
+	}
+
+	uint32_t getFrame() noexcept
+	{
+		return frame.load(std::memory_order_relaxed);
+	}
+
+	bool isOwnerThread() noexcept
+	{
+		return isOwner;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// bump allocator for temporary data that doesn't outlive the current frame.
+// the game loop resets it at the start of each frame, so memory from it
+// must not be kept between frames. only the thread that resets it uses it,
+// other threads get memory from the heap.
+namespace FrameArena
+{
+	void* allocate(size_t size, size_t alignment);
+
+	// frees ptr if it isn't arena memory (other threads).
+	void deallocate(void* ptr) noexcept;
+
+	// releases all allocations and makes the calling thread the owner.
+	// blocks used in the last frame are merged into one, so a steady
+	// workload doesn't allocate.
+	void reset();
+
+	// bytes used in the current frame.
+	size_t getUsed() noexcept;
+
+	// incremented by reset.
+	uint32_t getFrame() noexcept;
+
+	// true if the calling thread allocates from the arena.
+	bool isOwnerThread() noexcept;
+}
+
+// debug builds assert that an allocator (and the container using it)
+// is only used in the frame it was created in.
+template <class T>
+class FrameAllocator
+{
+private:
+	template <class U>
+	friend class FrameAllocator;
+
+#ifndef NDEBUG
+	uint32_t frame{ FrameArena::getFrame() };
+#endif
+
+	bool isCurrentFrame() const noexcept
+	{
+#ifndef NDEBUG
+		// other threads allocate from the heap
+		return FrameArena::isOwnerThread() == false ||
+			frame == FrameArena::getFrame();
+#else
+		return true;
+#endif
+	}
+
+public:
+	typedef T value_type;
+
+	FrameAllocator() noexcept = default;
+	template <class U>
+#ifndef NDEBUG
+	FrameAllocator(const FrameAllocator<U>& other) noexcept : frame(other.frame) {}
+#else
+	FrameAllocator(const FrameAllocator<U>&) noexcept {}
+#endif
+
+	T* allocate(size_t n)
+	{
+		assert(isCurrentFrame() == true && "frame container used after its frame ended");
+		return static_cast<T*>(FrameArena::allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, size_t) noexcept
+	{
+		assert(isCurrentFrame() == true && "frame container used after its frame ended");
+		FrameArena::deallocate(ptr);
+	}
+
+	template <class U>
+	bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+	template <class U>
+	bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+// a vector for temporary data of the current frame (paths, texture lists).
+// its memory is released when the next frame starts, so it must be destroyed
+// in the frame it was created in. never store one in an object that outlives
+// the frame (copy it into a std::vector instead).
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+// same lifetime rule as FrameVector.
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
@@ -0,0 +1,222 @@
+#include "LZ4.h"
+#include <cstring>
+#include <vector>
+
+namespace LZ4
+{
+	constexpr size_t MinMatch = 4;
+	constexpr size_t LastLiterals = 5;
+	constexpr size_t MatchLimit = 12;
+	constexpr size_t MaxOffset = 0xFFFF;
+	constexpr unsigned HashBits = 16;
+
+	static uint32_t read32(const uint8_t* ptr) noexcept
+	{
+		uint32_t val;
+		std::memcpy(&val, ptr, sizeof(val));
+		return val;
+	}
+
+	static uint32_t hash(uint32_t val) noexcept
+	{
+		return (val * 2654435761u) >> (32 - HashBits);
+	}
+
+	static bool writeLength(uint8_t*& op, const uint8_t* opEnd, size_t len) noexcept
+	{
+		while (len >= 255)
+		{
+			if (op >= opEnd)
+			{
+				return false;
+			}
+			*op++ = 255;
+			len -= 255;
+		}
+		if (op >= opEnd)
+		{
+			return false;
+		}
+		*op++ = (uint8_t)len;
+		return true;
+	}
+
+	static bool writeSequence(uint8_t*& op, const uint8_t* opEnd,
+		const uint8_t* literals, size_t literalsLen, size_t offset, size_t matchLen) noexcept
+	{
+		if (op >= opEnd)
+		{
+			return false;
+		}
+		auto token = op++;
+		*token = (uint8_t)((literalsLen >= 15 ? 15 : literalsLen) << 4);
+		if (literalsLen >= 15 &&
+			writeLength(op, opEnd, literalsLen - 15) == false)
+		{
+			return false;
+		}
+		if ((size_t)(opEnd - op) < literalsLen)
+		{
+			return false;
+		}
+		if (literalsLen > 0)
+		{
+			std::memcpy(op, literals, literalsLen);
+			op += literalsLen;
+		}
+
+		if (matchLen == 0)
+		{
+			// last sequence
+			return true;
+		}
+		if (opEnd - op < 2)
+		{
+			return false;
+		}
+		*op++ = (uint8_t)(offset & 0xFF);
+		*op++ = (uint8_t)(offset >> 8);
+		matchLen -= MinMatch;
+		*token |= (uint8_t)(matchLen >= 15 ? 15 : matchLen);
+		if (matchLen >= 15)
+		{
+			return writeLength(op, opEnd, matchLen - 15);
+		}
+		return true;
+	}
+
+	size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+	{
+		auto op = dst;
+		auto opEnd = dst + dstCapacity;
+		auto anchor = src;
+
+		if (srcSize > MatchLimit)
+		{
+			std::vector<uint32_t> table(1u << HashBits, 0);
+			auto srcEnd = src + srcSize;
+			auto matchEnd = srcEnd - LastLiterals;
+			auto ip = src + 1;
+			while (ip < srcEnd - MatchLimit)
+			{
+				auto seq = read32(ip);
+				auto& entry = table[hash(seq)];
+				auto ref = src + entry;
+				entry = (uint32_t)(ip - src);
+				if (ref >= ip ||
+					(size_t)(ip - ref) > MaxOffset ||
+					read32(ref) != seq)
+				{
+					ip++;
+					continue;
+				}
+				// extend the match backwards and forwards
+				while (ip > anchor && ref > src && ip[-1] == ref[-1])
+				{
+					ip--;
+					ref--;
+				}
+				auto matchLen = MinMatch;
+				while (ip + matchLen < matchEnd && ip[matchLen] == ref[matchLen])
+				{
+					matchLen++;
+				}
+				if (writeSequence(op, opEnd, anchor, (size_t)(ip - anchor),
+					(size_t)(ip - ref), matchLen) == false)
+				{
+					return 0;
+				}
+				ip += matchLen;
+				anchor = ip;
+				if (ip < srcEnd - MatchLimit)
+				{
+					table[hash(read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+				}
+			}
+		}
+		if (writeSequence(op, opEnd, anchor, (size_t)(src + srcSize - anchor), 0, 0) == false)
+		{
+			return 0;
+		}
+		return (size_t)(op - dst);
+	}
+
+	bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) noexcept
+	{
+		auto ip = src;
+		auto ipEnd = src + srcSize;
+		auto op = dst;
+		auto opEnd = dst + dstSize;
+
+		auto readLength = [&](size_t len) -> size_t
+		{
+			if (len == 15)
+			{
+				uint8_t val;
+				do
+				{
+					if (ip >= ipEnd)
+					{
+						return (size_t)-1;
+					}
+					val = *ip++;
+					len += val;
+				} while (val == 255);
+			}
+			return len;
+		};
+
+		while (ip < ipEnd)
+		{
+			auto token = *ip++;
+			auto literalsLen = readLength(token >> 4);
+			if (literalsLen == (size_t)-1 ||
+				(size_t)(ipEnd - ip) < literalsLen ||
+				(size_t)(opEnd - op) < literalsLen)
+			{
+				return false;
+			}
+			if (literalsLen > 0)
+			{
+				std::memcpy(op, ip, literalsLen);
+				ip += literalsLen;
+				op += literalsLen;
+			}
+
+			if (ip >= ipEnd)
+			{
+				// last sequence has no match
+				break;
+			}
+			if (ipEnd - ip < 2)
+			{
+				return false;
+			}
+			size_t offset = ip[0] | ((size_t)ip[1] << 8);
+			ip += 2;
+			if (offset == 0 ||
+				offset > (size_t)(op - dst))
+			{
+				return false;
+			}
+			auto matchLen = readLength(token & 0x0F);
+			if (matchLen == (size_t)-1)
+			{
+				return false;
+			}
+			matchLen += MinMatch;
+			if ((size_t)(opEnd - op) < matchLen)
+			{
+				return false;
+			}
+			// matches can overlap the output, so copy byte by byte
+			auto ref = op - offset;
+			for (size_t i = 0; i < matchLen; i++)
+			{
+				op[i] = ref[i];
+			}
+			op += matchLen;
+		}
+		return op == opEnd;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (no frame header) compression.
+// output is compatible with LZ4_decompress_safe.
+namespace LZ4
+{
+	constexpr size_t compressBound(size_t size) noexcept
+	{
+		return size + (size / 255) + 16;
+	}
+
+	// returns the compressed size or 0 if dst is too small.
+	size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+	// dstSize must be the exact uncompressed size.
+	// returns false if the input is malformed.
+	bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) noexcept;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// named functions registered by static objects before main runs
+// (DGEngineTests tests and DGEngineBench benchmarks).
+template <class Function>
+class Registry
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		Function func;
+		int64_t arg{ 0 };
+	};
+
+	struct Registration
+	{
+		// adds func once for each arg (as name/arg). an empty args adds it once with 0.
+		Registration(const char* name, Function func, std::vector<int64_t> args = {})
+		{
+			auto& entries = getEntries();
+			if (args.empty() == true)
+			{
+				entries.push_back({ name, std::move(func), 0 });
+				return;
+			}
+			for (auto arg : args)
+			{
+				entries.push_back({ std::string(name) + "/" + std::to_string(arg), func, arg });
+			}
+		}
+	};
+
+	// function static, so registrations in other files can run first.
+	static std::vector<Entry>& getEntries()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	// calls func(entry) for the entries whose name contains filter, in
+	// registration order. returns the number of entries.
+	template <class Func>
+	static size_t forEach(const std::string_view filter, Func func)
+	{
+		size_t count = 0;
+		for (const auto& entry : getEntries())
+		{
+			if (filter.empty() == false &&
+				entry.name.find(filter) == std::string::npos)
+			{
+				continue;
+			}
+			func(entry);
+			count++;
+		}
+		return count;
+	}
+};
+
+// declares a function with the given parameters and registers it.
+// the function's body follows the macro. the optional arguments are the
+// Registration's args.
+#define REGISTER_FUNCTION(registry, name, params, ...) \
+	static void name params; \
+	static registry::Registration name##Registration(#name, name, { __VA_ARGS__ }); \
+	static void name params
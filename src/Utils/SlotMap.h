@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// handle to a value in a SlotMap. the slot's generation changes when its value
+// is removed, so old handles don't resolve to values added later.
+struct SlotMapHandle
+{
+	static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	uint32_t index{ InvalidIndex };
+	uint32_t generation{ 0 };
+
+	bool isValid() const noexcept { return index != InvalidIndex; }
+
+	bool operator==(const SlotMapHandle& rhs) const noexcept
+	{
+		return index == rhs.index && generation == rhs.generation;
+	}
+
+	bool operator!=(const SlotMapHandle& rhs) const noexcept
+	{
+		return !operator==(rhs);
+	}
+};
+
+// values are stored contiguously (iteration order isn't kept on removal).
+// insert, remove and lookup by handle are O(1).
+template <class T>
+class SlotMap
+{
+private:
+	struct Slot
+	{
+		// index in values or next free slot
+		uint32_t index{ SlotMapHandle::InvalidIndex };
+		uint32_t generation{ 0 };
+	};
+
+	typedef std::vector<T> Values;
+
+	Values values;
+	// slot of each value
+	std::vector<uint32_t> valueSlots;
+	std::vector<Slot> slots;
+	uint32_t freeSlot{ SlotMapHandle::InvalidIndex };
+
+	const Slot* getSlot(const SlotMapHandle& handle) const noexcept
+	{
+		if (handle.index < slots.size())
+		{
+			const auto& slot = slots[handle.index];
+			if (slot.generation == handle.generation)
+			{
+				return &slot;
+			}
+		}
+		return nullptr;
+	}
+
+public:
+	using iterator = typename Values::iterator;
+	using const_iterator = typename Values::const_iterator;
+
+	iterator begin() noexcept { return values.begin(); }
+	iterator end() noexcept { return values.end(); }
+	const_iterator begin() const noexcept { return values.begin(); }
+	const_iterator end() const noexcept { return values.end(); }
+	const_iterator cbegin() const noexcept { return values.cbegin(); }
+	const_iterator cend() const noexcept { return values.cend(); }
+
+	bool empty() const noexcept { return values.empty(); }
+	size_t size() const noexcept { return values.size(); }
+
+	// by position in the contiguous storage (0 to size() - 1).
+	T& operator[](size_t idx) noexcept { return values[idx]; }
+	const T& operator[](size_t idx) const noexcept { return values[idx]; }
+
+	SlotMapHandle getHandle(size_t idx) const noexcept
+	{
+		auto slotIdx = valueSlots[idx];
+		return { slotIdx, slots[slotIdx].generation };
+	}
+
+	SlotMapHandle insert(T value)
+	{
+		uint32_t slotIdx;
+		if (freeSlot != SlotMapHandle::InvalidIndex)
+		{
+			slotIdx = freeSlot;
+			freeSlot = slots[slotIdx].index;
+		}
+		else
+		{
+			slotIdx = (uint32_t)slots.size();
+			slots.push_back({});
+		}
+		auto& slot = slots[slotIdx];
+		slot.index = (uint32_t)values.size();
+		values.push_back(std::move(value));
+		valueSlots.push_back(slotIdx);
+		return { slotIdx, slot.generation };
+	}
+
+	// nullptr if the handle's value was removed.
+	T* get(const SlotMapHandle& handle) noexcept
+	{
+		auto slot = getSlot(handle);
+		return slot != nullptr ? &values[slot->index] : nullptr;
+	}
+
+	const T* get(const SlotMapHandle& handle) const noexcept
+	{
+		auto slot = getSlot(handle);
+		return slot != nullptr ? &values[slot->index] : nullptr;
+	}
+
+	bool contains(const SlotMapHandle& handle) const noexcept
+	{
+		return getSlot(handle) != nullptr;
+	}
+
+	// removes the value at idx (by position). the last value takes its place.
+	void eraseAt(size_t idx)
+	{
+		auto slotIdx = valueSlots[idx];
+		auto lastIdx = values.size() - 1;
+		if (idx != lastIdx)
+		{
+			values[idx] = std::move(values[lastIdx]);
+			valueSlots[idx] = valueSlots[lastIdx];
+			slots[valueSlots[idx]].index = (uint32_t)idx;
+		}
+		values.pop_back();
+		valueSlots.pop_back();
+
+		auto& slot = slots[slotIdx];
+		slot.generation++;
+		slot.index = freeSlot;
+		freeSlot = slotIdx;
+	}
+
+	bool erase(const SlotMapHandle& handle)
+	{
+		auto slot = getSlot(handle);
+		if (slot == nullptr)
+		{
+			return false;
+		}
+		eraseAt(slot->index);
+		return true;
+	}
+
+	// handles to the removed values stay invalid.
+	void clear()
+	{
+		for (auto slotIdx : valueSlots)
+		{
+			auto& slot = slots[slotIdx];
+			slot.generation++;
+			slot.index = freeSlot;
+			freeSlot = slotIdx;
+		}
+		values.clear();
+		valueSlots.clear();
+	}
+};
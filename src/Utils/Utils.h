@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <string>
 #include <string_view>
@@ -168,24 +170,52 @@ namespace Utils
 	protected:
 		static std::random_device rd;
 		static std::mt19937 generator;
+
+	public:
+		// makes the generated sequence repeatable (benchmarks).
+		static void seed(uint32_t value) { generator.seed(value); }
 	};
 
 	// uniform random number generator
 	class Random : public RandomGenerator
 	{
 	public:
+		// maps the output of rng to [min, max] the same way on every platform
+		// (std::uniform_int_distribution differs between standard libraries,
+		// which breaks seeded replays).
+		template <class T>
+		static T get(std::mt19937& rng, T min, T max)
+		{
+			static_assert(std::is_integral<T>::value, "integral values only");
+			using U = std::make_unsigned_t<T>;
+			U span = (U)((U)max - (U)min);
+			if constexpr (sizeof(U) <= sizeof(uint32_t))
+			{
+				auto val = ((uint64_t)rng() * ((uint64_t)span + 1)) >> 32;
+				return (T)((U)min + (U)val);
+			}
+			else
+			{
+				uint64_t val = (uint64_t)rng() << 32;
+				val |= (uint64_t)rng();
+				if (span == std::numeric_limits<U>::max())
+				{
+					return (T)val;
+				}
+				return (T)((U)min + (U)(val % ((uint64_t)span + 1)));
+			}
+		}
+
 		template <class T>
 		static T get(T max)
 		{
-			std::uniform_int_distribution<T> dist(0, max);
-			return dist(generator);
+			return get<T>(generator, 0, max);
 		}
 
 		template <class T>
 		static T get(T min, T max)
 		{
-			std::uniform_int_distribution<T> dist(min, max);
-			return dist(generator);
+			return get<T>(generator, min, max);
 		}
 
 		template <class T>